@@ -1,5 +1,6 @@
 #include "Prerequisites.h"
 #include "Actor.h"
+#include "Profiler.h"
 
  /*
    Esta clase representa cualquier entidad grfica en el juego
@@ -33,6 +34,13 @@ Actor::Actor(std::string actorName)
 // Este parmetro es til para realizar animaciones y clculos basados en tiempo real.
 void Actor::update(float deltaTime)
 {
+    PROFILE_SCOPE("Actor::update");
+    // Los actores estticos ya estn horneados con su transformacin definitiva.
+    if (m_static)
+    {
+        return;
+    }
+
     // Obtener el componente de transformaciones y el de forma del actor
     auto transform = getComponent<Transform>();
     auto shape = getComponent<ShapeFactory>();
@@ -46,19 +54,35 @@ void Actor::update(float deltaTime)
     }
 }
 
+// Interpola la forma entre los dos ltimos ticks de la simulacin.
+// @param alpha Fraccin del siguiente tick ya transcurrida, entre 0 y 1.
+void Actor::interpolate(float alpha)
+{
+    auto transform = getComponent<Transform>();
+    auto shape = getComponent<ShapeFactory>();
+
+    if (transform && shape && !m_static)
+    {
+        shape->setPosition(transform->getInterpolatedPosition(alpha));
+        shape->setRotation(transform->getInterpolatedRotation(alpha));
+        shape->setScale(transform->getInterpolatedScale(alpha));
+    }
+}
+
 // Renderiza todos los componentes grficos del actor en la ventana especificada.
 // @param window Referencia a la ventana donde se dibujarn los componentes grficos del actor.
 void Actor::render(Window& window)
 {
     // Recorremos todos los componentes asociados al actor y verificamos si son de tipo ShapeFactory.
-    // Si lo son, obtenemos la forma (Shape) y la dibujamos en la ventana.
+    // Si lo son, la forma se dibuja a partir de su geometra compartida.
     for (unsigned int i = 0; i < components.size(); i++)
     {
         // dynamic_pointer_cast se usa para convertir de manera segura el componente a ShapeFactory.
         // Si la conversin es exitosa, se dibuja la forma correspondiente.
-        if (components[i].dynamic_pointer_cast<ShapeFactory>())
+        auto shape = components[i].dynamic_pointer_cast<ShapeFactory>();
+        if (shape)
         {
-            window.draw(*components[i].dynamic_pointer_cast<ShapeFactory>()->getShape());
+            shape->render(window);
         }
     }
 }
@@ -70,4 +94,16 @@ void Actor::destroy()
 {
     // Esta funcin est preparada para liberar cualquier recurso adicional si es necesario.
     // Actualmente, no es necesario liberar manualmente los componentes porque se manejan con TSharedPointer.
-}
\ No newline at end of file
+}
+
+// Marca el actor como esttico o dinmico.
+void Actor::setStatic(bool isStatic)
+{
+    m_static = isStatic;
+}
+
+// Indica si el actor es esttico.
+bool Actor::isStatic() const
+{
+    return m_static;
+}
@@ -56,6 +56,14 @@ public:
      */
     void render(Window& window) override;
 
+    /*
+      Funcin interpolate.
+      - Coloca la forma del actor entre su Transform del tick anterior y el actual.
+      - alpha es la fraccin del siguiente tick ya transcurrida; se llama justo antes de render()
+        cuando la simulacin avanza con un paso fijo distinto de la frecuencia de dibujo.
+    */
+    void interpolate(float alpha);
+
     /*
       Funcin `destroy`
       - Libera los recursos asociados al actor y sus componentes.
@@ -64,6 +72,16 @@ public:
      */
     void destroy();
 
+    /*
+      Funcin setStatic.
+      - Marca el actor como esttico: no se mueve, as que update() no hace nada y su forma
+        se dibuja desde la pasada de geometra esttica (StaticGeometry).
+    */
+    void setStatic(bool isStatic);
+
+    // Indica si el actor es esttico.
+    bool isStatic() const;
+
     /*
       Funcin getComponent.
       - Recupera un componente especfico asociado al actor basado en su tipo.
@@ -83,6 +101,8 @@ private:
       definir nodos en un esqueleto de animacin o identificar elementos de un sistema de partculas.
      */
     std::string m_name = "Actor";  // Nombre del actor.
+
+    bool m_static = false;  // Actor esttico (horneado en StaticGeometry).
 };
 
 /*
@@ -0,0 +1,107 @@
+#include "AllocationTracker.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#ifdef SOULPHER_TRACK_ALLOCATIONS
+namespace
+{
+    // Variables globales triviales: estn listas antes de la primera reserva de cualquier inicializador.
+    std::atomic<uint64_t> g_allocations{ 0 };
+    std::atomic<uint64_t> g_frees{ 0 };
+    std::atomic<uint64_t> g_bytes{ 0 };
+
+    void* trackedAlloc(std::size_t size) {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+        g_bytes.fetch_add(size, std::memory_order_relaxed);
+        return std::malloc(size != 0 ? size : 1);
+    }
+
+    void trackedFree(void* pointer) {
+        if (pointer != nullptr) {
+            g_frees.fetch_add(1, std::memory_order_relaxed);
+            std::free(pointer);
+        }
+    }
+}
+
+#else
+namespace
+{
+    // Sin el reemplazo nadie los incrementa: las instantneas siempre valen cero.
+    std::atomic<uint64_t> g_allocations{ 0 };
+    std::atomic<uint64_t> g_frees{ 0 };
+    std::atomic<uint64_t> g_bytes{ 0 };
+}
+#endif
+
+AllocationTracker::Snapshot AllocationTracker::getSnapshot() {
+    Snapshot snapshot;
+    snapshot.allocations = g_allocations.load(std::memory_order_relaxed);
+    snapshot.frees = g_frees.load(std::memory_order_relaxed);
+    snapshot.bytes = g_bytes.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+uint64_t AllocationTracker::getAllocationCount() {
+    return g_allocations.load(std::memory_order_relaxed);
+}
+
+bool AllocationTracker::isEnabled() {
+#ifdef SOULPHER_TRACK_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+#ifdef SOULPHER_TRACK_ALLOCATIONS
+
+/*
+   Reemplazo de los operadores globales. Las versiones con alineacin (std::align_val_t)
+   no se reemplazan: siguen emparejadas con las de la biblioteca estndar y no se cuentan.
+*/
+void* operator new(std::size_t size) {
+    void* pointer = trackedAlloc(size);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return trackedAlloc(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return trackedAlloc(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    trackedFree(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    trackedFree(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    trackedFree(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+    trackedFree(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+    trackedFree(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+    trackedFree(pointer);
+}
+#endif
@@ -0,0 +1,41 @@
+#pragma once
+#include "Prerequisites.h"
+#include <cstdint>
+
+/*
+  Clase AllocationTracker
+  - Cuenta las reservas de memoria dinmica de todo el programa. AllocationTracker.cpp reemplaza
+    los operadores globales new y delete: cada reserva suma uno a un contador atmico y los bytes
+    pedidos a otro, y despus llama a malloc/free como la implementacin estndar.
+  - Para saber cuntas reservas hace una parte del cdigo se toma una instantnea antes y despus
+    (Snapshot) y se restan.
+  - No guarda el tamao de cada bloque, as que no sabe cunta memoria sigue viva: solo cunto se pidi.
+  - El reemplazo solo se compila con SOULPHER_TRACK_ALLOCATIONS (configuraciones Debug). Sin l, new y
+    delete son los de la biblioteca estndar, sin ningn costo, y los contadores se quedan en cero
+    (isEnabled() devuelve false para que las pantallas muestren "n/d" en lugar de 0).
+  En motores 3D, contar las reservas por frame es la forma ms directa de encontrar el cdigo que
+  reserva memoria en el bucle principal, una causa habitual de picos en el tiempo de frame.
+*/
+class AllocationTracker
+{
+public:
+    struct Snapshot
+    {
+        uint64_t allocations = 0;
+        uint64_t frees = 0;
+        uint64_t bytes = 0;     // Bytes pedidos (acumulado).
+
+        Snapshot operator-(const Snapshot& other) const {
+            return Snapshot{ allocations - other.allocations, frees - other.frees, bytes - other.bytes };
+        }
+    };
+
+    // Contadores actuales.
+    static Snapshot getSnapshot();
+
+    // Reservas hechas desde el inicio del programa.
+    static uint64_t getAllocationCount();
+
+    // Indica si este binario cuenta las reservas (SOULPHER_TRACK_ALLOCATIONS).
+    static bool isEnabled();
+};
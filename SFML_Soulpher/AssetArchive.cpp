@@ -0,0 +1,349 @@
+#include "AssetArchive.h"
+#include "Lz4.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#define NOGDI   // wingdi.h define ERROR, que choca con la macro de Prerequisites.h.
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    // Un bloque LZ4 no expande ms de 255 veces (cada byte de longitud agrega a lo sumo 255).
+    constexpr uint64_t LZ4_MAX_RATIO = 255;
+    // Ningn recurso del juego se acerca a esto; una entrada ms grande es un archivo corrupto.
+    constexpr uint32_t MAX_ENTRY_SIZE = 256u * 1024u * 1024u;
+}
+
+// Destructor: libera la proyeccin si sigue abierta.
+AssetArchive::~AssetArchive() {
+    close();
+}
+
+/*
+   Abre y proyecta el archivo en memoria de solo lectura.
+   Despus valida que la cabecera, la tabla de contenidos y cada blob caigan dentro del archivo,
+   para que un archivo truncado o corrupto no provoque lecturas fuera de la proyeccin.
+*/
+bool AssetArchive::open(const std::string& path) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < static_cast<LONGLONG>(sizeof(ArchiveHeader))) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        CloseHandle(file);
+        return false;
+    }
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    m_file = file;
+    m_mapping = mapping;
+    m_data = static_cast<const uint8_t*>(view);
+    m_size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(ArchiveHeader))) {
+        ::close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // La proyeccin se mantiene aunque se cierre el descriptor.
+    if (view == MAP_FAILED) {
+        return false;
+    }
+    m_data = static_cast<const uint8_t*>(view);
+    m_size = static_cast<size_t>(info.st_size);
+#endif
+
+    m_path = path;
+
+    // Validar cabecera.
+    m_header = reinterpret_cast<const ArchiveHeader*>(m_data);
+    if (std::memcmp(m_header->magic, ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC)) != 0
+        || m_header->version != ARCHIVE_VERSION) {
+        LOG_ERROR("AssetArchive", "open", "cabecera invalida [{}]", path);
+        close();
+        return false;
+    }
+
+    // Validar tablas.
+    const uint64_t tocBytes = static_cast<uint64_t>(m_header->entryCount) * sizeof(ArchiveEntry);
+    if (m_header->tocOffset % alignof(ArchiveEntry) != 0
+        || m_header->tocOffset > m_size || tocBytes > m_size - m_header->tocOffset
+        || m_header->namesOffset > m_size) {
+        LOG_ERROR("AssetArchive", "open", "tabla de contenidos invalida [{}]", path);
+        close();
+        return false;
+    }
+    m_entries = reinterpret_cast<const ArchiveEntry*>(m_data + m_header->tocOffset);
+    m_names = reinterpret_cast<const char*>(m_data + m_header->namesOffset);
+    m_namesSize = m_size - static_cast<size_t>(m_header->namesOffset);
+
+    // Cada nombre debe empezar dentro de la tabla y terminar en '\0' antes de su final,
+    // para que getName nunca lea fuera de la proyeccin.
+    // read() entrega las entradas sin comprimir como una vista de size bytes, as que size debe ser
+    // exactamente lo guardado; las comprimidas reservan size bytes, que se acotan antes de confiar.
+    for (uint32_t i = 0; i < m_header->entryCount; ++i) {
+        const ArchiveEntry& entry = m_entries[i];
+        if (entry.offset > m_size || entry.storedSize > m_size - entry.offset
+            || entry.nameOffset >= m_namesSize
+            || std::memchr(m_names + entry.nameOffset, '\0', m_namesSize - entry.nameOffset) == nullptr) {
+            LOG_ERROR("AssetArchive", "open", "entrada fuera de rango [{}]", path);
+            close();
+            return false;
+        }
+        const bool compressed = (entry.flags & ARCHIVE_ENTRY_LZ4) != 0;
+        if ((!compressed && entry.size != entry.storedSize)
+            || (compressed && (entry.size > MAX_ENTRY_SIZE
+                || entry.size > static_cast<uint64_t>(entry.storedSize) * LZ4_MAX_RATIO))) {
+            LOG_ERROR("AssetArchive", "open", "tamano no valido en [{}] de [{}]", getName(entry), path);
+            close();
+            return false;
+        }
+    }
+    return true;
+}
+
+// Libera la proyeccin y los manejadores del sistema.
+void AssetArchive::close() {
+    if (m_data != nullptr) {
+#ifdef _WIN32
+        UnmapViewOfFile(m_data);
+        CloseHandle(static_cast<HANDLE>(m_mapping));
+        CloseHandle(static_cast<HANDLE>(m_file));
+        m_mapping = nullptr;
+        m_file = nullptr;
+#else
+        munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_header = nullptr;
+    m_entries = nullptr;
+    m_names = nullptr;
+    m_namesSize = 0;
+    m_path.clear();
+}
+
+// Indica si hay un archivo proyectado.
+bool AssetArchive::isOpen() const {
+    return m_data != nullptr;
+}
+
+// Busca por ruta relativa.
+const ArchiveEntry* AssetArchive::find(const std::string& relativePath) const {
+    return find(Hash::hashPath(relativePath));
+}
+
+// Bsqueda binaria por hash en la tabla de contenidos ordenada.
+const ArchiveEntry* AssetArchive::find(uint64_t hash) const {
+    if (m_entries == nullptr) {
+        return nullptr;
+    }
+    const ArchiveEntry* begin = m_entries;
+    const ArchiveEntry* end = m_entries + m_header->entryCount;
+    const ArchiveEntry* it = std::lower_bound(begin, end, hash,
+        [](const ArchiveEntry& entry, uint64_t value) { return entry.hash < value; });
+    return (it != end && it->hash == hash) ? it : nullptr;
+}
+
+/*
+   Devuelve los bytes de una entrada: vista directa o datos descomprimidos.
+*/
+AssetArchive::Blob AssetArchive::read(const ArchiveEntry& entry) const {
+    Blob blob;
+    const uint8_t* stored = m_data + entry.offset;
+
+    if ((entry.flags & ARCHIVE_ENTRY_LZ4) == 0) {
+        blob.data = stored;
+        blob.size = entry.size;
+        return blob;
+    }
+
+    blob.storage.resize(entry.size);
+    if (!Lz4::decompress(stored, entry.storedSize, blob.storage.data(), entry.size)) {
+        LOG_ERROR("AssetArchive", "read", "bloque LZ4 corrupto [{}]", getName(entry));
+        return Blob();
+    }
+    blob.data = blob.storage.data();
+    blob.size = blob.storage.size();
+    return blob;
+}
+
+// Nombre original de una entrada.
+const char* AssetArchive::getName(const ArchiveEntry& entry) const {
+    return m_names != nullptr ? m_names + entry.nameOffset : "";
+}
+
+// Ruta del archivo abierto.
+const std::string& AssetArchive::getPath() const {
+    return m_path;
+}
+
+// Nmero de entradas.
+size_t AssetArchive::getEntryCount() const {
+    return m_header != nullptr ? m_header->entryCount : 0;
+}
+
+// Tabla de contenidos.
+const ArchiveEntry* AssetArchive::getEntries() const {
+    return m_entries;
+}
+
+// Tamao de la proyeccin.
+size_t AssetArchive::getMappedSize() const {
+    return m_size;
+}
+
+/*
+   Empaqueta un directorio.
+   Los blobs se escriben primero, cada uno alineado; al final se escriben la tabla de contenidos
+   ordenada por hash y la tabla de nombres, y se reescribe la cabecera con sus posiciones.
+*/
+bool AssetArchive::build(const std::string& sourceDirectory, const std::string& outputPath, bool compress) {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+
+    if (!fs::is_directory(sourceDirectory, ec)) {
+        LOG_ERROR("AssetArchive", "build", "no existe el directorio [{}]", sourceDirectory);
+        return false;
+    }
+
+    // Reunir los archivos con su ruta relativa (con '/' como separador).
+    const fs::path outputAbsolute = fs::absolute(outputPath, ec);
+    std::vector<std::pair<std::string, fs::path>> files;
+    for (const auto& item : fs::recursive_directory_iterator(sourceDirectory, ec)) {
+        if (!item.is_regular_file() || fs::equivalent(item.path(), outputAbsolute, ec)) {
+            continue;
+        }
+        files.emplace_back(fs::relative(item.path(), sourceDirectory, ec).generic_string(), item.path());
+    }
+
+    std::ofstream out(outputPath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        LOG_ERROR("AssetArchive", "build", "no se pudo crear [{}]", outputPath);
+        return false;
+    }
+
+    ArchiveHeader header{};
+    std::memcpy(header.magic, ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC));
+    header.version = ARCHIVE_VERSION;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    std::vector<ArchiveEntry> entries;
+    std::string names;
+    uint64_t offset = sizeof(header);
+    size_t originalBytes = 0;
+    size_t storedBytes = 0;
+
+    for (const auto& [relative, path] : files) {
+        std::ifstream in(path, std::ios::binary);
+        std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        if (!in.good() && !in.eof()) {
+            LOG_ERROR("AssetArchive", "build", "error al leer [{}]", path.string());
+            return false;
+        }
+        if (bytes.size() > UINT32_MAX) {
+            LOG_ERROR("AssetArchive", "build", "archivo demasiado grande [{}]", relative);
+            return false;
+        }
+
+        ArchiveEntry entry{};
+        entry.hash = Hash::hashPath(relative);
+        entry.size = static_cast<uint32_t>(bytes.size());
+        entry.nameOffset = static_cast<uint32_t>(names.size());
+        names.append(relative).push_back('\0');
+
+        // Comprimir solo si ahorra al menos un 10 %, y nunca las fuentes ni lo que pase de
+        // MAX_ENTRY_SIZE (open() lo rechazara).
+        const std::string extension = path.extension().string();
+        const bool isFont = extension == ".ttf" || extension == ".otf";
+        std::vector<uint8_t> compressed;
+        if (compress && !isFont && !bytes.empty() && bytes.size() <= MAX_ENTRY_SIZE) {
+            compressed = Lz4::compress(bytes.data(), bytes.size());
+            if (compressed.size() * 10 <= bytes.size() * 9) {
+                entry.flags |= ARCHIVE_ENTRY_LZ4;
+            }
+        }
+        const std::vector<uint8_t>& stored = (entry.flags & ARCHIVE_ENTRY_LZ4) ? compressed : bytes;
+
+        // Alinear el inicio del blob.
+        const uint64_t padding = (ARCHIVE_ALIGNMENT - offset % ARCHIVE_ALIGNMENT) % ARCHIVE_ALIGNMENT;
+        static const char zeros[ARCHIVE_ALIGNMENT] = {};
+        out.write(zeros, static_cast<std::streamsize>(padding));
+        offset += padding;
+
+        entry.offset = offset;
+        entry.storedSize = static_cast<uint32_t>(stored.size());
+        out.write(reinterpret_cast<const char*>(stored.data()), static_cast<std::streamsize>(stored.size()));
+        offset += stored.size();
+
+        originalBytes += bytes.size();
+        storedBytes += stored.size();
+        entries.push_back(entry);
+    }
+
+    // Tabla de contenidos ordenada por hash; dos rutas con el mismo hash no podran distinguirse.
+    std::sort(entries.begin(), entries.end(),
+        [](const ArchiveEntry& a, const ArchiveEntry& b) { return a.hash < b.hash; });
+    for (size_t i = 1; i < entries.size(); ++i) {
+        if (entries[i].hash == entries[i - 1].hash) {
+            LOG_ERROR("AssetArchive", "build", "colision de hash entre [{}] y [{}]",
+                names.c_str() + entries[i].nameOffset, names.c_str() + entries[i - 1].nameOffset);
+            return false;
+        }
+    }
+
+    const uint64_t tocPadding = (alignof(ArchiveEntry) - offset % alignof(ArchiveEntry)) % alignof(ArchiveEntry);
+    static const char tocZeros[alignof(ArchiveEntry)] = {};
+    out.write(tocZeros, static_cast<std::streamsize>(tocPadding));
+    offset += tocPadding;
+
+    header.entryCount = static_cast<uint32_t>(entries.size());
+    header.tocOffset = offset;
+    out.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(ArchiveEntry)));
+    offset += entries.size() * sizeof(ArchiveEntry);
+
+    header.namesOffset = offset;
+    out.write(names.data(), static_cast<std::streamsize>(names.size()));
+
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (!out) {
+        LOG_ERROR("AssetArchive", "build", "error al escribir [{}]", outputPath);
+        return false;
+    }
+
+    std::cout << "AssetArchive::build : " << entries.size() << " recursos, "
+        << originalBytes << " bytes -> " << storedBytes << " bytes en [" << outputPath << "]\n";
+    return true;
+}
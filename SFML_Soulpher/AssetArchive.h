@@ -0,0 +1,142 @@
+#pragma once
+#include "Prerequisites.h"
+#include "Hash.h"
+#include <cstdint>
+
+/*
+  Formato de archivo empaquetado (.spak)
+
+  [ArchiveHeader][blob 0][blob 1]...[tabla de contenidos][tabla de nombres]
+
+  - Cada blob empieza alineado a ARCHIVE_ALIGNMENT bytes.
+  - La tabla de contenidos (ArchiveEntry) est ordenada por el hash de la ruta relativa,
+    por lo que una bsqueda es una bsqueda binaria sin comparar cadenas.
+  - La tabla de nombres guarda las rutas originales solo para depuracin y listados.
+  - Todos los enteros estn en little-endian.
+*/
+constexpr char ARCHIVE_MAGIC[4] = { 'S', 'P', 'A', 'K' };
+constexpr uint32_t ARCHIVE_VERSION = 1;
+constexpr uint64_t ARCHIVE_ALIGNMENT = 64;
+constexpr uint32_t ARCHIVE_ENTRY_LZ4 = 1u << 0;   // El blob est comprimido con LZ4.
+
+struct ArchiveHeader
+{
+    char magic[4];          // "SPAK".
+    uint32_t version;       // ARCHIVE_VERSION.
+    uint32_t entryCount;    // Nmero de entradas de la tabla de contenidos.
+    uint32_t flags;         // Reservado.
+    uint64_t tocOffset;     // Posicin de la tabla de contenidos.
+    uint64_t namesOffset;   // Posicin de la tabla de nombres.
+};
+
+struct ArchiveEntry
+{
+    uint64_t hash;          // Hash::hashPath de la ruta relativa del recurso.
+    uint64_t offset;        // Posicin del blob dentro del archivo.
+    uint32_t storedSize;    // Bytes guardados (comprimidos si ARCHIVE_ENTRY_LZ4).
+    uint32_t size;          // Bytes originales.
+    uint32_t flags;         // ARCHIVE_ENTRY_*.
+    uint32_t nameOffset;    // Posicin del nombre (terminado en '\0') dentro de la tabla de nombres.
+};
+
+static_assert(sizeof(ArchiveHeader) == 32, "ArchiveHeader debe ocupar 32 bytes");
+static_assert(sizeof(ArchiveEntry) == 32, "ArchiveEntry debe ocupar 32 bytes");
+
+/*
+  Clase AssetArchive
+  - Lee un archivo .spak proyectndolo en memoria (mmap en POSIX, MapViewOfFile en Windows).
+  - Los recursos sin comprimir se entregan como un puntero directo a la proyeccin, sin copias,
+    listo para sf::Texture::loadFromMemory o sf::Image::loadFromMemory.
+  - El sistema operativo solo lee del disco las pginas que realmente se tocan.
+*/
+class AssetArchive
+{
+public:
+    /*
+      Estructura Blob.
+      - Vista de los bytes de un recurso. Si el recurso estaba comprimido, los datos viven en
+        storage; en caso contrario data apunta directamente a la proyeccin del archivo.
+    */
+    struct Blob
+    {
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+        std::vector<uint8_t> storage;
+
+        explicit operator bool() const { return data != nullptr; }
+    };
+
+    // Constructor por defecto. El archivo se abre con open().
+    AssetArchive() = default;
+
+    // Destructor. Libera la proyeccin en memoria.
+    ~AssetArchive();
+
+    AssetArchive(const AssetArchive&) = delete;
+    AssetArchive& operator=(const AssetArchive&) = delete;
+
+    /*
+      Funcin open.
+      - Proyecta el archivo en memoria y valida la cabecera y la tabla de contenidos.
+      - Devuelve false si el archivo no existe o no es un .spak vlido.
+    */
+    bool open(const std::string& path);
+
+    // Libera la proyeccin. Los punteros devueltos por find/read dejan de ser vlidos.
+    void close();
+
+    // Indica si hay un archivo abierto.
+    bool isOpen() const;
+
+    /*
+      Funcin find.
+      - Busca una entrada por ruta relativa (por ejemplo "Circuit.png") o directamente por su hash.
+      - Devuelve nullptr si el recurso no est en el archivo.
+    */
+    const ArchiveEntry* find(const std::string& relativePath) const;
+    const ArchiveEntry* find(uint64_t hash) const;
+
+    /*
+      Funcin read.
+      - Devuelve los bytes de una entrada. Sin compresin no hay copia: el Blob apunta a la proyeccin.
+      - Con LZ4, los datos se descomprimen en Blob::storage.
+    */
+    Blob read(const ArchiveEntry& entry) const;
+
+    // Nombre original de una entrada (para listados y depuracin).
+    const char* getName(const ArchiveEntry& entry) const;
+
+    // Ruta del archivo abierto.
+    const std::string& getPath() const;
+
+    // Nmero de entradas.
+    size_t getEntryCount() const;
+
+    // Acceso a la tabla de contenidos completa.
+    const ArchiveEntry* getEntries() const;
+
+    // Tamao total del archivo proyectado.
+    size_t getMappedSize() const;
+
+    /*
+      Funcin build.
+      - Empaqueta todos los archivos de sourceDirectory (recursivamente) en outputPath.
+      - Con compress, los blobs se comprimen con LZ4 cuando ahorran al menos un 10 %.
+        Las fuentes nunca se comprimen porque sf::Font lee de la memoria durante toda su vida.
+    */
+    static bool build(const std::string& sourceDirectory, const std::string& outputPath, bool compress);
+
+private:
+    std::string m_path;                         // Ruta del archivo.
+    const uint8_t* m_data = nullptr;            // Inicio de la proyeccin.
+    size_t m_size = 0;                          // Tamao de la proyeccin.
+    const ArchiveHeader* m_header = nullptr;    // Cabecera validada.
+    const ArchiveEntry* m_entries = nullptr;    // Tabla de contenidos.
+    const char* m_names = nullptr;              // Tabla de nombres.
+    size_t m_namesSize = 0;                     // Tamao de la tabla de nombres.
+
+#ifdef _WIN32
+    void* m_file = nullptr;                     // HANDLE del archivo.
+    void* m_mapping = nullptr;                  // HANDLE de la proyeccin.
+#endif
+};
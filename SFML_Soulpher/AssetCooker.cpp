@@ -0,0 +1,422 @@
+#include "AssetCooker.h"
+#include "ThreadPool.h"
+#include "Hash.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <cctype>
+#include <cstdlib>
+
+namespace
+{
+    // Cambiar este valor invalida todas las salidas cocinadas (por ejemplo, al cambiar el formato).
+    constexpr uint64_t COOKER_VERSION = 1;
+
+    const char* const MANIFEST_NAME = "cook_manifest.txt";
+
+    // Resultado del trabajo de un hilo para un archivo.
+    enum class CookResult { UpToDate, Cooked, Copied, Failed };
+
+    struct CookJob
+    {
+        std::string relative;               // Ruta relativa de la entrada.
+        std::filesystem::path source;       // Ruta completa de la entrada.
+        std::string output;                 // Ruta relativa de la salida.
+        uint64_t key = 0;                   // Hash del contenido y las opciones.
+        CookResult result = CookResult::Failed;
+    };
+
+    // Lee un archivo completo.
+    bool readFile(const std::filesystem::path& path, std::vector<uint8_t>& bytes) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            return false;
+        }
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        return !in.bad();
+    }
+
+    // Escribe un archivo completo.
+    bool writeFile(const std::filesystem::path& path, const std::vector<uint8_t>& bytes) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        return static_cast<bool>(out);
+    }
+
+    // Alfa del pxel (x, y) de un bfer RGBA.
+    inline uint8_t alphaAt(const uint8_t* pixels, unsigned int width, unsigned int x, unsigned int y) {
+        return pixels[(static_cast<size_t>(y) * width + x) * 4 + 3];
+    }
+
+    // Dos rectngulos se unen si se solapan o estn a un pxel de distancia.
+    bool touches(const sf::IntRect& a, const sf::IntRect& b) {
+        return a.left <= b.left + b.width && b.left <= a.left + a.width
+            && a.top <= b.top + b.height && b.top <= a.top + a.height;
+    }
+
+    sf::IntRect merge(const sf::IntRect& a, const sf::IntRect& b) {
+        const int left = std::min(a.left, b.left);
+        const int top = std::min(a.top, b.top);
+        const int right = std::max(a.left + a.width, b.left + b.width);
+        const int bottom = std::max(a.top + a.height, b.top + b.height);
+        return sf::IntRect(left, top, right - left, bottom - top);
+    }
+}
+
+/*
+   Cocina un directorio.
+   1. Se renen las entradas y se lee el manifiesto anterior.
+   2. Cada entrada se procesa en el pool: se lee, se calcula su hash y, si no coincide con el del
+      manifiesto o falta la salida, se cocina o se copia. Cada tarea escribe solo en su propio CookJob.
+   3. Se escribe el manifiesto nuevo y se eliminan las salidas hurfanas.
+*/
+bool AssetCooker::cook(const std::string& sourceDirectory, const std::string& outputDirectory,
+    const Options& options, Report* report) {
+    namespace fs = std::filesystem;
+    sf::Clock clock;
+    std::error_code ec;
+
+    if (!fs::is_directory(sourceDirectory, ec)) {
+        std::cerr << "AssetCooker::cook : no existe el directorio [" << sourceDirectory << "]\n";
+        return false;
+    }
+    fs::create_directories(outputDirectory, ec);
+    if (!fs::is_directory(outputDirectory, ec)) {
+        std::cerr << "AssetCooker::cook : no se pudo crear [" << outputDirectory << "]\n";
+        return false;
+    }
+
+    const std::string manifestPath = (fs::path(outputDirectory) / MANIFEST_NAME).string();
+    const Manifest previous = options.force ? Manifest() : readManifest(manifestPath);
+
+    // Las opciones forman parte del hash: cambiar una opcin invalida todas las salidas.
+    const uint8_t optionBytes[4] = { static_cast<uint8_t>(options.premultiply), static_cast<uint8_t>(options.trim),
+        static_cast<uint8_t>(options.findSprites), 0 };
+    uint64_t seed = Hash::fnv1a64(&COOKER_VERSION, sizeof(COOKER_VERSION));
+    seed = Hash::fnv1a64(optionBytes, sizeof(optionBytes), seed);
+
+    // 1. Reunir las entradas, sin entrar en el directorio de salida si est dentro del de origen.
+    const fs::path outputAbsolute = fs::weakly_canonical(outputDirectory, ec);
+    std::vector<CookJob> jobs;
+    for (auto it = fs::recursive_directory_iterator(sourceDirectory, ec); it != fs::recursive_directory_iterator(); it.increment(ec)) {
+        if (it->is_directory() && fs::weakly_canonical(it->path(), ec) == outputAbsolute) {
+            it.disable_recursion_pending();
+            continue;
+        }
+        if (!it->is_regular_file()) {
+            continue;
+        }
+
+        CookJob job;
+        job.relative = fs::relative(it->path(), sourceDirectory, ec).generic_string();
+        job.source = it->path();
+        job.output = job.relative;
+        if (isImagePath(job.relative)) {
+            job.output = fs::path(job.relative).replace_extension(".cooked").generic_string();
+        }
+        jobs.push_back(std::move(job));
+    }
+
+    // 2. Procesar en paralelo. El hilo principal solo espera, as que se usan todos los ncleos.
+    const unsigned int cores = std::max(1u, std::thread::hardware_concurrency());
+    {
+        ThreadPool pool(options.threadCount != 0 ? options.threadCount : cores, "Cooker");
+        for (CookJob& job : jobs) {
+            pool.submit([&job, &previous, &options, &outputDirectory, seed]() {
+                std::vector<uint8_t> bytes;
+                if (!readFile(job.source, bytes)) {
+                    std::cerr << "AssetCooker::cook : error al leer [" << job.relative << "]\n";
+                    return;
+                }
+                job.key = Hash::fnv1a64(bytes.data(), bytes.size(), seed);
+
+                const fs::path output = fs::path(outputDirectory) / job.output;
+                std::error_code exists;
+                auto known = previous.find(job.relative);
+                if (known != previous.end() && known->second.key == job.key && known->second.output == job.output
+                    && fs::exists(output, exists)) {
+                    job.result = CookResult::UpToDate;
+                    return;
+                }
+
+                fs::create_directories(output.parent_path(), exists);
+                if (isImagePath(job.relative)) {
+                    job.result = cookImage(bytes, output.string(), options) ? CookResult::Cooked : CookResult::Failed;
+                }
+                else {
+                    job.result = writeFile(output, bytes) ? CookResult::Copied : CookResult::Failed;
+                }
+                if (job.result == CookResult::Failed) {
+                    std::cerr << "AssetCooker::cook : no se pudo procesar [" << job.relative << "]\n";
+                }
+            });
+        }
+        pool.waitIdle();
+    }
+
+    // 3. Manifiesto nuevo. Las entradas fallidas no se guardan para reintentarlas la prxima vez.
+    Report result;
+    result.scanned = jobs.size();
+    Manifest current;
+    for (const CookJob& job : jobs) {
+        switch (job.result) {
+        case CookResult::UpToDate: ++result.upToDate; break;
+        case CookResult::Cooked:   ++result.cooked; break;
+        case CookResult::Copied:   ++result.copied; break;
+        case CookResult::Failed:   ++result.failed; continue;
+        }
+        current[job.relative] = ManifestEntry{ job.key, job.output };
+    }
+
+    // Salidas que ya no corresponden a ninguna entrada.
+    std::unordered_map<std::string, bool> liveOutputs;
+    for (const auto& [relative, entry] : current) {
+        liveOutputs[entry.output] = true;
+    }
+    for (const auto& [relative, entry] : previous) {
+        if (liveOutputs.count(entry.output) == 0 && fs::remove(fs::path(outputDirectory) / entry.output, ec)) {
+            ++result.removed;
+        }
+    }
+
+    const bool manifestOk = writeManifest(manifestPath, current);
+    result.elapsed = clock.getElapsedTime();
+
+    std::cout << "AssetCooker::cook : " << result.scanned << " archivos, " << result.cooked << " cocinados, "
+        << result.copied << " copiados, " << result.upToDate << " sin cambios, " << result.removed << " eliminados, "
+        << result.failed << " errores en " << result.elapsed.asMilliseconds() << " ms\n";
+
+    if (report != nullptr) {
+        *report = result;
+    }
+    return manifestOk && result.failed == 0;
+}
+
+/*
+   Premultiplica el alfa con redondeo: c' = (c * a + 127) / 255.
+*/
+void AssetCooker::premultiplyAlpha(sf::Image& image) {
+    const sf::Vector2u size = image.getSize();
+    std::vector<uint8_t> pixels(image.getPixelsPtr(), image.getPixelsPtr() + static_cast<size_t>(size.x) * size.y * 4);
+    for (size_t i = 0; i < pixels.size(); i += 4) {
+        const unsigned int alpha = pixels[i + 3];
+        for (size_t c = 0; c < 3; ++c) {
+            pixels[i + c] = static_cast<uint8_t>((pixels[i + c] * alpha + 127) / 255);
+        }
+    }
+    image.create(size.x, size.y, pixels.data());
+}
+
+// Recorre filas y columnas buscando el primer y ltimo pxel con alfa.
+sf::IntRect AssetCooker::findOpaqueBounds(const sf::Image& image) {
+    const sf::Vector2u size = image.getSize();
+    const uint8_t* pixels = image.getPixelsPtr();
+    int left = static_cast<int>(size.x);
+    int top = static_cast<int>(size.y);
+    int right = -1;
+    int bottom = -1;
+
+    for (unsigned int y = 0; y < size.y; ++y) {
+        for (unsigned int x = 0; x < size.x; ++x) {
+            if (alphaAt(pixels, size.x, x, y) != 0) {
+                left = std::min(left, static_cast<int>(x));
+                right = std::max(right, static_cast<int>(x));
+                top = std::min(top, static_cast<int>(y));
+                bottom = std::max(bottom, static_cast<int>(y));
+            }
+        }
+    }
+
+    if (right < 0) {
+        return sf::IntRect();
+    }
+    return sf::IntRect(left, top, right - left + 1, bottom - top + 1);
+}
+
+/*
+   Regiones conectadas (vecindad de 8) con un relleno por pila explcita, para no desbordar la pila
+   del hilo con sprites grandes. Despus se unen los rectngulos que se tocan hasta que no cambie nada.
+*/
+std::vector<sf::IntRect> AssetCooker::findSpriteRects(const sf::Image& image) {
+    const sf::Vector2u size = image.getSize();
+    const uint8_t* pixels = image.getPixelsPtr();
+    std::vector<uint8_t> visited(static_cast<size_t>(size.x) * size.y, 0);
+    std::vector<sf::IntRect> rects;
+    std::vector<sf::Vector2u> stack;
+
+    for (unsigned int y = 0; y < size.y; ++y) {
+        for (unsigned int x = 0; x < size.x; ++x) {
+            const size_t index = static_cast<size_t>(y) * size.x + x;
+            if (visited[index] || alphaAt(pixels, size.x, x, y) == 0) {
+                continue;
+            }
+
+            unsigned int minX = x, maxX = x, minY = y, maxY = y;
+            visited[index] = 1;
+            stack.push_back(sf::Vector2u(x, y));
+            while (!stack.empty()) {
+                const sf::Vector2u p = stack.back();
+                stack.pop_back();
+                minX = std::min(minX, p.x); maxX = std::max(maxX, p.x);
+                minY = std::min(minY, p.y); maxY = std::max(maxY, p.y);
+
+                for (int dy = -1; dy <= 1; ++dy) {
+                    for (int dx = -1; dx <= 1; ++dx) {
+                        const int nx = static_cast<int>(p.x) + dx;
+                        const int ny = static_cast<int>(p.y) + dy;
+                        if (nx < 0 || ny < 0 || nx >= static_cast<int>(size.x) || ny >= static_cast<int>(size.y)) {
+                            continue;
+                        }
+                        const size_t next = static_cast<size_t>(ny) * size.x + nx;
+                        if (!visited[next] && alphaAt(pixels, size.x, nx, ny) != 0) {
+                            visited[next] = 1;
+                            stack.push_back(sf::Vector2u(nx, ny));
+                        }
+                    }
+                }
+            }
+            rects.emplace_back(minX, minY, maxX - minX + 1, maxY - minY + 1);
+        }
+    }
+
+    // Unir rectngulos que se tocan; repetir porque una unin puede alcanzar a otro rectngulo.
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        for (size_t i = 0; i < rects.size() && !merged; ++i) {
+            for (size_t j = i + 1; j < rects.size(); ++j) {
+                if (touches(rects[i], rects[j])) {
+                    rects[i] = merge(rects[i], rects[j]);
+                    rects.erase(rects.begin() + j);
+                    merged = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    // Orden por filas: un rectngulo pertenece a la fila actual si empieza antes de que sta termine.
+    std::sort(rects.begin(), rects.end(),
+        [](const sf::IntRect& a, const sf::IntRect& b) { return a.top < b.top; });
+    auto rowBegin = rects.begin();
+    while (rowBegin != rects.end()) {
+        int rowBottom = rowBegin->top + rowBegin->height;
+        auto rowEnd = rowBegin + 1;
+        while (rowEnd != rects.end() && rowEnd->top < rowBottom) {
+            rowBottom = std::max(rowBottom, rowEnd->top + rowEnd->height);
+            ++rowEnd;
+        }
+        std::sort(rowBegin, rowEnd,
+            [](const sf::IntRect& a, const sf::IntRect& b) { return a.left < b.left; });
+        rowBegin = rowEnd;
+    }
+    return rects;
+}
+
+// Formatos de imagen que SFML puede decodificar.
+bool AssetCooker::isImagePath(const std::string& path) {
+    std::string extension = std::filesystem::path(path).extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+        [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".bmp"
+        || extension == ".tga";
+}
+
+/*
+   Manifiesto: una lnea por entrada con "ruta<TAB>hash hexadecimal<TAB>salida".
+   Se usan tabuladores porque las rutas pueden contener espacios.
+*/
+AssetCooker::Manifest AssetCooker::readManifest(const std::string& path) {
+    Manifest manifest;
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+        const size_t first = line.find('\t');
+        const size_t second = line.find('\t', first + 1);
+        if (first == std::string::npos || second == std::string::npos) {
+            continue;
+        }
+        ManifestEntry entry;
+        entry.key = std::strtoull(line.substr(first + 1, second - first - 1).c_str(), nullptr, 16);
+        entry.output = line.substr(second + 1);
+        manifest[line.substr(0, first)] = entry;
+    }
+    return manifest;
+}
+
+// Se escribe en un archivo temporal y se renombra, para no dejar un manifiesto a medias.
+bool AssetCooker::writeManifest(const std::string& path, const Manifest& manifest) {
+    std::vector<std::pair<std::string, ManifestEntry>> sorted(manifest.begin(), manifest.end());
+    std::sort(sorted.begin(), sorted.end(),
+        [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::trunc);
+        for (const auto& [relative, entry] : sorted) {
+            out << relative << '\t' << std::hex << std::setw(16) << std::setfill('0') << entry.key << std::dec
+                << '\t' << entry.output << '\n';
+        }
+        if (!out) {
+            std::cerr << "AssetCooker::writeManifest : error al escribir [" << temporary << "]\n";
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temporary, path, ec);
+    if (ec) {
+        std::cerr << "AssetCooker::writeManifest : no se pudo reemplazar [" << path << "]\n";
+        return false;
+    }
+    return true;
+}
+
+/*
+   Decodifica, busca los sprites en la imagen completa, recorta y premultiplica.
+   Los sprites se buscan antes de premultiplicar porque solo dependen del alfa, y sus rectngulos
+   se expresan despus relativos al recorte.
+*/
+bool AssetCooker::cookImage(const std::vector<uint8_t>& bytes, const std::string& outputPath, const Options& options) {
+    sf::Image image;
+    if (bytes.empty() || !image.loadFromMemory(bytes.data(), bytes.size())) {
+        return false;
+    }
+
+    const sf::Vector2u originalSize = image.getSize();
+    CookedImage::Info info;
+    info.header.originalWidth = originalSize.x;
+    info.header.originalHeight = originalSize.y;
+
+    if (options.findSprites) {
+        info.rects = findSpriteRects(image);
+    }
+
+    if (options.trim) {
+        sf::IntRect bounds = findOpaqueBounds(image);
+        if (bounds.width == 0) {
+            bounds = sf::IntRect(0, 0, 1, 1);   // Imagen vaca: se conserva un pxel transparente.
+        }
+        if (bounds != sf::IntRect(0, 0, originalSize.x, originalSize.y)) {
+            sf::Image trimmed;
+            trimmed.create(bounds.width, bounds.height, sf::Color::Transparent);
+            trimmed.copy(image, 0, 0, bounds);
+            image = trimmed;
+            info.header.flags |= COOKED_TRIMMED;
+        }
+        info.header.trimX = bounds.left;
+        info.header.trimY = bounds.top;
+        for (sf::IntRect& rect : info.rects) {
+            rect.left -= bounds.left;
+            rect.top -= bounds.top;
+        }
+    }
+
+    if (options.premultiply) {
+        premultiplyAlpha(image);
+        info.header.flags |= COOKED_PREMULTIPLIED;
+    }
+
+    return CookedImage::save(outputPath, image, info);
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include "Prerequisites.h"
+#include "CookedImage.h"
+#include <cstdint>
+#include <unordered_map>
+
+/*
+  Clase AssetCooker
+  - Herramienta fuera de lnea que "cocina" un directorio de recursos: convierte cada imagen al
+    formato .cooked (RGBA listo para la GPU) y copia el resto de archivos tal cual.
+  - Procesa las imgenes en todos los ncleos: alfa premultiplicado, recorte de bordes transparentes
+    y clculo de los rectngulos de cada sprite dentro de la hoja.
+  - Es incremental: cada entrada se identifica por el hash de su contenido (y de las opciones de
+    cocinado). El manifiesto cook_manifest.txt guarda esos hashes, as que solo se vuelven a procesar
+    los archivos que cambiaron; las salidas de archivos borrados se eliminan.
+  En motores 3D, este paso es el "asset pipeline": el juego solo carga datos ya procesados y
+  el trabajo caro (decodificar, comprimir, analizar) se hace una vez al construir.
+*/
+class AssetCooker
+{
+public:
+    /*
+      Estructura Options.
+      - Pasos de cocinado activos. Cambiar las opciones invalida todas las entradas del manifiesto.
+    */
+    struct Options
+    {
+        // Apagados por defecto: ResourceManager todava no guarda CookedImage::Info con la textura,
+        // as que el render no aplicara BlendPremultipliedAlpha ni el desplazamiento del recorte.
+        bool premultiply = false;      // Multiplicar el color por el alfa.
+        bool trim = false;             // Eliminar los bordes totalmente transparentes.
+        bool findSprites = true;       // Calcular los rectngulos de los sprites.
+        unsigned int threadCount = 0;  // 0 = todos los ncleos.
+        bool force = false;            // Ignorar el manifiesto y cocinar todo.
+    };
+
+    /*
+      Estructura Report.
+      - Resumen de una ejecucin del cocinador.
+    */
+    struct Report
+    {
+        size_t scanned = 0;     // Archivos encontrados.
+        size_t cooked = 0;      // Imgenes procesadas.
+        size_t copied = 0;      // Archivos copiados sin procesar.
+        size_t upToDate = 0;    // Entradas que no cambiaron desde la ltima ejecucin.
+        size_t removed = 0;     // Salidas eliminadas porque su entrada ya no existe.
+        size_t failed = 0;      // Archivos que no se pudieron procesar.
+        sf::Time elapsed;
+    };
+
+    /*
+      Funcin cook.
+      - Cocina sourceDirectory en outputDirectory respetando la estructura de carpetas.
+      - Las imgenes cambian su extensin a .cooked ("Circuit.png" -> "Circuit.cooked").
+      - Devuelve false si hubo algn error.
+    */
+    static bool cook(const std::string& sourceDirectory, const std::string& outputDirectory,
+        const Options& options, Report* report = nullptr);
+
+    // Multiplica el color de cada pxel por su alfa.
+    static void premultiplyAlpha(sf::Image& image);
+
+    /*
+      Funcin findOpaqueBounds.
+      - Rectngulo mnimo que contiene todos los pxeles con alfa distinto de cero.
+      - Devuelve un rectngulo vaco si la imagen es totalmente transparente.
+    */
+    static sf::IntRect findOpaqueBounds(const sf::Image& image);
+
+    /*
+      Funcin findSpriteRects.
+      - Busca las regiones conectadas de pxeles no transparentes y devuelve su rectngulo,
+        uniendo las que se tocan o se solapan (por ejemplo, los ojos separados de una cara).
+      - Los rectngulos se ordenan por filas, de arriba a abajo y de izquierda a derecha.
+    */
+    static std::vector<sf::IntRect> findSpriteRects(const sf::Image& image);
+
+    // Indica si el cocinador procesa este archivo como imagen.
+    static bool isImagePath(const std::string& path);
+
+private:
+    /*
+      Estructura ManifestEntry.
+      - Estado de una entrada en la ltima ejecucin: hash de su contenido y salida generada.
+    */
+    struct ManifestEntry
+    {
+        uint64_t key = 0;
+        std::string output;
+    };
+
+    using Manifest = std::unordered_map<std::string, ManifestEntry>;
+
+    static Manifest readManifest(const std::string& path);
+    static bool writeManifest(const std::string& path, const Manifest& manifest);
+
+    // Procesa una imagen ya leda y escribe su versin cocinada.
+    static bool cookImage(const std::vector<uint8_t>& bytes, const std::string& outputPath, const Options& options);
+};
@@ -4,21 +4,512 @@
    Ejecucin de la aplicacin. 
    Este mtodo mantiene la aplicacin en un bucle continuo, manejando eventos,
    Llama constantemente a los mtodos update y render, hasta que se cierre la ventaana
+   La simulacin avanza con un paso fijo (acumulador): cada frame se ejecutan tantos ticks
+   como quepan en el tiempo transcurrido, y el sobrante se usa para interpolar al dibujar.
    int, Cdigo de salida (0 si la ejecucin fue exitosa).
 */
 int BaseApp::run() {
+    PROFILE_THREAD("Main");
+    if (!startInput()) {
+        return 1;
+    }
+    if (m_stressCount > 0 && m_threaded) {
+        LOG_WARN("BaseApp", "run", "la escena de estres usa el bucle de un solo hilo");
+        m_threaded = false;
+    }
+    if (!m_tracePath.empty()) {
+        Profiler::getInstance().startTrace(m_tracePath);
+    }
+    if (m_headlessTicks > 0) {
+        return runHeadless();
+    }
     if (!initialize()) {
-        ERROR("BaseApp", "run", "Initialization failed. Check method validations.");
+        LOG_FATAL("BaseApp", "run", "Initialization failed. Check method validations.");
+    }
+    if (m_threaded) {
+        return runThreaded();
     }
+
+    const float tickTime = 1.0f / m_tickRate;
+    float accumulator = 0.0f;
+
     while (m_window->isOpen()) {
+        const bool measure = m_hud.isVisible();
+        const auto frameStart = measure ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+
         m_window->handleEvents();
         update();
+
+        // Limitar el tiempo de un frame lento para no caer en la "espiral de la muerte":
+        // si simular cuesta ms que el tiempo que se simula, cada frame tendra ms ticks que el anterior.
+        accumulator += std::min(m_window->deltaTime.asSeconds(), MAX_FRAME_TIME);
+
+        // En avance rpido cada frame simula el mximo de ticks, sin importar el tiempo real.
+        if (m_fastForward && m_inputRecorder.isReplaying()) {
+            accumulator = tickTime * MAX_TICKS_PER_FRAME;
+        }
+
+        sampleInput();
+        m_ticksLastFrame = 0;
+        while (accumulator >= tickTime && m_ticksLastFrame < MAX_TICKS_PER_FRAME) {
+            if (!readTickInput()) {
+                m_window->getWindow()->close();
+                break;
+            }
+            fixedUpdate(tickTime);
+            accumulator -= tickTime;
+            ++m_ticksLastFrame;
+        }
+
+        // Si aun as qued trabajo atrasado, se descarta: la simulacin va ms lenta en lugar de congelarse.
+        if (accumulator >= tickTime) {
+            accumulator = std::fmod(accumulator, tickTime);
+        }
+
+        if (measure) {
+            m_updateMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - frameStart).count();
+        }
+
+        render(accumulator / tickTime);
+        PROFILE_FRAME();
+    }
+    cleanup();
+    return 0;
+}
+
+/*
+   Bucle del modo sin ventana.
+   Ejecuta el mismo paso fijo que el juego (fixedUpdate ms la actualizacin de cada actor),
+   sin dormir entre ticks ni dibujar. Al terminar imprime el tiempo total, los ticks por segundo
+   y la posicin final del crculo, que debe coincidir entre ejecuciones con el mismo nmero de ticks.
+*/
+int BaseApp::runHeadless() {
+    if (!createActors()) {
+        LOG_ERROR("BaseApp", "runHeadless", "no se pudieron crear los actores");
+        Logger::getInstance().flush();
+        return 1;
+    }
+    if (!Circle.isNull()) Circle->getComponent<Transform>()->savePreviousState();
+
+    // Sin ventana no hay ratn: se coloca lejos de la pista para que el crculo siga los waypoints.
+    // Si se reproduce una grabacin, la entrada viene de ella.
+    m_liveInput.mousePosition = sf::Vector2i(-100000, -100000);
+
+    const float tickTime = 1.0f / m_tickRate;
+    const auto start = std::chrono::steady_clock::now();
+
+    int ticks = 0;
+    for (; ticks < m_headlessTicks && readTickInput(); ++ticks) {
+        fixedUpdate(tickTime);
+        for (auto* actor : { &Track, &Circle, &Triangle }) {
+            if (!actor->isNull()) (*actor)->update(tickTime);
+        }
+        PROFILE_FRAME();
+    }
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    m_inputRecorder.stop();
+    Profiler::getInstance().stopTrace();
+    const sf::Vector2f position = Circle.isNull() ? sf::Vector2f() : Circle->getComponent<Transform>()->getPosition();
+    std::cout << "headless: " << ticks << " ticks at " << m_tickRate << " Hz in "
+        << seconds * 1000.0 << " ms (" << (seconds > 0.0 ? ticks / seconds : 0.0) << " ticks/s)\n"
+        << "headless: circle at (" << position.x << ", " << position.y << "), waypoint " << currentWaypoint << "\n";
+    // Sin ventana no se pasa por cleanup(): vaciar aqu el log para no perder las ltimas lneas.
+    Logger::getInstance().flush();
+    return 0;
+}
+
+/*
+   Bucle del hilo de render en el modo de dos hilos.
+   Los actores ya existen antes de arrancar la simulacin; a partir de aqu cada hilo usa
+   sus propios punteros crudos (los TSharedPointer no tienen un recuento atmico).
+*/
+int BaseApp::runThreaded() {
+    for (auto& actor : { Circle, Triangle }) {
+        if (!actor.isNull()) {
+            m_simulationTransforms.push_back(actor->getComponent<Transform>().get());
+            m_renderShapes.push_back(actor->getComponent<ShapeFactory>().get());
+        }
+    }
+
+    m_simulationRunning.store(true, std::memory_order_release);
+    std::thread simulation(&BaseApp::simulationLoop, this);
+
+    while (m_window->isOpen()) {
+        const bool measure = m_hud.isVisible();
+        const auto frameStart = measure ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+
+        m_window->handleEvents();
+        update();
+        if (measure) {
+            m_updateMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - frameStart).count();
+        }
+
+        const sf::Vector2i mouse = readMousePosition();
+        const uint64_t packed = (static_cast<uint64_t>(static_cast<uint32_t>(mouse.x)) << 32)
+            | static_cast<uint32_t>(mouse.y);
+        m_mouseState.store(packed, std::memory_order_relaxed);
+
         render();
+        PROFILE_FRAME();
     }
+
+    m_simulationRunning.store(false, std::memory_order_release);
+    simulation.join();
     cleanup();
     return 0;
 }
 
+/*
+   Bucle de simulacin con paso fijo en su propio hilo.
+   Duerme hasta el siguiente tick; si se atrasa ms de MAX_FRAME_TIME (por ejemplo, tras una pausa
+   del depurador), descarta el atraso en lugar de encadenar ticks para alcanzarlo.
+*/
+void BaseApp::simulationLoop() {
+    PROFILE_THREAD("Simulation");
+    using Clock = std::chrono::steady_clock;
+    const auto tickDuration = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / m_tickRate));
+    const auto maxLag = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(MAX_FRAME_TIME));
+    const float tickTime = 1.0f / m_tickRate;
+
+    uint64_t tick = 0;
+    auto nextTick = Clock::now();
+    while (m_simulationRunning.load(std::memory_order_acquire)) {
+        const uint64_t packed = m_mouseState.load(std::memory_order_relaxed);
+        m_mousePosition = sf::Vector2f(static_cast<float>(static_cast<int32_t>(packed >> 32)),
+            static_cast<float>(static_cast<int32_t>(packed & 0xFFFFFFFFu)));
+
+        fixedUpdate(tickTime);
+        publishSnapshot(++tick);
+
+        nextTick += tickDuration;
+        const auto now = Clock::now();
+        if (now - nextTick > maxLag) {
+            nextTick = now;
+        }
+        std::this_thread::sleep_until(nextTick);
+    }
+}
+
+/*
+   Escribe el estado completo en la copia de escritura. El vector conserva su capacidad,
+   as que tras los primeros ticks publicar no reserva memoria.
+*/
+void BaseApp::publishSnapshot(uint64_t tick) {
+    SimulationSnapshot& snapshot = m_snapshots.getWriteBuffer();
+    snapshot.actors.resize(m_simulationTransforms.size());
+    for (size_t i = 0; i < m_simulationTransforms.size(); ++i) {
+        Transform* transform = m_simulationTransforms[i];
+        ActorSnapshot& actor = snapshot.actors[i];
+        actor.previousPosition = transform->getPreviousPosition();
+        actor.position = transform->getPosition();
+        actor.previousRotation = transform->getPreviousRotation();
+        actor.rotation = transform->getRotation();
+        actor.previousScale = transform->getPreviousScale();
+        actor.scale = transform->getScale();
+    }
+    snapshot.circleProgress = m_circleTransform != nullptr && m_racingLine.isValid()
+        ? m_racingLine.project(m_circleTransform->getPosition()) : 0.0f;
+    snapshot.tick = tick;
+    snapshot.time = std::chrono::steady_clock::now();
+    m_snapshots.publish();
+}
+
+/*
+   Interpola cada forma entre los dos ticks del ltimo estado, segn el tiempo transcurrido
+   desde que se public. Si la simulacin se atrasa, alpha se queda en 1 (ltimo estado).
+*/
+void BaseApp::applySnapshot() {
+    const uint64_t previousTick = m_snapshots.getReadBuffer().tick;
+    m_snapshots.fetch();
+    const SimulationSnapshot& snapshot = m_snapshots.getReadBuffer();
+    if (snapshot.tick == 0) {
+        return;
+    }
+    m_ticksLastFrame = static_cast<int>(snapshot.tick - previousTick);
+
+    const float elapsed = std::chrono::duration<float>(std::chrono::steady_clock::now() - snapshot.time).count();
+    const float alpha = std::min(1.0f, elapsed * m_tickRate);
+
+    for (size_t i = 0; i < snapshot.actors.size() && i < m_renderShapes.size(); ++i) {
+        const ActorSnapshot& actor = snapshot.actors[i];
+        ShapeFactory* shape = m_renderShapes[i];
+        shape->setPosition(actor.previousPosition + (actor.position - actor.previousPosition) * alpha);
+        shape->setRotation(Transform::lerpAngle(actor.previousRotation, actor.rotation, alpha));
+        shape->setScale(actor.previousScale + (actor.scale - actor.previousScale) * alpha);
+    }
+}
+
+// Posicin del ratn en coordenadas de la ventana.
+sf::Vector2i BaseApp::readMousePosition() {
+    return sf::Mouse::getPosition(*m_window->getWindow());
+}
+
+/*
+   Abre la grabacin o la reproduccin antes de crear nada, para que la reproduccin
+   fije la frecuencia de la simulacin. El modo de dos hilos no entrega la entrada por tick,
+   as que se desactiva.
+*/
+bool BaseApp::startInput() {
+    if (!m_replayPath.empty()) {
+        if (!m_inputRecorder.startReplay(m_replayPath)) {
+            return false;
+        }
+        m_tickRate = m_inputRecorder.getTickRate();
+        LOG_INFO("BaseApp", "startInput", "reproduciendo {} ticks a {} Hz desde [{}]",
+            m_inputRecorder.getTickCount(), m_tickRate, m_replayPath);
+    }
+    else if (!m_recordPath.empty()) {
+        if (!m_inputRecorder.startRecording(m_recordPath, m_tickRate)) {
+            return false;
+        }
+    }
+    else {
+        return true;
+    }
+
+    if (m_threaded) {
+        LOG_WARN("BaseApp", "startInput", "la grabacion de entrada usa el bucle de un solo hilo");
+        m_threaded = false;
+    }
+    return true;
+}
+
+/*
+   Los eventos se acumulan hasta que un tick los consume: si en un frame no cabe ningn tick,
+   pasan al siguiente en lugar de perderse.
+*/
+void BaseApp::sampleInput() {
+    m_liveInput.mousePosition = readMousePosition();
+    for (const sf::Event& event : m_window->getFrameEvents()) {
+        m_liveInput.applyEvent(event);
+    }
+}
+
+/*
+   Entrada del siguiente tick. La simulacin solo ve m_tickInput (y m_mousePosition, que sale de l).
+*/
+bool BaseApp::readTickInput() {
+    if (m_inputRecorder.isReplaying()) {
+        // La entrada en vivo no se usa al reproducir, pero sampleInput la sigue llenando cada frame.
+        m_liveInput.events.clear();
+        if (!m_inputRecorder.next(m_tickInput)) {
+            return false;
+        }
+    }
+    else {
+        m_tickInput.mousePosition = m_liveInput.mousePosition;
+        m_tickInput.keys = m_liveInput.keys;
+        m_tickInput.events.swap(m_liveInput.events);
+        m_liveInput.events.clear();
+        m_inputRecorder.record(m_tickInput);
+    }
+
+    m_mousePosition = sf::Vector2f(static_cast<float>(m_tickInput.mousePosition.x),
+        static_cast<float>(m_tickInput.mousePosition.y));
+    return true;
+}
+
+/*
+   Programa la grabacin de la entrada.
+*/
+void BaseApp::setInputRecording(const std::string& path) {
+    m_recordPath = path;
+}
+
+/*
+   Programa la carga del flow field; se lee al crear los actores.
+*/
+void BaseApp::setFlowField(const std::string& path) {
+    m_flowFieldPath = path;
+}
+
+std::vector<sf::Vector2f> BaseApp::getSwarmRoute() const {
+    if (m_flowField.isValid()) {
+        return m_flowField.getCheckpoints();
+    }
+    return m_racingLine.resample(SWARM_ROUTE_SPACING);
+}
+
+/*
+   Superposicin de rendimiento visible desde el inicio.
+*/
+void BaseApp::setHudVisible(bool visible) {
+    m_hud.setVisible(visible);
+    m_lastAllocations = AllocationTracker::getSnapshot();
+}
+
+// Presupuesto de llamadas de dibujo; se aplica a la ventana al inicializar.
+void BaseApp::setDrawCallBudget(size_t budget) {
+    m_drawCallBudget = budget;
+    if (m_window != nullptr) {
+        m_window->setDrawCallBudget(budget);
+    }
+}
+
+/*
+   Programa la escena de estrs (hasta un milln de karts).
+*/
+void BaseApp::setStress(size_t count) {
+    m_stressCount = std::min<size_t>(count, 1000000);
+}
+
+/*
+   Mediciones del ltimo tick y del ltimo frame. Los botones rehacen la escena con el doble
+   o la mitad de karts, para encontrar a partir de qu N el costo por kart se dispara.
+*/
+void BaseApp::drawStressPanel() {
+    const KartSwarm::Stats& stats = m_swarm.getStats();
+    const double perKartNs = stats.count > 0 ? (stats.updateMs + stats.renderPrepMs) * 1e6 / stats.count : 0.0;
+
+    ImGui::Begin("STRESS");
+    if (m_swarm.getFlowField() != nullptr) {
+        ImGui::Text("Karts: %zu (flow field, %zu checkpoints)", stats.count, m_swarm.getFlowField()->getCheckpointCount());
+    }
+    else {
+        ImGui::Text("Karts: %zu (kernel %s)", stats.count,
+            WaypointFollower::getKernelName(m_swarm.getFollower().getKernel()));
+    }
+    ImGui::Text("Update: %.3f ms   Render prep: %.3f ms   (%.1f ns/kart)", stats.updateMs, stats.renderPrepMs, perKartNs);
+    if (AllocationTracker::isEnabled()) {
+        ImGui::Text("Memoria: %.0f bytes/kart", stats.bytesPerKart);
+        ImGui::Text("Reservas: %llu en update, %llu en render prep",
+            static_cast<unsigned long long>(stats.updateAllocations), static_cast<unsigned long long>(stats.renderAllocations));
+    }
+    else {
+        ImGui::Text("Memoria y reservas: n/d (compilar con SOULPHER_TRACK_ALLOCATIONS)");
+    }
+
+    ImGui::Checkbox("Clasificacion por progreso", &m_rankSwarm);
+    if (m_rankSwarm) {
+        m_swarm.rankByProgress(m_racingLine, 5, m_swarmLeaders);
+        ImGui::Text("Clasificacion: %.3f ms", m_swarm.getStats().rankMs);
+        for (size_t i = 0; i < m_swarmLeaders.size(); ++i) {
+            ImGui::Text("  %zu. kart %zu: %.0f / %.0f", i + 1, m_swarmLeaders[i].kart,
+                m_swarmLeaders[i].progress, m_racingLine.getLength());
+        }
+    }
+
+    if (m_pathFinder.isValid()) {
+        const PathFinder::Stats paths = m_pathFinder.getStats();
+        ImGui::Separator();
+        ImGui::Text("HPA*: %zu clusters, %zu nodos, %zu aristas", paths.clusters, paths.nodes, paths.edges);
+        ImGui::Text("Caminos: %llu (%llu de la cache), %.3f ms por busqueda, %zu pendientes",
+            static_cast<unsigned long long>(paths.queries), static_cast<unsigned long long>(paths.cacheHits),
+            paths.averageQueryMs, paths.pending);
+        ImGui::Text("PathFinder::update: %.3f ms", paths.lastUpdateMs);
+        if (ImGui::Button("Buscar 256 caminos")) {
+            requestTestPaths(256);
+        }
+    }
+
+    size_t count = stats.count;
+    if (ImGui::Button("x2") && count < 1000000) {
+        count = std::min<size_t>(count * 2, 1000000);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("/2") && count > 1) {
+        count /= 2;
+    }
+    ImGui::End();
+
+    if (count != stats.count) {
+        m_swarm.spawn(count, getSwarmRoute());
+        m_swarm.setTexture(Mario.get(), true);
+    }
+}
+
+/*
+   Las bsquedas corren en los hilos del PathFinder; la funcin de cada una corre en BaseApp::update,
+   en el hilo principal, as que puede tocar m_paths sin candados.
+*/
+void BaseApp::requestTestPaths(size_t count) {
+    const TrackGrid& grid = m_pathFinder.getGrid();
+    const WaypointFollower& karts = m_swarm.getFollower();
+    if (karts.getCount() == 0) {
+        return;
+    }
+    std::uniform_int_distribution<size_t> kart(0, karts.getCount() - 1);
+    std::uniform_int_distribution<size_t> cell(0, grid.getCellCount() - 1);
+    for (size_t i = 0; i < count; ++i) {
+        size_t goal = cell(m_pathRandom);
+        for (int tries = 0; tries < 16 && !grid.isDrivable(goal); ++tries) {
+            goal = cell(m_pathRandom);
+        }
+        m_pathFinder.requestPath(karts.getPosition(kart(m_pathRandom)), grid.getCellCenter(goal),
+            [this](const PathResult& result) {
+                if (!result.found) {
+                    return;
+                }
+                m_paths.push_back(result.points);
+                if (m_paths.size() > MAX_DRAWN_PATHS) {
+                    m_paths.pop_front();
+                }
+                m_pathsDirty = true;
+            });
+    }
+}
+
+// Rehace los vrtices una sola vez por frame, aunque update() haya entregado muchos caminos.
+void BaseApp::rebuildPathVertices() {
+    if (!m_pathsDirty) {
+        return;
+    }
+    m_pathsDirty = false;
+    m_pathVertices.clear();
+    for (const std::vector<sf::Vector2f>& path : m_paths) {
+        for (size_t p = 1; p < path.size(); ++p) {
+            m_pathVertices.append(sf::Vertex(path[p - 1], sf::Color(0, 200, 255, 200)));
+            m_pathVertices.append(sf::Vertex(path[p], sf::Color(0, 200, 255, 200)));
+        }
+    }
+}
+
+/*
+   Programa la grabacin de una traza del profiler.
+*/
+void BaseApp::setTrace(const std::string& path) {
+    m_tracePath = path;
+}
+
+/*
+   Programa la reproduccin de una grabacin de entrada.
+*/
+void BaseApp::setInputReplay(const std::string& path, bool fastForward) {
+    m_replayPath = path;
+    m_fastForward = fastForward;
+}
+
+/*
+   Programa la captura de un frame (el contador empieza en 1).
+*/
+void BaseApp::setFrameCapture(const std::string& path, int frame) {
+    m_capturePath = path;
+    m_captureFrame = path.empty() ? -1 : frame;
+}
+
+/*
+   Activa el modo sin ventana con el nmero de ticks a simular.
+*/
+void BaseApp::setHeadless(int ticks) {
+    m_headlessTicks = std::max(0, ticks);
+}
+
+/*
+   Activa el modo de dos hilos.
+*/
+void BaseApp::setThreaded(bool threaded) {
+    m_threaded = threaded;
+}
+
+/*
+   Cambia la frecuencia de la simulacin (ticks por segundo).
+   Valores fuera de [1, 1000] se limitan a ese rango.
+*/
+void BaseApp::setTickRate(float ticksPerSecond) {
+    m_tickRate = std::max(1.0f, std::min(ticksPerSecond, 1000.0f));
+}
+
 /* 
    Inicializa los recursos necesarios, como actores y texturas.
    true para inicializacin exitosa, false si ocurri un error.
@@ -28,49 +519,126 @@ bool BaseApp::initialize() {
     // Crear la ventana principal.
     m_window = new Window(800, 600, "SFML_SOULPHER");
     if (!m_window) {
-        ERROR("BaseApp", "initialize", "Error al crear la ventana.");
+        LOG_FATAL("BaseApp", "initialize", "Error al crear la ventana.");
         return false;
     }
+    m_window->setDrawCallBudget(m_drawCallBudget);
+
+    // Si existe un archivo empaquetado, los recursos se leen de l en lugar de los archivos sueltos.
+    // Se genera con: SFML_Soulpher --pack "bin/MarioKart sprite-png" --out assets.spak
+    m_resources.mountArchive("assets.spak");
+
+    // Vigilar las texturas en disco para ver los cambios de arte sin reiniciar la aplicacin.
+    m_resources.setHotReload(true);
 
     // Cargar la textura del circuito.
-    if (!texture.loadFromFile("C:/Users/chalu/OneDrive/Documentos/GitHub/SFML_Soulpher/bin/MarioKart sprite-png/Circuit.png")) {
-        std::cout << "Error al cargar la textura del circuito" << std::endl;
+    // La ruta se resuelve contra las races de bsqueda del ResourceManager.
+    // La carga es asncrona: la pista muestra un placeholder hasta que la imagen se sube a la GPU.
+    texture = m_resources.getTextureAsync("Circuit.png");
+    if (!texture.isValid()) {
+        LOG_ERROR("BaseApp", "initialize", "no se pudo cargar la textura del circuito");
         return false;
     }
 
-    // Crear y configurar el Track (pista).
-    Track = EngineUtilities::MakeShared<Actor>("Track");
+    if (!createActors()) {
+        return false;
+    }
+
+    // Texturizar el Track (pista).
     if (!Track.isNull()) {
-        auto trackTransform = Track->getComponent<Transform>();
-        Track->getComponent<ShapeFactory>()->createShape(ShapeType::RECTANGLE);
-        trackTransform->setPosition(sf::Vector2f(0.0f, 0.0f));
-        trackTransform->setRotation(0.0f);
-        trackTransform->setScale(sf::Vector2f(11.0f, 12.0f));
-        Track->getComponent<ShapeFactory>()->getShape()->setTexture(&texture);
+        Track->getComponent<ShapeFactory>()->setTexture(texture.get());
+
+        // La pista nunca se mueve: se hornea una vez en un vertex buffer esttico.
+        m_staticGeometry.add(Track);
+
+        // Cuando llegue la textura real, reajustar el textureRect a su tamao y volver a hornear.
+        m_resources.whenReady(texture, [this](sf::Texture& loaded) {
+            Track->getComponent<ShapeFactory>()->setTexture(&loaded, true);
+            m_staticGeometry.invalidate();
+            });
     }
 
     // Funcin para cargar y asignar texturas a personajes.
-    auto loadCharacter = [this](sf::Texture& texture, const std::string& path, const std::string& name) {
-        if (!texture.loadFromFile(path)) {
-            std::cout << "Error al cargar la textura de " << name << std::endl;
+    // Si varios personajes comparten archivo, la cach devuelve la misma textura.
+    auto loadCharacter = [this](TextureHandle& texture, const std::string& path, const std::string& name) {
+        texture = m_resources.getTextureAsync(path);
+        if (!texture.isValid()) {
+            LOG_ERROR("BaseApp", "initialize", "no se pudo cargar la textura de {}", name);
             return false;
         }
         return true;
         };
 
     // Personaje y su ruta de textura.
-    std::vector<std::pair<sf::Texture*, std::string>> characters = {
+    std::vector<std::pair<TextureHandle*, std::string>> characters = {
         {&Mario, "tile000.png"},
     };
 
     // Cargar texturas de los personajes.
     for (const auto& [texture, path] : characters) {
-        if (!loadCharacter(*texture, "C:/Users/chalu/OneDrive/Documentos/GitHub/SFML_Soulpher/bin/MarioKart sprite-png/" + path, path)) {
+        if (!loadCharacter(*texture, path, path)) {
             return false;
         }
     }
 
-    // Crear el actor Circle (ejemplo con Mario).
+    // Texturizar el actor Circle (ejemplo con Mario).
+    if (!Circle.isNull()) {
+        Circle->getComponent<ShapeFactory>()->setTexture(Mario.get());
+
+        m_resources.whenReady(Mario, [this](sf::Texture& loaded) {
+            Circle->getComponent<ShapeFactory>()->setTexture(&loaded, true);
+            m_swarm.setTexture(&loaded, true);
+            });
+    }
+
+    // Escena de estrs (--stress <n>).
+    if (m_stressCount > 0) {
+        m_swarm.spawn(m_stressCount, getSwarmRoute());
+        m_swarm.setTexture(Mario.get());
+    }
+
+    // Sin estado anterior, el primer frame interpolara desde el origen.
+    if (!Circle.isNull()) Circle->getComponent<Transform>()->savePreviousState();
+
+    return true;
+}
+
+/*
+   Crea el Track (pista) y el Circle con su forma y transformacin inicial.
+   No toca la GPU: las formas se texturizan despus, solo si hay ventana.
+*/
+bool BaseApp::createActors() {
+    // Lnea de carrera: los karts de la escena de estrs siguen un punto cada SWARM_ROUTE_SPACING unidades.
+    if (!m_racingLine.build(waypoints)) {
+        return false;
+    }
+    m_racingLineVertices.clear();
+    for (const sf::Vector2f& point : m_racingLine.getSamples()) {
+        m_racingLineVertices.append(sf::Vertex(point, sf::Color(255, 220, 0, 200)));
+    }
+    m_racingLineVertices.append(m_racingLineVertices[0]);
+
+    // Flow field de la escena de estrs (--flowfield). Sin l, los karts siguen la lnea de carrera.
+    if (!m_flowFieldPath.empty()) {
+        if (m_flowField.load(m_flowFieldPath)) {
+            m_swarm.setFlowField(&m_flowField);
+            m_pathFinder.build(m_flowField.getGrid());
+        }
+        else {
+            LOG_WARN("BaseApp", "createActors", "no se pudo cargar el flow field [{}]; se usan los waypoints", m_flowFieldPath);
+        }
+    }
+
+    Track = EngineUtilities::MakeShared<Actor>("Track");
+    if (!Track.isNull()) {
+        auto trackTransform = Track->getComponent<Transform>();
+        Track->getComponent<ShapeFactory>()->createShape(ShapeType::RECTANGLE);
+        trackTransform->setPosition(sf::Vector2f(0.0f, 0.0f));
+        trackTransform->setRotation(0.0f);
+        trackTransform->setScale(sf::Vector2f(11.0f, 12.0f));
+        Track->setStatic(true);
+    }
+
     Circle = EngineUtilities::MakeShared<Actor>("Circle");
     if (!Circle.isNull()) {
         Circle->getComponent<ShapeFactory>()->createShape(ShapeType::CIRCLE);
@@ -78,84 +646,231 @@ bool BaseApp::initialize() {
         circleTransform->setPosition(sf::Vector2f(720.0f, 350.0f)); // 720, 350 Para iniciar en la lnea de salida.
         circleTransform->setRotation(0.0f);
         circleTransform->setScale(sf::Vector2f(1.0f, 1.0f));
-        Circle->getComponent<ShapeFactory>()->getShape()->setTexture(&Mario);
     }
+    m_circleTransform = Circle.isNull() ? nullptr : Circle->getComponent<Transform>().get();
+    m_triangleTransform = Triangle.isNull() ? nullptr : Triangle->getComponent<Transform>().get();
 
-    return true;
+    return !Track.isNull() && !Circle.isNull();
 }
 
 /* 
-   Actualiza la lgica del juego cada frame.
-   Actualizacin de los actores, posicin del ratn y movimiento del crculo.
+   Actualiza lo que depende del frame y no de la simulacin: ImGui y la carga de recursos.
 */
 void BaseApp::update() {
+    PROFILE_SCOPE("BaseApp::update");
     m_window->update();
 
-    sf::Vector2i mousePosition = sf::Mouse::getPosition(*m_window->getWindow());
-    sf::Vector2f mousePosF(static_cast<float>(mousePosition.x), static_cast<float>(mousePosition.y));
+    // F3: superposicin de rendimiento. F4: lnea de carrera. F9: empezar o detener una traza del profiler.
+    for (const sf::Event& event : m_window->getFrameEvents()) {
+        if (event.type != sf::Event::KeyPressed) {
+            continue;
+        }
+        if (event.key.code == sf::Keyboard::F3) {
+            m_hud.toggle();
+            m_lastAllocations = AllocationTracker::getSnapshot();
+        }
+        if (event.key.code == sf::Keyboard::F4) {
+            m_showRacingLine = !m_showRacingLine;
+        }
+        if (event.key.code == sf::Keyboard::F9) {
+            Profiler::getInstance().toggleTrace();
+        }
+    }
 
-    if (!Track.isNull()) Track->update(m_window->deltaTime.asSeconds());
-    if (!Triangle.isNull()) Triangle->update(m_window->deltaTime.asSeconds());
+    // Entregar los caminos que terminaron de buscarse y mandar a los hilos los pedidos en este frame.
+    m_pathFinder.update();
+    rebuildPathVertices();
 
-    if (!Circle.isNull()) {
-        Circle->update(m_window->deltaTime.asSeconds());
+    // Recargar las texturas modificadas en disco y subir a la GPU las que terminaron de
+    // decodificarse, con un presupuesto de 2 ms por frame.
+    m_resources.update(sf::milliseconds(2));
+}
+
+/*
+   Avanza la simulacin un tick de duracin fija.
+   Actualizacin de los actores, posicin del ratn y movimiento del crculo.
+   deltaTime = duracin del tick en segundos (siempre la misma).
+*/
+void BaseApp::fixedUpdate(float deltaTime) {
+    PROFILE_SCOPE("BaseApp::fixedUpdate");
+    // Guardar el estado anterior para interpolar entre este tick y el siguiente.
+    // Con dos hilos esto corre en la simulacin: solo punteros crudos, nunca copias de TSharedPointer.
+    if (m_circleTransform != nullptr) m_circleTransform->savePreviousState();
+    if (m_triangleTransform != nullptr) m_triangleTransform->savePreviousState();
+
+    // El ratn lo lee el hilo que posee la ventana; aqu solo se usa la ltima posicin recibida.
+    const sf::Vector2f mousePosF = m_mousePosition;
 
-        sf::Vector2f currentPosition = Circle->getComponent<Transform>()->getPosition();
+    // La pista es esttica y no se actualiza. Las formas de los actores dinmicos se colocan
+    // al dibujar (interpolacin), as que la simulacin solo modifica sus Transform.
+    if (m_circleTransform != nullptr) {
+        sf::Vector2f currentPosition = m_circleTransform->getPosition();
         float mouseDistance = std::sqrt(
             std::pow(mousePosF.x - currentPosition.x, 2) + std::pow(mousePosF.y - currentPosition.y, 2)
         );
 
         if (mouseDistance < 100.0f) {
             isFollowingMouse = true;
-            sf::Vector2f newPos = currentPosition + (mousePosF - currentPosition) * m_window->deltaTime.asSeconds();
-            Circle->getComponent<Transform>()->setPosition(newPos);
+            sf::Vector2f newPos = currentPosition + (mousePosF - currentPosition) * deltaTime;
+            m_circleTransform->setPosition(newPos);
         }
         else {
             isFollowingMouse = false;
-            updateMovement(m_window->deltaTime.asSeconds(), Circle);
+            updateMovement(deltaTime, *m_circleTransform);
         }
     }
+
+    m_swarm.update(deltaTime);
 }
 
 
    // Renderiza los actores y la interfaz grfica de ImGui.
+   // alpha = fraccin del siguiente tick ya transcurrida, para interpolar los actores dinmicos.
  
-void BaseApp::render() {
+void BaseApp::render(float alpha) {
+    PROFILE_SCOPE("BaseApp::render");
+    const bool measure = m_hud.isVisible();
+    const auto renderStart = measure ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
     m_window->clear();
 
-    if (!Track.isNull()) Track->render(*m_window);
+    if (++m_frameNumber == m_captureFrame) {
+        m_window->captureFrame(m_capturePath);
+    }
+
+    if (m_threaded) {
+        applySnapshot();
+    }
+    else {
+        if (!Circle.isNull()) Circle->interpolate(alpha);
+        if (!Triangle.isNull()) Triangle->interpolate(alpha);
+    }
+
+    // Pasada esttica: la pista ya horneada. Despus, la pasada dinmica.
+    m_window->beginPass("Track");
+    m_staticGeometry.draw(*m_window);
+
+    m_window->beginPass("Actors");
     if (!Circle.isNull()) Circle->render(*m_window);
     if (!Triangle.isNull()) Triangle->render(*m_window);
+
+    if (m_showRacingLine) {
+        m_window->beginPass("RacingLine");
+        m_window->setRenderLayer(LAYER_OVERLAY);
+        m_window->draw(m_racingLineVertices);
+        m_window->setRenderLayer(LAYER_WORLD);
+    }
+    if (m_pathVertices.getVertexCount() > 0) {
+        m_window->beginPass("Paths");
+        m_window->setRenderLayer(LAYER_OVERLAY);
+        m_window->draw(m_pathVertices);
+        m_window->setRenderLayer(LAYER_WORLD);
+    }
+    m_window->endPass();
+
+    if (m_swarm.getCount() > 0) {
+        m_swarmCommands.clear();
+        m_swarmCommands.setPass(m_window->getPassId("Swarm"));
+        m_swarm.prepareRender(m_swarmCommands, m_window->getPixelsPerUnit(), alpha);
+        m_window->submit(m_swarmCommands);
+        drawStressPanel();
+    }
     
     //Texto en el recuadro de interfaz de IMGUI
 
     ImGui::Begin("MARIOKART MAP");
     ImGui::Text("PLAYER 1 --> MARIO");
+    if (m_circleTransform != nullptr && m_racingLine.isValid()) {
+        // Con dos hilos, el Transform es de la simulacin: el progreso llega en el estado publicado.
+        const float progress = m_threaded ? m_snapshots.getReadBuffer().circleProgress
+            : m_racingLine.project(m_circleTransform->getPosition());
+        ImGui::Text("Progreso: %.0f / %.0f (%.0f %%)", progress, m_racingLine.getLength(),
+            100.0f * progress / m_racingLine.getLength());
+    }
+    ImGui::Text("Simulacion: %.0f Hz, %d ticks este frame%s", m_tickRate, m_ticksLastFrame,
+        m_threaded ? " (hilo propio)" : "");
+    ImGui::Text("Draw calls: %zu", m_window->getLastDrawCalls());
+    for (const RenderPassStats& pass : m_window->getRenderStats().getPasses()) {
+        if (pass.counters.drawCalls > 0) {
+            ImGui::Text("  %s: %zu draws, %zu vertices, %zu texturas, %zu estados", pass.name.c_str(),
+                pass.counters.drawCalls, pass.counters.vertices, pass.counters.textureBinds, pass.counters.stateChanges);
+        }
+    }
+    if (m_window->getDrawCallBudget() > 0) {
+        ImGui::Text("Frames sobre el presupuesto (%zu): %zu", m_window->getDrawCallBudget(),
+            m_window->getOverBudgetFrameCount());
+    }
     ImGui::End();
 
+    // Estadsticas de la cach de recursos.
+    m_resources.drawStats();
+
+#ifdef SOULPHER_PROFILING
+    Profiler::getInstance().drawPanel();
+#endif
+
+    if (measure) {
+        drawPerformanceHud();
+    }
+
     m_window->render();
+    if (measure) {
+        m_renderMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - renderStart).count();
+    }
     m_window->display();
 }
 
+/*
+   Las llamadas de dibujo, los vrtices y el tiempo de render son del frame anterior
+   (el actual todava no se enva); las reservas cubren todo lo ocurrido desde el frame anterior.
+*/
+void BaseApp::drawPerformanceHud() {
+    const AllocationTracker::Snapshot allocations = AllocationTracker::getSnapshot();
+
+    FrameSample sample;
+    sample.frameMs = m_window->deltaTime.asSeconds() * 1000.0f;
+    sample.updateMs = m_updateMs;
+    sample.renderMs = m_renderMs;
+    const RenderCounters& counters = m_window->getRenderStats().getTotal();
+    sample.drawCalls = counters.drawCalls;
+    sample.vertices = counters.vertices;
+    sample.textureBinds = counters.textureBinds;
+    sample.stateChanges = counters.stateChanges;
+    sample.overBudget = m_window->isOverBudget();
+    sample.entities = m_swarm.getCount();
+    for (const auto* actor : { &Track, &Circle, &Triangle, &MarioHead }) {
+        if (!actor->isNull()) ++sample.entities;
+    }
+    sample.allocations = (allocations - m_lastAllocations).allocations;
+    sample.textureBytes = m_resources.getStats().textureBytes;
+    m_lastAllocations = allocations;
+
+    m_hud.addSample(sample);
+    m_hud.draw();
+}
+
 /*
    Cleanup para liberar los recursos utilizados por la aplicacin.
    Destruir la ventana y libera la memoria asignada.
 
 */
 void BaseApp::cleanup() {
+    if (m_inputRecorder.isRecording()) {
+        LOG_INFO("BaseApp", "cleanup", "{} ticks grabados en [{}]", m_inputRecorder.getTick(), m_recordPath);
+    }
+    m_inputRecorder.stop();
+    Profiler::getInstance().stopTrace();
+    m_staticGeometry.clear();  // Liberar los vertex buffers mientras el contexto de OpenGL sigue activo.
     m_window->destroy();
     delete m_window;
+    Logger::getInstance().flush();
 }
 
 /*
    Controla el movimiento del crculo entre puntos predefinidos.
    Si el crculo no est siguiendo al ratn, se mueve automticamente entre los  waypoints.
 */
-void BaseApp::updateMovement(float deltaTime, EngineUtilities::TSharedPointer<Actor> circle) {
-    if (circle.isNull()) return;
-
-    auto transform = circle->getComponent<Transform>();
-    sf::Vector2f currentPos = transform->getPosition();
+void BaseApp::updateMovement(float deltaTime, Transform& transform) {
+    sf::Vector2f currentPos = transform.getPosition();
     sf::Vector2f targetPos = waypoints[currentWaypoint];
 
     sf::Vector2f direction = targetPos - currentPos;
@@ -170,6 +885,6 @@ void BaseApp::updateMovement(float deltaTime, EngineUtilities::TSharedPointer<Ac
         currentWaypoint = (currentWaypoint + 1) % waypoints.size();
     }
     else {
-        transform->setPosition(newPos);
+        transform.setPosition(newPos);
     }
 }
\ No newline at end of file
@@ -3,6 +3,47 @@
 #include "Window.h"         // Maneja la ventana principal donde se renderiza el contenido.
 #include "ShapeFactory.h"   // Provee utilidades para crear formas geomtricas.
 #include "Actor.h"          // Define los actores que se dibujarn en pantalla.
+#include "ResourceManager.h" // Cach de texturas, fuentes y sonidos.
+#include "StaticGeometry.h" // Geometra horneada de los actores que no se mueven.
+#include "TripleBuffer.h"   // Intercambio sin candados entre el hilo de simulacin y el de render.
+#include "InputRecorder.h"  // Grabacin y reproduccin de la entrada por tick.
+#include "Profiler.h"       // mbitos medidos (PROFILE_SCOPE) y panel del profiler.
+#include "KartSwarm.h"      // Escena de estrs con muchos karts.
+#include "PerformanceHud.h" // Superposicin de rendimiento (F3).
+#include "AllocationTracker.h"
+#include "RacingLine.h"     // Lnea de carrera suave por los waypoints.
+#include "FlowField.h"      // Direcciones horneadas por checkpoint para la escena de estrs.
+#include "PathFinder.h"     // Bsqueda de caminos HPA* asncrona.
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <random>
+
+/*
+  Estructura ActorSnapshot.
+  - Transformacin de un actor dinmico en los dos ltimos ticks, tal como la ve el hilo de render.
+*/
+struct ActorSnapshot
+{
+    sf::Vector2f previousPosition;
+    sf::Vector2f position;
+    float previousRotation = 0.0f;
+    float rotation = 0.0f;
+    sf::Vector2f previousScale;
+    sf::Vector2f scale;
+};
+
+/*
+  Estructura SimulationSnapshot.
+  - Estado completo que publica la simulacin al terminar cada tick.
+*/
+struct SimulationSnapshot
+{
+    std::vector<ActorSnapshot> actors;              // En el mismo orden que los actores dinmicos.
+    uint64_t tick = 0;                              // Nmero de tick (0 = todava no hay estado).
+    float circleProgress = 0.0f;                    // Progreso del kart principal en la lnea de carrera.
+    std::chrono::steady_clock::time_point time;     // Momento en que se public.
+};
 
 /*
   Clase principal que controla el flujo de la aplicacin.
@@ -44,11 +85,68 @@ public:
     */
     void update();
 
+    /*
+       Avanza la simulacin un tick de duracin fija (movimiento, ratn y actores).
+       deltaTime = duracin del tick, igual en todos los ticks para que la simulacin sea reproducible.
+    */
+    void fixedUpdate(float deltaTime);
+
+    /*
+       Cambia la frecuencia de la simulacin en ticks por segundo (por defecto 60).
+       El dibujo no depende de ella: entre ticks los actores se interpolan.
+    */
+    void setTickRate(float ticksPerSecond);
+
+    /*
+       Activa el modo de dos hilos (antes de run()).
+       La simulacin corre en su propio hilo y publica un SimulationSnapshot por tick en un TripleBuffer;
+       el hilo principal es el de render: posee la ventana, ImGui y las texturas, y dibuja el ltimo
+       estado publicado. Ninguno de los dos espera al otro.
+       Regla de acceso: la simulacin solo toca los Transform; el render solo toca los ShapeFactory.
+    */
+    void setThreaded(bool threaded);
+
+    /*
+       Guarda los comandos de dibujo del frame nmero frame en path (.sframe),
+       para reproducirlos despus con --replay-frame.
+    */
+    void setFrameCapture(const std::string& path, int frame);
+
+    /*
+       Activa el modo sin ventana (antes de run()).
+       run() crea los actores sin ventana, contexto de OpenGL, ImGui ni texturas, avanza ticks
+       ticks de simulacin lo ms rpido posible y reporta los ticks por segundo.
+       Sirve para correr la lgica del juego en servidores sin pantalla y en benchmarks de CI.
+       ticks <= 0 desactiva el modo.
+    */
+    void setHeadless(int ticks);
+
+    /*
+       Graba la entrada de cada tick (ratn, teclas y eventos) en path (.sinput).
+    */
+    void setInputRecording(const std::string& path);
+
+    /*
+       Reproduce una grabacin de entrada en lugar de la entrada en vivo, con la frecuencia
+       de simulacin con la que se grab. Al terminar la grabacin se cierra la ventana.
+       fastForward = simular MAX_TICKS_PER_FRAME ticks por frame sin esperar al reloj, para usar
+       la grabacin como carga de trabajo repetible.
+       La grabacin y la reproduccin usan el bucle de un solo hilo.
+    */
+    void setInputReplay(const std::string& path, bool fastForward);
+
+    /*
+       Graba una traza del profiler desde el inicio y la guarda en path (Chrome trace-event JSON)
+       al cerrar la aplicacin. Durante la ejecucin, F9 detiene y reanuda la grabacin.
+       Funciona en todas las configuraciones: en Release el profiler solo mide mientras graba.
+    */
+    void setTrace(const std::string& path);
+
     /*
        Renderiza los actores en la ventana.
        Dibuja los actores en la pantalla en cada frame despus de la actualizacin.
     */
-    void render();
+    void render(float alpha = 1.0f);
 
     /*
        Libera los recursos utilizados por la aplicacin.
@@ -60,12 +158,107 @@ public:
        Actualiza el movimiento del crculo entre waypoints.
        Si el ratn no est cerca, el crculo regresa a la ruta entre waypoints.
        deltaTime = Tiempo entre frames utilizado para calcular el movimiento.
-          circle = Puntero inteligente al actor del crculo.
+       transform = Transform del crculo.
     */
-    void updateMovement(float deltaTime, EngineUtilities::TSharedPointer<Actor> circle);
+    void updateMovement(float deltaTime, Transform& transform);
+
+    /* 
+       Lista de waypoints.
+       Ruta desde la lnea de salida
+       Cada waypoint es un Vector 2d que representa una posicin en la ventana.
+       La usan tambin las herramientas que simulan karts sin el juego (--stress, soulpher_bench);
+       se define aqu para que esas herramientas no tengan que enlazar BaseApp.cpp.
+    */
+    static std::vector<sf::Vector2f> getTrackWaypoints() {
+        return {
+            {720.0f, 350.0f}, {720.0f, 260.0f}, {125.0f, 50.0f},
+            {70.0f, 120.0f}, {70.0f, 450.0f}, {400.0f, 350.0f},
+            {550.0f, 500.0f}, {650.0f, 550.0f}, {720.0f, 450.0f}
+        };
+    }
+
+    /*
+       Rectngulo del mundo que cubre la pista (el actor Track: rectngulo de 100x50 con escala 11x12).
+       Circuit.png se estira sobre l, as que tambin traduce pxeles de la imagen a unidades del mundo.
+    */
+    static sf::FloatRect getTrackBounds() {
+        return sf::FloatRect(0.0f, 0.0f, 1100.0f, 600.0f);
+    }
+
+    /*
+       Carga un flow field horneado con --bake-flowfield (.sflow). Si es vlido, los karts de la escena
+       de estrs se conducen con l y van de checkpoint en checkpoint; si no, siguen la lnea de carrera.
+       Su rejilla tambin es la de la bsqueda de caminos (HPA*) del panel STRESS.
+    */
+    void setFlowField(const std::string& path);
+
+    /*
+       Agrega una escena de estrs con count karts que siguen la lnea de carrera (antes de run()).
+       Un panel "STRESS" muestra sus tiempos y reservas, y permite duplicar o reducir N.
+       La escena usa el bucle de un solo hilo.
+    */
+    void setStress(size_t count);
+
+    // Muestra la superposicin de rendimiento desde el inicio (se alterna con F3).
+    void setHudVisible(bool visible);
+
+    // Presupuesto de llamadas de dibujo por frame (0 = sin lmite). Ver Window::setDrawCallBudget.
+    void setDrawCallBudget(size_t budget);
+
+private:
+    /*
+       Crea los actores y les da su transformacin inicial, sin cargar texturas.
+       La comparten el modo normal y el modo sin ventana.
+    */
+    bool createActors();
+
+    // Bucle del modo sin ventana: solo simulacin y actualizacin de actores.
+    int runHeadless();
+
+    // Abre la grabacin o la reproduccin de entrada pedida. false si el archivo no es vlido.
+    bool startInput();
+
+    // Agrega a la entrada en vivo el ratn y los eventos del frame.
+    void sampleInput();
+
+    /*
+       Prepara la entrada del siguiente tick: la siguiente de la grabacin, o la entrada en vivo
+       (que se graba si hace falta). Devuelve false cuando termin la reproduccin.
+    */
+    bool readTickInput();
+
+    // Bucle del modo de dos hilos (hilo de render).
+    int runThreaded();
+
+    // Bucle del hilo de simulacin: un fixedUpdate por tick, sin candados.
+    void simulationLoop();
+
+    // (Simulacin) Copia los Transform de los actores dinmicos en el TripleBuffer y lo publica.
+    void publishSnapshot(uint64_t tick);
+
+    // (Render) Toma el ltimo estado publicado y coloca las formas interpolando desde su tick.
+    void applySnapshot();
+
+    // Ruta de la escena de estrs: los checkpoints del flow field o la lnea de carrera remuestreada.
+    std::vector<sf::Vector2f> getSwarmRoute() const;
+
+    // Pide count caminos desde karts al azar hasta celdas de la pista al azar (como objetos que recoger).
+    void requestTestPaths(size_t count);
+
+    // Rehace m_pathVertices si llegaron caminos nuevos desde la ltima llamada.
+    void rebuildPathVertices();
+
+    // (Render) Panel "STRESS" con las mediciones de la escena de estrs.
+    void drawStressPanel();
+
+    // (Render) Rene las mediciones del frame y dibuja la superposicin de rendimiento.
+    void drawPerformanceHud();
+
+    // (Render) Posicin del ratn relativa a la ventana.
+    sf::Vector2i readMousePosition();
 
 private:
-    Window* m_window;  // Puntero a la ventana principal de la aplicacin.
+    Window* m_window = nullptr;  // Puntero a la ventana principal de la aplicacin.
 
     EngineUtilities::TSharedPointer<Actor> Triangle;  // Actor que representa el tringulo.
     EngineUtilities::TSharedPointer<Actor> Circle;    // Actor que representa el crculo.
@@ -74,22 +267,88 @@ private:
     // Actores para las cabezas de los personajes.
     EngineUtilities::TSharedPointer<Actor> MarioHead;
 
+    // Recursos compartidos (texturas, fuentes y sonidos).
+    ResourceManager m_resources;
+
+    // Pasada de geometra esttica (la pista).
+    StaticGeometry m_staticGeometry;
+
     // Texturas necesarias.
-    sf::Texture texture;    // Textura para la pista.
-    sf::Texture Mario;      // Textura para Mario.
+    TextureHandle texture;  // Textura para la pista.
+    TextureHandle Mario;    // Textura para Mario.
+
+
+    // Paso fijo de la simulacin.
+    static constexpr float MAX_FRAME_TIME = 0.25f;  // Tiempo mximo de un frame que se simula (segundos).
+    static constexpr int MAX_TICKS_PER_FRAME = 8;   // Ticks mximos por frame antes de descartar el atraso.
+    static constexpr float SWARM_ROUTE_SPACING = 24.0f; // Separacin de los waypoints densos de la escena de estrs.
+    float m_tickRate = 60.0f;                       // Ticks de simulacin por segundo.
+    int m_ticksLastFrame = 0;                       // Ticks ejecutados en el ltimo frame.
+    sf::Vector2f m_mousePosition;                   // Ratn que ve la simulacin en el tick actual.
+
+    // Entrada grabada o reproducida.
+    InputRecorder m_inputRecorder;
+    InputState m_liveInput;                         // Entrada de la ventana pendiente de entregar.
+    InputState m_tickInput;                         // Entrada del tick actual.
+    std::string m_recordPath;
+    std::string m_replayPath;
+    bool m_fastForward = false;
+
+    std::string m_tracePath;                        // Traza pedida por lnea de comandos.
+
+    // Escena de estrs.
+    KartSwarm m_swarm;
+    RenderCommandBuffer m_swarmCommands;
+    bool m_rankSwarm = false;                       // El panel muestra los karts ms adelantados.
+    std::vector<KartSwarm::Ranked> m_swarmLeaders;
+
+    // Lnea de carrera por los waypoints. Los karts de la escena de estrs siguen sus puntos
+    // remuestreados, y el panel muestra el progreso del kart principal. F4 la dibuja.
+    RacingLine m_racingLine;
+    sf::VertexArray m_racingLineVertices{ sf::LineStrip };
+    bool m_showRacingLine = false;
+    FlowField m_flowField;
+    std::string m_flowFieldPath;
 
+    // Bsqueda de caminos sobre la rejilla del flow field. Los resultados llegan en update() y se
+    // dibujan los ltimos MAX_DRAWN_PATHS.
+    static constexpr size_t MAX_DRAWN_PATHS = 32;
+    PathFinder m_pathFinder;
+    std::deque<std::vector<sf::Vector2f>> m_paths;
+    sf::VertexArray m_pathVertices{ sf::Lines };
+    bool m_pathsDirty = false;                      // m_paths cambi y hay que rehacer m_pathVertices.
+    std::mt19937 m_pathRandom{ 99 };
+    size_t m_stressCount = 0;
+
+    // Superposicin de rendimiento. Los tiempos solo se toman mientras est visible.
+    PerformanceHud m_hud;
+    float m_updateMs = 0.0f;                        // Eventos, update y ticks del ltimo frame.
+    float m_renderMs = 0.0f;                        // render() del frame anterior, sin display().
+    AllocationTracker::Snapshot m_lastAllocations;
+
+    size_t m_drawCallBudget = 0;
+
+    // Captura de un frame grabado.
+    std::string m_capturePath;
+    int m_captureFrame = -1;
+    int m_frameNumber = 0;
+
+    // Modo sin ventana.
+    int m_headlessTicks = 0;
+
+    // Modo de dos hilos.
+    bool m_threaded = false;
+    std::atomic<bool> m_simulationRunning{ false };
+    std::atomic<uint64_t> m_mouseState{ 0 };        // Ratn del hilo de render (x, y empaquetados).
+    TripleBuffer<SimulationSnapshot> m_snapshots;   // Simulacin -> render.
+    std::vector<Transform*> m_simulationTransforms; // Solo los usa la simulacin.
+    Transform* m_circleTransform = nullptr;         // Tomados en createActors(): fixedUpdate no copia
+    Transform* m_triangleTransform = nullptr;       // TSharedPointer, as que puede correr en su hilo.
+    std::vector<ShapeFactory*> m_renderShapes;      // Solo los usa el render (mismo orden).
 
     int currentWaypoint = 0;        // ndice del waypoint actual en la trayectoria del crculo.
     bool isFollowingMouse = false;  //Indica si el crculo est siguiendo al ratn.
 
-    /* 
-       Lista de waypoints.
-       Ruta desde la lnea de salida
-       Cada waypoint es un Vector 2d que representa una posicin en la ventana.
-    */
-    std::vector<sf::Vector2f> waypoints = {
-        {720.0f, 350.0f}, {720.0f, 260.0f}, {125.0f, 50.0f},
-        {70.0f, 120.0f}, {70.0f, 450.0f}, {400.0f, 350.0f},
-        {550.0f, 500.0f}, {650.0f, 550.0f}, {720.0f, 450.0f}
-    };
+    // Lista de waypoints (ver getTrackWaypoints).
+    std::vector<sf::Vector2f> waypoints = getTrackWaypoints();
 };
\ No newline at end of file
@@ -0,0 +1,18 @@
+#include "Benchmarks.h"
+#include "MicroBenchmark.h"
+
+/*
+  - Funcin main de soulpher_bench.
+    Ejecutable de CMakeLists.txt con los microbenchmarks del ncleo que no necesitan SFML
+    (Benchmarks::corePortable), para medir en Linux y en CI sin ventana ni bibliotecas de SFML.
+    No forma parte del proyecto de Visual Studio: ah los mismos casos corren con --bench-core.
+
+  - Opciones: [--json <salida.json>] [--baseline <anterior.json>] [--threshold <%>] [--sample-ms <ms>].
+*/
+int main(int argc, char* argv[])
+{
+    CommandLine commandLine(argc, argv);
+    MicroBenchmark bench(commandLine.getFloat("--sample-ms", 10.0f));
+    Benchmarks::corePortable(bench);
+    return Benchmarks::coreReport(bench, commandLine);
+}
@@ -0,0 +1,458 @@
+#include "Benchmarks.h"
+#include "AssetArchive.h"
+#include "ShapeFactory.h"
+#include "RenderCommandBuffer.h"
+#include "MicroBenchmark.h"
+#include "Actor.h"
+#include "BaseApp.h"
+#include "KartSwarm.h"
+#include "WaypointFollower.h"
+#include "AllocationTracker.h"
+#include "PathFinder.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <random>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    using BenchClock = std::chrono::steady_clock;
+
+    // Milisegundos transcurridos desde start.
+    double elapsedMs(BenchClock::time_point start) {
+        return std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+    }
+
+    // Mediana de una lista de tiempos.
+    double median(std::vector<double> values) {
+        if (values.empty()) {
+            return 0.0;
+        }
+        std::sort(values.begin(), values.end());
+        return values[values.size() / 2];
+    }
+
+    /*
+       Saca un archivo de la cach de pginas del sistema para simular un arranque en fro.
+       Solo es efectivo en Linux; en otras plataformas la medicin es con cach caliente.
+    */
+    void evictFromPageCache(const std::string& path) {
+#ifdef __linux__
+        const int fd = open(path.c_str(), O_RDONLY);
+        if (fd >= 0) {
+            fdatasync(fd);
+            posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+            close(fd);
+        }
+#else
+        (void)path;
+#endif
+    }
+
+    // Indica si la extensin corresponde a una imagen que SFML puede decodificar.
+    bool isImage(const std::filesystem::path& path) {
+        std::string extension = path.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+            [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return extension == ".png" || extension == ".jpg" || extension == ".jpeg"
+            || extension == ".bmp" || extension == ".tga";
+    }
+}
+
+/*
+   Benchmark de carga: archivos sueltos contra archivo empaquetado.
+*/
+int Benchmarks::archiveLoad(const CommandLine& commandLine) {
+    namespace fs = std::filesystem;
+    const std::string directory = commandLine.getString("--dir", "bin/MarioKart sprite-png");
+    const std::string archivePath = commandLine.getString("--bench-archive", "assets.spak");
+    const int runs = std::max(1, commandLine.getInt("--runs", 5));
+
+    // Imgenes a cargar, con su ruta relativa (la clave dentro del .spak).
+    std::error_code ec;
+    std::vector<std::pair<std::string, std::string>> images;
+    for (const auto& item : fs::recursive_directory_iterator(directory, ec)) {
+        if (item.is_regular_file() && isImage(item.path())) {
+            images.emplace_back(fs::relative(item.path(), directory, ec).generic_string(), item.path().string());
+        }
+    }
+    if (images.empty()) {
+        std::cerr << "Benchmarks::archiveLoad : no hay imagenes en [" << directory << "]\n";
+        return 1;
+    }
+
+    if (!fs::exists(archivePath, ec) && !AssetArchive::build(directory, archivePath, false)) {
+        return 1;
+    }
+
+    std::vector<double> looseTimes;
+    std::vector<double> archiveTimes;
+
+    for (int run = 0; run < runs; ++run) {
+        // Archivos sueltos: una apertura, lectura y decodificacin por imagen.
+        for (const auto& image : images) {
+            evictFromPageCache(image.second);
+        }
+        auto start = BenchClock::now();
+        for (const auto& image : images) {
+            sf::Texture texture;
+            if (!texture.loadFromFile(image.second)) {
+                std::cerr << "Benchmarks::archiveLoad : error al cargar [" << image.second << "]\n";
+                return 1;
+            }
+        }
+        looseTimes.push_back(elapsedMs(start));
+
+        // Archivo empaquetado: una sola proyeccin y lectura directa desde memoria.
+        evictFromPageCache(archivePath);
+        start = BenchClock::now();
+        {
+            AssetArchive archive;
+            if (!archive.open(archivePath)) {
+                std::cerr << "Benchmarks::archiveLoad : no se pudo abrir [" << archivePath << "]\n";
+                return 1;
+            }
+            for (const auto& image : images) {
+                const ArchiveEntry* entry = archive.find(image.first);
+                const AssetArchive::Blob blob = entry ? archive.read(*entry) : AssetArchive::Blob();
+                sf::Texture texture;
+                if (!blob || !texture.loadFromMemory(blob.data, blob.size)) {
+                    std::cerr << "Benchmarks::archiveLoad : [" << image.first << "] no esta en el archivo\n";
+                    return 1;
+                }
+            }
+        }
+        archiveTimes.push_back(elapsedMs(start));
+    }
+
+    const double loose = median(looseTimes);
+    const double packed = median(archiveTimes);
+    std::cout << "archive_load: " << images.size() << " images, " << runs << " runs (median)\n"
+        << "  loose files : " << loose << " ms\n"
+        << "  archive     : " << packed << " ms\n"
+        << "  speedup     : " << (packed > 0.0 ? loose / packed : 0.0) << "x\n";
+#ifndef __linux__
+    std::cout << "  (warm page cache: cold-start eviction is only available on Linux)\n";
+#endif
+    return 0;
+}
+
+/*
+   Benchmark de formas: sf::Shape en el heap contra ShapeFactory con geometra compartida.
+   La posicin de cada kart cambia en cada frame para que ningn camino pueda reutilizar resultados.
+*/
+int Benchmarks::shapes(const CommandLine& commandLine) {
+    const int count = std::max(1, commandLine.getInt("--count", 10000));
+    const int frames = std::max(1, commandLine.getInt("--frames", 100));
+
+    auto positionOf = [](int kart, int frame) {
+        return sf::Vector2f(static_cast<float>((kart * 7 + frame) % 800), static_cast<float>((kart * 13 + frame) % 600));
+    };
+    float checksum = 0.0f;   // Evita que el compilador elimine los clculos.
+
+    // Camino anterior: un sf::CircleShape por kart. El constructor tesela los 30 puntos con getPoint virtual.
+    auto start = BenchClock::now();
+    std::vector<sf::Shape*> heapShapes;
+    heapShapes.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        heapShapes.push_back(new sf::CircleShape(15.0f));
+    }
+    const double heapCreate = elapsedMs(start);
+
+    start = BenchClock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        for (int i = 0; i < count; ++i) {
+            sf::Shape* shape = heapShapes[i];
+            shape->setPosition(positionOf(i, frame));
+            shape->setRotation(static_cast<float>(frame));
+            shape->setScale(1.0f, 1.0f);
+            checksum += shape->getGlobalBounds().left;
+        }
+    }
+    const double heapUpdate = elapsedMs(start) / frames;
+
+    // Volver a teselar (lo que haca cada setRadius o setPointCount).
+    start = BenchClock::now();
+    for (sf::Shape* shape : heapShapes) {
+        static_cast<sf::CircleShape*>(shape)->setPointCount(30);
+        checksum += shape->getLocalBounds().width;
+    }
+    const double heapRebuild = elapsedMs(start);
+
+    for (sf::Shape* shape : heapShapes) {
+        delete shape;
+    }
+
+    // Camino nuevo: descriptor por valor y geometra compartida.
+    start = BenchClock::now();
+    std::vector<ShapeFactory> factoryShapes(count);
+    for (ShapeFactory& shape : factoryShapes) {
+        shape.createShape(ShapeType::CIRCLE);
+    }
+    const double factoryCreate = elapsedMs(start);
+
+    start = BenchClock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        for (int i = 0; i < count; ++i) {
+            ShapeFactory& shape = factoryShapes[i];
+            shape.setPosition(positionOf(i, frame));
+            shape.setRotation(static_cast<float>(frame));
+            shape.setScale(sf::Vector2f(1.0f, 1.0f));
+            checksum += shape.getGlobalBounds().left;
+        }
+    }
+    const double factoryUpdate = elapsedMs(start) / frames;
+
+    start = BenchClock::now();
+    for (ShapeFactory& shape : factoryShapes) {
+        shape.createShape(CircleDescriptor{ 15.0f, 30 });
+        checksum += shape.getGeometry()->getLocalBounds().width;
+    }
+    const double factoryRebuild = elapsedMs(start);
+
+    // Composicin de vrtices por frame (lo que hace render antes de enviar a la GPU).
+    start = BenchClock::now();
+    std::vector<sf::Vertex> vertices;
+    for (const ShapeFactory& shape : factoryShapes) {
+        shape.buildVertices(vertices);
+        checksum += vertices[1].position.x;
+    }
+    const double factoryVertices = elapsedMs(start);
+
+    // Memoria: el sf::CircleShape guarda su relleno (puntos + 2) y su contorno (2 * (puntos + 1)) como sf::Vertex.
+    const size_t heapBytes = sizeof(sf::CircleShape) + (32 + 62) * sizeof(sf::Vertex);
+    const size_t factoryBytes = sizeof(ShapeInstance);
+
+    std::cout << "shapes: " << count << " karts, " << frames << " frames\n"
+        << "                      sf::Shape*    ShapeFactory\n"
+        << "  create (ms)       : " << heapCreate << "    " << factoryCreate << "\n"
+        << "  update/frame (ms) : " << heapUpdate << "    " << factoryUpdate << "\n"
+        << "  re-create (ms)    : " << heapRebuild << "    " << factoryRebuild << "\n"
+        << "  vertices/frame(ms): -    " << factoryVertices << "\n"
+        << "  bytes per kart    : ~" << heapBytes << "    " << factoryBytes << "\n"
+        << "  shared geometries : " << ShapeGeometry::getCachedCount() << "\n"
+        << "  (checksum " << checksum << ")\n";
+    return 0;
+}
+
+/*
+   Benchmark de envo de comandos: el mismo frame grabado se enva varias veces.
+   display() vaca la cola de OpenGL, as que el tiempo incluye el envo al driver.
+*/
+int Benchmarks::replayFrame(const CommandLine& commandLine) {
+    const std::string path = commandLine.getString("--replay-frame", "frame.sframe");
+    const int runs = std::max(1, commandLine.getInt("--runs", 200));
+
+    RenderCommandBuffer commands;
+    sf::Vector2u viewportSize;
+    if (!commands.load(path, viewportSize)) {
+        return 1;
+    }
+
+    sf::RenderTexture target;
+    if (!target.create(std::max(1u, viewportSize.x), std::max(1u, viewportSize.y))) {
+        std::cerr << "Benchmarks::replayFrame : no se pudo crear la textura de render\n";
+        return 1;
+    }
+
+    // Un envo previo para que el driver compile estados y suba los vrtices por primera vez.
+    // Ese envo tambin cuenta los cambios de textura y de estado del frame.
+    RenderStats stats;
+    target.clear();
+    commands.submit(target, &stats);
+    target.display();
+
+    std::vector<double> times;
+    times.reserve(runs);
+    for (int run = 0; run < runs; ++run) {
+        const auto start = BenchClock::now();
+        target.clear();
+        commands.submit(target);
+        target.display();
+        times.push_back(elapsedMs(start));
+    }
+
+    std::cout << "replay_frame: " << commands.getCommandCount() << " commands, " << commands.getVertexCount()
+        << " vertices, " << viewportSize.x << "x" << viewportSize.y << ", " << runs << " runs\n"
+        << "  draws  : " << stats.getTotal().drawCalls << " (" << stats.getTotal().textureBinds << " texture binds, "
+        << stats.getTotal().stateChanges << " state changes)\n"
+        << "  median : " << median(times) << " ms\n"
+        << "  best   : " << *std::min_element(times.begin(), times.end()) << " ms\n";
+    return 0;
+}
+
+namespace
+{
+    /*
+       Entidad equivalente a Entity con la biblioteca estndar: misma bsqueda lineal con
+       conversin dinmica, pero con std::shared_ptr (recuento atmico).
+    */
+    struct StdEntity
+    {
+        std::vector<std::shared_ptr<Component>> components;
+
+        template<typename T>
+        std::shared_ptr<T> getComponent() {
+            for (auto& component : components) {
+                std::shared_ptr<T> specific = std::dynamic_pointer_cast<T>(component);
+                if (specific) {
+                    return specific;
+                }
+            }
+            return std::shared_ptr<T>();
+        }
+    };
+}
+
+/*
+   Microbenchmarks del ncleo. Cada caso se mide en la variante "engine" y en su referencia
+   ("std" o "raw"); la tabla muestra cuntas veces ms lento (o rpido) es el motor.
+   Los casos que no necesitan SFML estn en CoreBenchmarks.cpp; aqu se agregan los del sistema
+   de componentes, que enlazan con SFML a travs de ShapeFactory.
+*/
+int Benchmarks::core(const CommandLine& commandLine) {
+    MicroBenchmark bench(commandLine.getFloat("--sample-ms", 10.0f));
+    corePortable(bench);
+
+    // Sistema de componentes.
+    {
+        Actor actor("Bench");
+        actor.getComponent<ShapeFactory>()->createShape(ShapeType::CIRCLE);
+        actor.getComponent<Transform>()->setPosition(sf::Vector2f(720.0f, 350.0f));
+
+        // Mismo orden de componentes que Actor: primero la forma, despus la transformacin.
+        StdEntity standard;
+        standard.components.push_back(std::make_shared<ShapeFactory>());
+        standard.components.push_back(std::make_shared<Transform>());
+
+        bench.run("entity.getComponent", "engine", [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; ++i) { auto transform = actor.getComponent<Transform>(); doNotOptimize(transform); }
+            });
+        bench.run("entity.getComponent", "std", [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; ++i) { auto transform = standard.getComponent<Transform>(); doNotOptimize(transform); }
+            });
+
+        Transform* transform = actor.getComponent<Transform>().get();
+        ShapeFactory* shape = actor.getComponent<ShapeFactory>().get();
+        bench.run("actor.update", "engine", [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; ++i) { actor.update(1.0f / 60.0f); doNotOptimize(*shape); }
+            });
+        bench.run("actor.update", "raw", [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; ++i) {
+                shape->setPosition(transform->getPosition());
+                shape->setRotation(transform->getRotation());
+                shape->setScale(transform->getScale());
+                doNotOptimize(*shape);
+            }
+            });
+
+        // Lo que hace ShapeFactory::render sin la ventana: componer los vrtices y grabar el comando.
+        RenderCommandBuffer commands;
+        std::vector<sf::Vertex> vertices;
+        bench.run("actor.render_submit", "engine", [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; ++i) {
+                shape->buildVertices(vertices);
+                sf::RenderStates states(shape->getTransform());
+                commands.record(vertices.data(), vertices.size(), sf::TriangleFan, states, LAYER_WORLD);
+                if (commands.getCommandCount() >= 1024) {
+                    commands.clear();
+                }
+            }
+            });
+        commands.clear();
+
+        // Referencia: los mismos vrtices copiados a un lote plano, sin transformacin guardada,
+        // tablas de estados ni clave de orden. La diferencia es el costo de grabar el comando.
+        std::vector<sf::Vertex> batch;
+        size_t batched = 0;
+        bench.run("actor.render_submit", "raw", [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; ++i) {
+                shape->buildVertices(vertices);
+                batch.insert(batch.end(), vertices.begin(), vertices.end());
+                if (++batched >= 1024) {
+                    batch.clear();
+                    batched = 0;
+                }
+            }
+            doNotOptimize(batch);
+            });
+    }
+
+    return coreReport(bench, commandLine);
+}
+
+/*
+   Barrido de la escena de estrs. Un salto de ms del doble en los ns por kart respecto al N
+   anterior se marca como "cliff".
+*/
+int Benchmarks::stress(const CommandLine& commandLine) {
+    const size_t maxCount = static_cast<size_t>(std::max(1, std::min(commandLine.getInt("--stress", 100000), 1000000)));
+    const int frames = std::max(1, commandLine.getInt("--frames", 120));
+    const float tickTime = 1.0f / 60.0f;
+    std::vector<sf::Vector2f> waypoints = BaseApp::getTrackWaypoints();
+
+    // Con --flowfield los karts van de checkpoint en checkpoint por el campo horneado.
+    FlowField field;
+    if (commandLine.has("--flowfield")) {
+        if (!field.load(commandLine.getString("--flowfield", "circuit.sflow"))) {
+            return 1;
+        }
+        waypoints = field.getCheckpoints();
+        std::printf("Flow field: %zu checkpoints, rejilla %dx%d\n", field.getCheckpointCount(),
+            field.getGrid().getColumns(), field.getGrid().getRows());
+    }
+
+    std::vector<size_t> counts;
+    for (size_t count = 1; count < maxCount; count *= 10) {
+        counts.push_back(count);
+    }
+    counts.push_back(maxCount);
+
+    std::printf("%9s %11s %11s %10s %11s %12s\n", "karts", "update ms", "prep ms", "ns/kart", "bytes/kart", "allocs/frame");
+    if (!AllocationTracker::isEnabled()) {
+        std::printf("(bytes/kart y allocs/frame valen 0: compilar con SOULPHER_TRACK_ALLOCATIONS)\n");
+    }
+
+    KartSwarm swarm;
+    swarm.setFlowField(&field);
+    RenderCommandBuffer commands;
+    double previousPerKart = 0.0;
+    for (size_t count : counts) {
+        swarm.spawn(count, waypoints);
+
+        // Un frame de calentamiento para que los bferes alcancen su capacidad.
+        swarm.update(tickTime);
+        swarm.prepareRender(commands, 1.0f, 1.0f);
+        commands.clear();
+
+        double updateMs = 0.0;
+        double prepMs = 0.0;
+        const AllocationTracker::Snapshot before = AllocationTracker::getSnapshot();
+        for (int frame = 0; frame < frames; ++frame) {
+            swarm.update(tickTime);
+            swarm.prepareRender(commands, 1.0f, 1.0f);
+            updateMs += swarm.getStats().updateMs;
+            prepMs += swarm.getStats().renderPrepMs;
+            commands.clear();
+        }
+        const AllocationTracker::Snapshot used = AllocationTracker::getSnapshot() - before;
+
+        updateMs /= frames;
+        prepMs /= frames;
+        const double perKart = (updateMs + prepMs) * 1e6 / count;
+        const bool cliff = previousPerKart > 0.0 && perKart > 2.0 * previousPerKart;
+        std::printf("%9zu %11.3f %11.3f %10.1f %11.0f %12.1f%s\n", count, updateMs, prepMs, perKart,
+            swarm.getStats().bytesPerKart, static_cast<double>(used.allocations) / frames, cliff ? "  <- cliff" : "");
+        previousPerKart = perKart;
+    }
+    swarm.clear();
+    return 0;
+}
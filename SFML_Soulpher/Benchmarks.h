@@ -0,0 +1,77 @@
+#pragma once
+#include "Prerequisites.h"
+#include "CommandLine.h"
+
+class MicroBenchmark;
+
+/*
+  Benchmarks
+  - Mediciones de rendimiento que se ejecutan desde la lnea de comandos en lugar de abrir el juego.
+  - Cada funcin devuelve el cdigo de salida del programa (0 si la medicin termin correctamente).
+*/
+namespace Benchmarks
+{
+    /*
+      Funcin archiveLoad.
+      - Compara el tiempo de carga en fro de todas las imgenes de un directorio como archivos
+        sueltos (loadFromFile) contra el mismo contenido ledo de un .spak proyectado en memoria
+        (loadFromMemory).
+      - Opciones: --bench-archive <archivo.spak> --dir <directorio> --runs <n>.
+        Si el .spak no existe, se construye a partir del directorio.
+    */
+    int archiveLoad(const CommandLine& commandLine);
+
+    /*
+      Funcin shapes.
+      - Compara el camino anterior de las formas (un sf::CircleShape creado con new por kart, teselado
+        con getPoint virtual) contra ShapeFactory con descriptores por valor y geometra compartida.
+      - Mide la creacin, la actualizacin por frame (transformacin y lmites) y la composicin de vrtices.
+      - Opciones: --bench-shapes --count <n> --frames <n>.
+    */
+    int shapes(const CommandLine& commandLine);
+
+    /*
+      Funcin replayFrame.
+      - Reproduce un frame capturado (--capture-frame) en una textura de render del mismo tamao,
+        sin el juego, y mide el tiempo de envo de los comandos.
+      - Opciones: --replay-frame <archivo.sframe> --runs <n>.
+    */
+    int replayFrame(const CommandLine& commandLine);
+
+    /*
+      Funcin core.
+      - Microbenchmarks de EngineUtilities y del sistema de componentes, cada uno junto a su
+        equivalente de la biblioteca estndar (o con punteros crudos cuando no hay equivalente):
+        copia, movimiento y conversin de TSharedPointer, MakeShared, TWeakPointer::lock,
+        movimiento de TUniquePtr, Entity::getComponent, Actor::update, la preparacin del dibujo
+        de un actor (vrtices y comando grabado, contra copiar los vrtices a un lote plano),
+        Transform::Seek, los kernels de WaypointFollower y la bsqueda de caminos HPA* (PathFinder)
+        contra A* sobre toda la rejilla.
+      - Opciones: --bench-core [--json <salida.json>] [--baseline <anterior.json>] [--threshold <%>]
+        [--sample-ms <ms>]. Con --baseline devuelve 1 si algn caso es ms lento que el umbral
+        (10 % por defecto), para usarse en CI.
+    */
+    int core(const CommandLine& commandLine);
+
+    /*
+      Funcin corePortable.
+      - Los casos de core que no enlazan con SFML: TSharedPointer, TUniquePtr, Transform::Seek,
+        WaypointFollower y PathFinder. Los usa tambin el ejecutable soulpher_bench (CMakeLists.txt),
+        que se compila en Linux sin SFML.
+    */
+    void corePortable(MicroBenchmark& bench);
+
+    // Imprime los resultados de core y los guarda o compara segn --json, --baseline y --threshold.
+    int coreReport(const MicroBenchmark& bench, const CommandLine& commandLine);
+
+    /*
+      Funcin stress.
+      - Escena de estrs sin ventana: para N = 1, 10, 100, ... hasta el mximo pedido, crea N karts
+        (KartSwarm) y simula frames completos (update y preparacin del dibujo).
+      - Reporta por N: ms de update y de preparacin del dibujo por frame, ns por kart, bytes por kart
+        y reservas por frame, y marca los saltos del costo por kart (donde la escena deja de escalar).
+      - Opciones: --stress <n> --headless [--frames <n>] [--flowfield <archivo.sflow>] (conducir con un
+        flow field horneado en lugar de los waypoints).
+    */
+    int stress(const CommandLine& commandLine);
+}
@@ -0,0 +1,70 @@
+#include "CommandLine.h"
+
+/*
+   Constructor.
+   Recorre los argumentos (omitiendo el nombre del ejecutable) y separa opciones y valores.
+*/
+CommandLine::CommandLine(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string argument = argv[i];
+        if (argument.rfind("--", 0) == 0) {
+            std::string value;
+            if (i + 1 < argc && std::string(argv[i + 1]).rfind("--", 0) != 0) {
+                value = argv[++i];
+            }
+            m_options[argument] = value;
+        }
+        else {
+            m_positional.push_back(argument);
+        }
+    }
+}
+
+// Indica si la opcin est presente.
+bool CommandLine::has(const std::string& option) const {
+    return m_options.count(option) != 0;
+}
+
+// Valor de la opcin como texto.
+std::string CommandLine::getString(const std::string& option, const std::string& defaultValue) const {
+    auto it = m_options.find(option);
+    if (it == m_options.end() || it->second.empty()) {
+        return defaultValue;
+    }
+    return it->second;
+}
+
+// Valor de la opcin como entero; si no es un nmero se usa el valor por defecto.
+int CommandLine::getInt(const std::string& option, int defaultValue) const {
+    const std::string value = getString(option);
+    if (value.empty()) {
+        return defaultValue;
+    }
+    try {
+        return std::stoi(value);
+    }
+    catch (const std::exception&) {
+        LOG_WARN("CommandLine", "getInt", "valor invalido para {} [{}]", option, value);
+        return defaultValue;
+    }
+}
+
+// Valor de la opcin como flotante; si no es un nmero se usa el valor por defecto.
+float CommandLine::getFloat(const std::string& option, float defaultValue) const {
+    const std::string value = getString(option);
+    if (value.empty()) {
+        return defaultValue;
+    }
+    try {
+        return std::stof(value);
+    }
+    catch (const std::exception&) {
+        LOG_WARN("CommandLine", "getFloat", "valor invalido para {} [{}]", option, value);
+        return defaultValue;
+    }
+}
+
+// Argumentos posicionales.
+const std::vector<std::string>& CommandLine::getPositional() const {
+    return m_positional;
+}
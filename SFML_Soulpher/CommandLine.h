@@ -0,0 +1,42 @@
+#pragma once
+#include "Prerequisites.h"
+#include <unordered_map>
+
+/*
+  Clase CommandLine
+  - Interpreta los argumentos con los que se lanz el programa.
+  - Las opciones empiezan con "--". Si la siguiente palabra no empieza con "--", se toma como su valor:
+      SFML_Soulpher --pack "bin/MarioKart sprite-png" --out assets.spak --lz4
+  - Las palabras que no pertenecen a ninguna opcin se guardan como argumentos posicionales.
+*/
+class CommandLine
+{
+public:
+    // Constructor por defecto (sin argumentos).
+    CommandLine() = default;
+
+    // Constructor parametrizado a partir de los argumentos de main.
+    CommandLine(int argc, char* argv[]);
+
+    // Indica si se pas la opcin (por ejemplo "--lz4").
+    bool has(const std::string& option) const;
+
+    /*
+      Funcin getString.
+      - Devuelve el valor de una opcin, o defaultValue si no se pas o no tiene valor.
+    */
+    std::string getString(const std::string& option, const std::string& defaultValue = std::string()) const;
+
+    // Devuelve el valor de una opcin como entero.
+    int getInt(const std::string& option, int defaultValue) const;
+
+    // Devuelve el valor de una opcin como flotante.
+    float getFloat(const std::string& option, float defaultValue) const;
+
+    // Argumentos posicionales, en orden.
+    const std::vector<std::string>& getPositional() const;
+
+private:
+    std::unordered_map<std::string, std::string> m_options;   // Opcin -> valor ("" si no tiene).
+    std::vector<std::string> m_positional;                     // Argumentos sin opcin.
+};
@@ -0,0 +1,94 @@
+#include "CookedImage.h"
+#include <cstring>
+#include <fstream>
+
+const sf::BlendMode BlendPremultipliedAlpha(sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha);
+
+/*
+   Lee una imagen cocinada. Primero se valida todo el bloque y despus se copian los pxeles,
+   as un archivo truncado nunca produce lecturas fuera de rango.
+*/
+bool CookedImage::load(const void* data, size_t size, sf::Image& image, Info* info) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    if (bytes == nullptr || size < sizeof(CookedImageHeader)) {
+        return false;
+    }
+
+    CookedImageHeader header;
+    std::memcpy(&header, bytes, sizeof(header));
+    if (std::memcmp(header.magic, COOKED_MAGIC, sizeof(COOKED_MAGIC)) != 0 || header.version != COOKED_VERSION
+        || header.width == 0 || header.height == 0) {
+        return false;
+    }
+
+    const uint64_t rectBytes = static_cast<uint64_t>(header.rectCount) * sizeof(CookedRect);
+    const uint64_t pixelBytes = static_cast<uint64_t>(header.width) * header.height * 4;
+    if (sizeof(CookedImageHeader) + rectBytes + pixelBytes != size) {
+        return false;
+    }
+
+    const uint8_t* rects = bytes + sizeof(CookedImageHeader);
+    const uint8_t* pixels = rects + rectBytes;
+    image.create(header.width, header.height, pixels);
+
+    if (info != nullptr) {
+        info->header = header;
+        info->rects.clear();
+        info->rects.reserve(header.rectCount);
+        for (uint32_t i = 0; i < header.rectCount; ++i) {
+            CookedRect rect;
+            std::memcpy(&rect, rects + i * sizeof(CookedRect), sizeof(rect));
+            info->rects.emplace_back(rect.left, rect.top, rect.width, rect.height);
+        }
+    }
+    return true;
+}
+
+// Lee el archivo completo y lo interpreta con load().
+bool CookedImage::loadFromFile(const std::string& path, sf::Image& image, Info* info) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        return false;
+    }
+    const std::streamsize size = in.tellg();
+    std::vector<char> bytes(static_cast<size_t>(size));
+    in.seekg(0);
+    if (!in.read(bytes.data(), size)) {
+        return false;
+    }
+    return load(bytes.data(), bytes.size(), image, info);
+}
+
+/*
+   Escribe la cabecera (con el tamao actual de la imagen), los rectngulos y los pxeles.
+*/
+bool CookedImage::save(const std::string& path, const sf::Image& image, const Info& info) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        return false;
+    }
+
+    CookedImageHeader header = info.header;
+    std::memcpy(header.magic, COOKED_MAGIC, sizeof(COOKED_MAGIC));
+    header.version = COOKED_VERSION;
+    header.width = image.getSize().x;
+    header.height = image.getSize().y;
+    header.rectCount = static_cast<uint32_t>(info.rects.size());
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    for (const sf::IntRect& rect : info.rects) {
+        const CookedRect cooked = { rect.left, rect.top, rect.width, rect.height };
+        out.write(reinterpret_cast<const char*>(&cooked), sizeof(cooked));
+    }
+
+    out.write(reinterpret_cast<const char*>(image.getPixelsPtr()),
+        static_cast<std::streamsize>(static_cast<size_t>(header.width) * header.height * 4));
+    return static_cast<bool>(out);
+}
+
+// Comprueba la extensin .cooked.
+bool CookedImage::isCookedPath(const std::string& path) {
+    const std::string extension = ".cooked";
+    return path.size() >= extension.size()
+        && path.compare(path.size() - extension.size(), extension.size(), extension) == 0;
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include "Prerequisites.h"
+#include <cstdint>
+
+/*
+  Formato de imagen cocinada (.cooked)
+
+  [CookedImageHeader][CookedRect x rectCount][pxeles RGBA de width x height]
+
+  - Los pxeles ya estn en el formato que espera la GPU (RGBA de 8 bits), as que cargar una imagen
+    cocinada es una copia de memoria: no hay que decodificar PNG en tiempo de ejecucin.
+  - La imagen puede venir recortada (sin bordes transparentes); trimX/trimY y originalWidth/originalHeight
+    permiten colocarla igual que la imagen original.
+  - Los rectngulos describen los sprites encontrados dentro de la hoja, en coordenadas de la imagen recortada.
+*/
+constexpr char COOKED_MAGIC[4] = { 'S', 'C', 'K', 'I' };
+constexpr uint32_t COOKED_VERSION = 1;
+constexpr uint32_t COOKED_PREMULTIPLIED = 1u << 0;   // El color ya est multiplicado por el alfa.
+constexpr uint32_t COOKED_TRIMMED = 1u << 1;         // Se eliminaron los bordes transparentes.
+
+struct CookedImageHeader
+{
+    char magic[4];            // "SCKI".
+    uint32_t version;         // COOKED_VERSION.
+    uint32_t flags;           // COOKED_*.
+    uint32_t width;           // Ancho de los pxeles guardados.
+    uint32_t height;          // Alto de los pxeles guardados.
+    uint32_t originalWidth;   // Ancho de la imagen original.
+    uint32_t originalHeight;  // Alto de la imagen original.
+    int32_t trimX;            // Posicin del recorte dentro de la imagen original.
+    int32_t trimY;
+    uint32_t rectCount;       // Nmero de rectngulos de sprites.
+};
+
+struct CookedRect
+{
+    int32_t left;
+    int32_t top;
+    int32_t width;
+    int32_t height;
+};
+
+static_assert(sizeof(CookedImageHeader) == 40, "CookedImageHeader debe ocupar 40 bytes");
+static_assert(sizeof(CookedRect) == 16, "CookedRect debe ocupar 16 bytes");
+
+/*
+  Modo de mezcla para texturas con alfa premultiplicado.
+  Con el modo por defecto de SFML (SrcAlpha, OneMinusSrcAlpha) los bordes se veran ms oscuros.
+  Se define en CookedImage.cpp para no construir una copia en cada archivo que incluye este encabezado.
+*/
+extern const sf::BlendMode BlendPremultipliedAlpha;
+
+/*
+  Clase CookedImage
+  - Lectura y escritura del formato .cooked.
+*/
+class CookedImage
+{
+public:
+    /*
+      Estructura Info.
+      - Metadatos de una imagen cocinada: cabecera y rectngulos de sprites.
+    */
+    struct Info
+    {
+        CookedImageHeader header{};
+        std::vector<sf::IntRect> rects;
+
+        bool isPremultiplied() const { return (header.flags & COOKED_PREMULTIPLIED) != 0; }
+        sf::Vector2i getTrimOffset() const { return sf::Vector2i(header.trimX, header.trimY); }
+    };
+
+    /*
+      Funcin load.
+      - Lee una imagen cocinada desde memoria y copia sus pxeles en image.
+      - Valida la cabecera y los tamaos; devuelve false si el bloque est daado.
+    */
+    static bool load(const void* data, size_t size, sf::Image& image, Info* info = nullptr);
+
+    // Lee una imagen cocinada desde un archivo.
+    static bool loadFromFile(const std::string& path, sf::Image& image, Info* info = nullptr);
+
+    /*
+      Funcin save.
+      - Escribe image con la cabecera y los rectngulos indicados.
+    */
+    static bool save(const std::string& path, const sf::Image& image, const Info& info);
+
+    // Indica si la ruta tiene la extensin .cooked.
+    static bool isCookedPath(const std::string& path);
+};
@@ -0,0 +1,291 @@
+#include "Benchmarks.h"
+#include "MicroBenchmark.h"
+#include "BaseApp.h"
+#include "Transform.h"
+#include "WaypointFollower.h"
+#include "PathFinder.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <random>
+
+/*
+   Casos de Benchmarks::core que no enlazan con SFML (solo usan sus encabezados de vectores y
+   rectngulos). Este archivo, junto con los que usa, forma el ejecutable soulpher_bench de
+   CMakeLists.txt, que se compila en Linux sin SFML ni ventana.
+*/
+
+namespace
+{
+    /*
+       Pista sinttica para medir la bsqueda de caminos sin Circuit.png: un anillo de 50 unidades de
+       ancho que pasa por los waypoints, sobre el rectngulo de la pista en celdas de 4 unidades.
+    */
+    TrackGrid makeRingGrid() {
+        const sf::FloatRect bounds = BaseApp::getTrackBounds();
+        const std::vector<sf::Vector2f> waypoints = BaseApp::getTrackWaypoints();
+        constexpr float CELL = 4.0f;
+        constexpr float HALF_WIDTH = 25.0f;
+        const int columns = static_cast<int>(bounds.width / CELL);
+        const int rows = static_cast<int>(bounds.height / CELL);
+        std::vector<uint8_t> cells(static_cast<size_t>(columns) * rows, 0);
+        for (int row = 0; row < rows; ++row) {
+            for (int column = 0; column < columns; ++column) {
+                const sf::Vector2f p(bounds.left + (column + 0.5f) * CELL, bounds.top + (row + 0.5f) * CELL);
+                for (size_t i = 0; i < waypoints.size(); ++i) {
+                    const sf::Vector2f a = waypoints[i];
+                    const sf::Vector2f ab = waypoints[(i + 1) % waypoints.size()] - a;
+                    const float t = std::clamp(((p.x - a.x) * ab.x + (p.y - a.y) * ab.y) / (ab.x * ab.x + ab.y * ab.y), 0.0f, 1.0f);
+                    const sf::Vector2f offset = p - (a + ab * t);
+                    if (offset.x * offset.x + offset.y * offset.y <= HALF_WIDTH * HALF_WIDTH) {
+                        cells[static_cast<size_t>(row) * columns + column] = 1;
+                        break;
+                    }
+                }
+            }
+        }
+        TrackGrid grid;
+        grid.assign(columns, rows, CELL, sf::Vector2f(bounds.left, bounds.top), std::move(cells));
+        return grid;
+    }
+
+    // Seek escrito con std::hypot, para comparar con Transform::Seek.
+    void seekStd(sf::Vector2f& position, const sf::Vector2f& target, float speed, float deltaTime, float range) {
+        const sf::Vector2f direction = target - position;
+        const float distance = std::hypot(direction.x, direction.y);
+        if (distance < range || distance <= 0.0f) {
+            return;
+        }
+        position += direction * (speed * deltaTime / distance);
+    }
+}
+
+void Benchmarks::corePortable(MicroBenchmark& bench) {
+    using namespace EngineUtilities;
+
+    // TSharedPointer: copia, movimiento, conversin, creacin y TWeakPointer::lock.
+    {
+        TSharedPointer<Transform> engine = MakeShared<Transform>();
+        std::shared_ptr<Transform> standard = std::make_shared<Transform>();
+
+        bench.run("shared_ptr.copy", "engine", [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; ++i) { TSharedPointer<Transform> copy = engine; doNotOptimize(copy); }
+            });
+        bench.run("shared_ptr.copy", "std", [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; ++i) { std::shared_ptr<Transform> copy = standard; doNotOptimize(copy); }
+            });
+
+        bench.run("shared_ptr.move", "engine", [&](uint64_t n) {
+            TSharedPointer<Transform> other;
+            for (uint64_t i = 0; i < n; ++i) { other = std::move(engine); engine = std::move(other); doNotOptimize(engine); }
+            });
+        bench.run("shared_ptr.move", "std", [&](uint64_t n) {
+            std::shared_ptr<Transform> other;
+            for (uint64_t i = 0; i < n; ++i) { other = std::move(standard); standard = std::move(other); doNotOptimize(standard); }
+            });
+
+        TSharedPointer<Component> engineBase = engine.dynamic_pointer_cast<Component>();
+        std::shared_ptr<Component> standardBase = standard;
+        bench.run("shared_ptr.dynamic_cast", "engine", [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; ++i) { auto cast = engineBase.dynamic_pointer_cast<Transform>(); doNotOptimize(cast); }
+            });
+        bench.run("shared_ptr.dynamic_cast", "std", [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; ++i) { auto cast = std::dynamic_pointer_cast<Transform>(standardBase); doNotOptimize(cast); }
+            });
+
+        bench.run("make_shared", "engine", [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; ++i) { auto created = MakeShared<Transform>(); doNotOptimize(created); }
+            });
+        bench.run("make_shared", "std", [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; ++i) { auto created = std::make_shared<Transform>(); doNotOptimize(created); }
+            });
+
+        TWeakPointer<Transform> engineWeak(engine);
+        std::weak_ptr<Transform> standardWeak(standard);
+        bench.run("weak_ptr.lock", "engine", [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; ++i) { auto locked = engineWeak.lock(); doNotOptimize(locked); }
+            });
+        bench.run("weak_ptr.lock", "std", [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; ++i) { auto locked = standardWeak.lock(); doNotOptimize(locked); }
+            });
+    }
+
+    // TUniquePtr: movimiento.
+    {
+        TUniquePtr<Transform> engine = MakeUnique<Transform>();
+        std::unique_ptr<Transform> standard = std::make_unique<Transform>();
+        bench.run("unique_ptr.move", "engine", [&](uint64_t n) {
+            TUniquePtr<Transform> other;
+            for (uint64_t i = 0; i < n; ++i) { other = std::move(engine); engine = std::move(other); doNotOptimize(engine); }
+            });
+        bench.run("unique_ptr.move", "std", [&](uint64_t n) {
+            std::unique_ptr<Transform> other;
+            for (uint64_t i = 0; i < n; ++i) { other = std::move(standard); standard = std::move(other); doNotOptimize(standard); }
+            });
+    }
+
+    // Transform::Seek (la posicin se reinicia para que nunca llegue al objetivo).
+    {
+        Transform transform;
+        const sf::Vector2f start(0.0f, 0.0f);
+        const sf::Vector2f target(400.0f, 300.0f);
+        bench.run("transform.seek", "engine", [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; ++i) {
+                transform.setPosition(start);
+                transform.Seek(target, 150.0f, 1.0f / 60.0f, 1.0f);
+                doNotOptimize(transform);
+            }
+            });
+        sf::Vector2f position;
+        bench.run("transform.seek", "std", [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; ++i) {
+                position = start;
+                seekStd(position, target, 150.0f, 1.0f / 60.0f, 1.0f);
+                doNotOptimize(position);
+            }
+            });
+    }
+
+    /*
+       WaypointFollower: un lote de karts que cabe en la cach L2. Una operacin es un paso de un kart,
+       as que 1000 / ns es el rendimiento en millones de pasos por segundo. "engine" usa el mejor
+       kernel de la CPU; "scalar" (y "sse2", si hay AVX2) son las alternativas.
+    */
+    {
+        constexpr size_t BATCH = 4096;
+        const std::vector<sf::Vector2f> route = BaseApp::getTrackWaypoints();
+        std::vector<WaypointFollower> followers(3);
+        std::mt19937 random(7);
+        std::uniform_real_distribution<float> coordinate(0.0f, 800.0f);
+        std::uniform_real_distribution<float> speed(120.0f, 180.0f);
+        for (WaypointFollower& follower : followers) {
+            follower.setWaypoints(route);
+            follower.reserve(BATCH);
+        }
+        for (size_t i = 0; i < BATCH; ++i) {
+            const sf::Vector2f position(coordinate(random), coordinate(random));
+            const float kartSpeed = speed(random);
+            const uint32_t waypoint = static_cast<uint32_t>(random() % route.size());
+            for (WaypointFollower& follower : followers) {
+                follower.add(position, kartSpeed, waypoint);
+            }
+        }
+
+        const WaypointFollower::Kernel best = WaypointFollower::getBestKernel();
+        followers[1].setKernel(WaypointFollower::Kernel::Scalar);
+        followers[2].setKernel(WaypointFollower::Kernel::SSE2);
+
+        // Todos los kernels siguen el mismo orden de operaciones: tras muchos ticks deben coincidir.
+        for (int tick = 0; tick < 600; ++tick) {
+            for (WaypointFollower& follower : followers) {
+                follower.update(1.0f / 60.0f);
+            }
+        }
+        size_t mismatches = 0;
+        for (size_t i = 0; i < BATCH; ++i) {
+            for (size_t k = 1; k < followers.size(); ++k) {
+                if (followers[k].getPosition(i) != followers[0].getPosition(i)
+                    || followers[k].getWaypoint(i) != followers[0].getWaypoint(i)) {
+                    ++mismatches;
+                }
+            }
+        }
+
+        auto stepBatch = [&](WaypointFollower& follower) {
+            return [&follower](uint64_t n) {
+                for (uint64_t done = 0; done < n; done += BATCH) {
+                    follower.update(1.0f / 60.0f);
+                }
+                doNotOptimize(follower);
+            };
+        };
+        bench.run("waypoint.step", "engine", stepBatch(followers[0]));
+        const double nsPerStep = bench.getResults().back().nsPerOp;
+        bench.run("waypoint.step", "scalar", stepBatch(followers[1]));
+        if (best == WaypointFollower::Kernel::AVX2) {
+            bench.run("waypoint.step", "sse2", stepBatch(followers[2]));
+        }
+
+        std::printf("waypoint.step: kernel %s, %.0f M pasos/s por nucleo (objetivo > 100 M), %s\n",
+            WaypointFollower::getKernelName(best), nsPerStep > 0.0 ? 1000.0 / nsPerStep : 0.0,
+            mismatches == 0 ? "los kernels coinciden" : "LOS KERNELS NO COINCIDEN");
+    }
+
+    /*
+       PathFinder: una operacin es una bsqueda entre dos celdas al azar de la pista sinttica.
+       "engine" es HPA* sin cach, "flat" es A* sobre toda la rejilla y "cached" repite las mismas
+       256 bsquedas con la cach activa.
+    */
+    {
+        PathFinder pathFinder(1);
+        pathFinder.build(makeRingGrid());
+        const TrackGrid& grid = pathFinder.getGrid();
+        std::vector<sf::Vector2f> road;
+        for (size_t cell = 0; cell < grid.getCellCount(); ++cell) {
+            if (grid.isDrivable(cell)) {
+                road.push_back(grid.getCellCenter(cell));
+            }
+        }
+        std::mt19937 random(11);
+        std::uniform_int_distribution<size_t> pick(0, road.size() - 1);
+        std::vector<std::pair<sf::Vector2f, sf::Vector2f>> queries(256);
+        for (auto& query : queries) {
+            query = std::make_pair(road[pick(random)], road[pick(random)]);
+        }
+
+        PathResult result;
+        auto search = [&](bool flat) {
+            return [&, flat](uint64_t n) {
+                for (uint64_t i = 0; i < n; ++i) {
+                    const auto& query = queries[i % queries.size()];
+                    if (flat) {
+                        pathFinder.findPathFlat(query.first, query.second, result);
+                    }
+                    else {
+                        pathFinder.findPath(query.first, query.second, result);
+                    }
+                    doNotOptimize(result);
+                }
+            };
+        };
+        pathFinder.setCacheCapacity(0);
+        bench.run("path.find", "engine", search(false));
+        bench.run("path.find", "flat", search(true));
+        pathFinder.setCacheCapacity(queries.size());
+        bench.run("path.find", "cached", search(false));
+
+        const PathFinder::Stats stats = pathFinder.getStats();
+        std::printf("path.find: rejilla %dx%d, %zu clusters, grafo de %zu nodos y %zu aristas\n",
+            grid.getColumns(), grid.getRows(), stats.clusters, stats.nodes, stats.edges);
+    }
+}
+
+/*
+   Imprime la tabla, guarda el JSON y compara contra la lnea base.
+*/
+int Benchmarks::coreReport(const MicroBenchmark& bench, const CommandLine& commandLine) {
+    std::cout << "core: ns por operacion (mediana), proporcion contra la referencia\n";
+    bench.print("engine");
+
+    const std::string jsonPath = commandLine.getString("--json");
+    if (!jsonPath.empty() && !bench.saveJson(jsonPath)) {
+        return 1;
+    }
+
+    const std::string baselinePath = commandLine.getString("--baseline");
+    if (!baselinePath.empty()) {
+        std::vector<BenchmarkResult> baseline;
+        if (!MicroBenchmark::loadJson(baselinePath, baseline)) {
+            return 1;
+        }
+        const double threshold = commandLine.getFloat("--threshold", 10.0f);
+        std::cout << "core: comparacion con [" << baselinePath << "], umbral " << threshold << " %\n";
+        const int regressions = bench.compare(baseline, threshold);
+        if (regressions > 0) {
+            std::cout << "core: " << regressions << " regresiones\n";
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,144 @@
+#include "FileWatcher.h"
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+#ifdef __linux__
+
+/*
+   Constructor (Linux).
+   IN_NONBLOCK hace que read() regrese de inmediato si no hay eventos pendientes.
+*/
+FileWatcher::FileWatcher() {
+    m_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotify < 0) {
+        LOG_ERROR("FileWatcher", "FileWatcher", "no se pudo inicializar inotify (errno {})", errno);
+    }
+}
+
+// Destructor (Linux). Cerrar el descriptor elimina todas las vigilancias.
+FileWatcher::~FileWatcher() {
+    if (m_inotify >= 0) {
+        close(m_inotify);
+    }
+}
+
+/*
+   Vigila el directorio que contiene el archivo. inotify vigila directorios para detectar tambin
+   los guardados que reemplazan el archivo por otro (rename), que perderan una vigilancia por archivo.
+*/
+void FileWatcher::watchFile(const std::string& path) {
+    if (m_inotify < 0 || m_files.count(path) != 0) {
+        return;
+    }
+
+    // El archivo solo se registra si su directorio queda vigilado; si falla, una llamada
+    // posterior con la misma ruta vuelve a intentarlo.
+    const std::string directory = std::filesystem::path(path).parent_path().generic_string();
+    if (m_watchByDirectory.count(directory) == 0) {
+        const int watch = inotify_add_watch(m_inotify, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+        if (watch < 0) {
+            LOG_WARN("FileWatcher", "watchFile", "no se pudo vigilar [{}] (errno {})", directory, errno);
+            return;
+        }
+        m_directories[watch] = directory;
+        m_watchByDirectory[directory] = watch;
+    }
+    m_files.insert(path);
+}
+
+// Deja de reportar un archivo. La vigilancia del directorio se conserva para los dems archivos.
+void FileWatcher::unwatchFile(const std::string& path) {
+    m_files.erase(path);
+}
+
+/*
+   Lee todos los eventos pendientes y devuelve los archivos vigilados que cambiaron.
+*/
+std::vector<std::string> FileWatcher::poll() {
+    std::vector<std::string> changed;
+    if (m_inotify < 0) {
+        return changed;
+    }
+
+    std::unordered_set<std::string> seen;
+    alignas(inotify_event) char buffer[4096];
+
+    while (true) {
+        const ssize_t length = read(m_inotify, buffer, sizeof(buffer));
+        if (length <= 0) {
+            break;  // EAGAIN: no hay ms eventos.
+        }
+
+        for (ssize_t offset = 0; offset < length;) {
+            const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            offset += sizeof(inotify_event) + event->len;
+
+            auto directory = m_directories.find(event->wd);
+            if (directory == m_directories.end() || event->len == 0) {
+                continue;
+            }
+
+            const std::string file = directory->second + "/" + event->name;
+            if (m_files.count(file) != 0 && seen.insert(file).second) {
+                changed.push_back(file);
+            }
+        }
+    }
+    return changed;
+}
+
+#else
+
+// Constructor (sondeo). No requiere inicializacin.
+FileWatcher::FileWatcher() = default;
+
+// Destructor (sondeo).
+FileWatcher::~FileWatcher() = default;
+
+// Registra el archivo junto con su fecha de modificacin actual.
+void FileWatcher::watchFile(const std::string& path) {
+    if (!m_files.insert(path).second) {
+        return;
+    }
+    std::error_code ec;
+    m_timestamps[path] = std::filesystem::last_write_time(path, ec);
+}
+
+// Deja de vigilar un archivo.
+void FileWatcher::unwatchFile(const std::string& path) {
+    m_files.erase(path);
+    m_timestamps.erase(path);
+}
+
+/*
+   Compara las fechas de modificacin como mximo dos veces por segundo,
+   para no consultar el disco en cada frame.
+*/
+std::vector<std::string> FileWatcher::poll() {
+    std::vector<std::string> changed;
+    if (m_pollClock.getElapsedTime() < sf::milliseconds(500)) {
+        return changed;
+    }
+    m_pollClock.restart();
+
+    for (auto& [path, timestamp] : m_timestamps) {
+        std::error_code ec;
+        const auto current = std::filesystem::last_write_time(path, ec);
+        if (!ec && current != timestamp) {
+            timestamp = current;
+            changed.push_back(path);
+        }
+    }
+    return changed;
+}
+
+#endif
+
+// Nmero de archivos vigilados.
+size_t FileWatcher::getWatchedCount() const {
+    return m_files.size();
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include "Prerequisites.h"
+#include <unordered_map>
+#include <unordered_set>
+#include <filesystem>
+
+/*
+  Clase FileWatcher
+  - Detecta cambios en disco de un conjunto de archivos para poder recargarlos en caliente.
+  - En Linux usa inotify: el sistema operativo avisa cuando un archivo vigilado se termina de escribir
+    o se reemplaza (muchos editores guardan en un archivo temporal y luego lo renombran).
+  - En otras plataformas compara peridicamente la fecha de modificacin de cada archivo.
+  - poll() no bloquea y est pensado para llamarse una vez por frame desde el hilo principal.
+*/
+class FileWatcher
+{
+public:
+    /*
+      Constructor por defecto.
+      - En Linux crea la instancia de inotify en modo no bloqueante.
+    */
+    FileWatcher();
+
+    /*
+      Destructor.
+      - Cierra la instancia de inotify y sus vigilancias.
+    */
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    /*
+      Funcin watchFile.
+      - Empieza a vigilar un archivo (ruta absoluta y normalizada, como la que devuelve
+        ResourceManager::resolvePath). Vigilar dos veces el mismo archivo no tiene efecto.
+    */
+    void watchFile(const std::string& path);
+
+    // Deja de vigilar un archivo.
+    void unwatchFile(const std::string& path);
+
+    /*
+      Funcin poll.
+      - Devuelve las rutas de los archivos vigilados que cambiaron desde la ltima llamada,
+        sin repetir rutas aunque el sistema haya enviado varios eventos para el mismo archivo.
+    */
+    std::vector<std::string> poll();
+
+    // Nmero de archivos vigilados.
+    size_t getWatchedCount() const;
+
+private:
+    std::unordered_set<std::string> m_files;   // Archivos vigilados.
+
+#ifdef __linux__
+    int m_inotify = -1;                                   // Descriptor de inotify.
+    std::unordered_map<int, std::string> m_directories;   // Vigilancia -> directorio vigilado.
+    std::unordered_map<std::string, int> m_watchByDirectory;
+#else
+    // Alternativa por sondeo: fecha de modificacin conocida de cada archivo.
+    std::unordered_map<std::string, std::filesystem::file_time_type> m_timestamps;
+    sf::Clock m_pollClock;                                // Limita la frecuencia del sondeo.
+#endif
+};
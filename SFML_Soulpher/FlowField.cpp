@@ -0,0 +1,306 @@
+#include "FlowField.h"
+#include "ThreadPool.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <queue>
+
+namespace
+{
+    /*
+       Formato .sflow:
+       [FlowHeader][checkpoints: x f32, y f32][celdas: u8 por celda]
+       [direcciones: x i8, y i8 por celda y checkpoint][distancias: f32 por celda y checkpoint]
+    */
+    constexpr char FLOW_MAGIC[4] = { 'S', 'F', 'L', 'W' };
+    constexpr uint32_t FLOW_VERSION = 1;
+
+    struct FlowHeader
+    {
+        char magic[4];
+        uint32_t version;
+        int32_t columns;
+        int32_t rows;
+        float cellSize;
+        float originX;
+        float originY;
+        uint32_t checkpointCount;
+        float goalRadius;
+        uint32_t reserved;
+    };
+
+    static_assert(sizeof(FlowHeader) == 40, "FlowHeader debe ocupar 40 bytes");
+
+    constexpr float INFINITE_DISTANCE = std::numeric_limits<float>::infinity();
+
+    // Los 8 vecinos de una celda y la longitud de cada paso.
+    constexpr int NEIGHBOR_X[8] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+    constexpr int NEIGHBOR_Y[8] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+    constexpr float DIAGONAL = 1.41421356f;
+    constexpr float NEIGHBOR_LENGTH[8] = { 1.0f, 1.0f, 1.0f, 1.0f, DIAGONAL, DIAGONAL, DIAGONAL, DIAGONAL };
+
+    int8_t quantize(float value) {
+        return static_cast<int8_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 127.0f));
+    }
+
+    template<typename T>
+    bool readArray(std::ifstream& in, std::vector<T>& values, size_t count) {
+        values.resize(count);
+        in.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(count * sizeof(T)));
+        return static_cast<bool>(in);
+    }
+
+    template<typename T>
+    void writeArray(std::ofstream& out, const std::vector<T>& values) {
+        out.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+    }
+}
+
+/*
+   La rejilla se construye una vez y cada checkpoint se hornea en su propia tarea: los campos no
+   comparten nada salvo la rejilla, que solo se lee, y cada tarea escribe su propio tramo de la tabla.
+*/
+bool FlowField::bake(const sf::Image& image, const sf::FloatRect& worldBounds,
+    const std::vector<sf::Vector2f>& checkpoints, const BakeOptions& options) {
+    m_checkpoints.clear();
+    m_directions.clear();
+    m_distances.clear();
+    if (checkpoints.empty() || !m_grid.build(image, worldBounds, checkpoints, options.grid)) {
+        m_grid = TrackGrid();
+        return false;
+    }
+    m_checkpoints = checkpoints;
+    m_goalRadius = std::max(options.goalRadius, options.grid.cellSize * 0.5f);
+
+    const size_t cellCount = m_grid.getCellCount();
+    m_directions.resize(cellCount * m_checkpoints.size());
+    m_distances.resize(cellCount * m_checkpoints.size(), INFINITE_DISTANCE);
+
+    const float offRoadCost = std::max(options.offRoadCost, 1.0f);
+    ThreadPool pool(options.threadCount, "Baker");
+    for (size_t checkpoint = 0; checkpoint < m_checkpoints.size(); ++checkpoint) {
+        pool.submit([this, checkpoint, offRoadCost]() { bakeCheckpoint(checkpoint, offRoadCost); });
+    }
+    pool.waitIdle();
+    return true;
+}
+
+/*
+   1. Las celdas a menos de m_goalRadius del checkpoint (y la suya) empiezan con distancia 0.
+   2. Dijkstra con montculo: pasar de una celda a su vecina cuesta la longitud del paso por el
+      promedio del costo de ambas (1 en asfalto, offRoadCost fuera).
+   3. La direccin de cada celda suma la direccin hacia cada vecina ms cercana al checkpoint,
+      pesada por cunto baja la distancia por unidad de paso, y se normaliza. As las direcciones
+      no se limitan a 8 ngulos. Las celdas de la meta apuntan directo al checkpoint.
+*/
+void FlowField::bakeCheckpoint(size_t checkpoint, float offRoadCost) {
+    PROFILE_SCOPE("FlowField::bakeCheckpoint");
+    const size_t cellCount = m_grid.getCellCount();
+    const int columns = m_grid.getColumns();
+    const int rows = m_grid.getRows();
+    const float cellSize = m_grid.getCellSize();
+    const sf::Vector2f goal = m_checkpoints[checkpoint];
+    float* distance = m_distances.data() + checkpoint * cellCount;
+    Direction* direction = m_directions.data() + checkpoint * cellCount;
+
+    auto cost = [&](size_t index) { return m_grid.isDrivable(index) ? 1.0f : offRoadCost; };
+
+    using Entry = std::pair<float, uint32_t>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+    const float goalRadiusSquared = m_goalRadius * m_goalRadius;
+    for (size_t index = 0; index < cellCount; ++index) {
+        const sf::Vector2f offset = m_grid.getCellCenter(index) - goal;
+        if (offset.x * offset.x + offset.y * offset.y <= goalRadiusSquared) {
+            distance[index] = 0.0f;
+            open.push(Entry(0.0f, static_cast<uint32_t>(index)));
+        }
+    }
+    const size_t goalCell = m_grid.indexAt(goal);
+    if (distance[goalCell] != 0.0f) {
+        distance[goalCell] = 0.0f;
+        open.push(Entry(0.0f, static_cast<uint32_t>(goalCell)));
+    }
+
+    while (!open.empty()) {
+        const Entry current = open.top();
+        open.pop();
+        const size_t index = current.second;
+        if (current.first > distance[index]) {
+            continue;   // Entrada vieja: la celda ya se cerr con una distancia menor.
+        }
+        const int column = static_cast<int>(index % columns);
+        const int row = static_cast<int>(index / columns);
+        const float here = cost(index);
+        for (int n = 0; n < 8; ++n) {
+            const int neighborColumn = column + NEIGHBOR_X[n];
+            const int neighborRow = row + NEIGHBOR_Y[n];
+            if (!m_grid.contains(neighborColumn, neighborRow)) {
+                continue;
+            }
+            const size_t neighbor = m_grid.toIndex(neighborColumn, neighborRow);
+            const float candidate = current.first + NEIGHBOR_LENGTH[n] * cellSize * 0.5f * (here + cost(neighbor));
+            if (candidate < distance[neighbor]) {
+                distance[neighbor] = candidate;
+                open.push(Entry(candidate, static_cast<uint32_t>(neighbor)));
+            }
+        }
+    }
+
+    for (int row = 0; row < rows; ++row) {
+        for (int column = 0; column < columns; ++column) {
+            const size_t index = m_grid.toIndex(column, row);
+            sf::Vector2f sum;
+            if (distance[index] == 0.0f) {
+                sum = goal - m_grid.getCellCenter(index);
+            }
+            else {
+                for (int n = 0; n < 8; ++n) {
+                    const int neighborColumn = column + NEIGHBOR_X[n];
+                    const int neighborRow = row + NEIGHBOR_Y[n];
+                    if (!m_grid.contains(neighborColumn, neighborRow)) {
+                        continue;
+                    }
+                    const float drop = distance[index] - distance[m_grid.toIndex(neighborColumn, neighborRow)];
+                    if (drop > 0.0f) {
+                        const float weight = drop / (NEIGHBOR_LENGTH[n] * NEIGHBOR_LENGTH[n]);
+                        sum += sf::Vector2f(NEIGHBOR_X[n] * weight, NEIGHBOR_Y[n] * weight);
+                    }
+                }
+            }
+            const float length = std::sqrt(sum.x * sum.x + sum.y * sum.y);
+            if (length > 1e-6f) {
+                direction[index].x = quantize(sum.x / length);
+                direction[index].y = quantize(sum.y / length);
+            }
+        }
+    }
+}
+
+bool FlowField::bakeFile(const std::string& imagePath, const std::string& outputPath, const sf::FloatRect& worldBounds,
+    const std::vector<sf::Vector2f>& checkpoints, const BakeOptions& options) {
+    sf::Image image;
+    if (!image.loadFromFile(imagePath)) {
+        LOG_ERROR("FlowField", "bakeFile", "no se pudo leer la imagen [{}]", imagePath);
+        return false;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    FlowField field;
+    if (!field.bake(image, worldBounds, checkpoints, options)) {
+        LOG_ERROR("FlowField", "bakeFile", "no se pudo hornear [{}]", imagePath);
+        return false;
+    }
+    const double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    const TrackGrid& grid = field.getGrid();
+    std::cout << "Rejilla: " << grid.getColumns() << "x" << grid.getRows() << " celdas de " << grid.getCellSize()
+        << " unidades (" << static_cast<int>(grid.getDrivableRatio() * 100.0f + 0.5f) << " % transitable)\n"
+        << "Checkpoints: " << field.getCheckpointCount() << ", horneados en " << elapsedMs << " ms\n";
+    if (!field.save(outputPath)) {
+        return false;
+    }
+    std::cout << "Guardado en " << outputPath << "\n";
+    return true;
+}
+
+bool FlowField::save(const std::string& path) const {
+    if (!isValid()) {
+        LOG_ERROR("FlowField", "save", "no hay un campo horneado");
+        return false;
+    }
+    std::ofstream out(path, std::ios::binary);
+    FlowHeader header{};
+    std::memcpy(header.magic, FLOW_MAGIC, sizeof(FLOW_MAGIC));
+    header.version = FLOW_VERSION;
+    header.columns = m_grid.getColumns();
+    header.rows = m_grid.getRows();
+    header.cellSize = m_grid.getCellSize();
+    header.originX = m_grid.getOrigin().x;
+    header.originY = m_grid.getOrigin().y;
+    header.checkpointCount = static_cast<uint32_t>(m_checkpoints.size());
+    header.goalRadius = m_goalRadius;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    writeArray(out, m_checkpoints);
+    writeArray(out, m_grid.getCells());
+    writeArray(out, m_directions);
+    writeArray(out, m_distances);
+    if (!out) {
+        LOG_ERROR("FlowField", "save", "no se pudo escribir [{}]", path);
+        return false;
+    }
+    return true;
+}
+
+/*
+   Las tablas miden celdas por checkpoints, dos nmeros del encabezado: antes de reservar se
+   comprueba que el archivo de verdad contiene todo lo que anuncian, para que un archivo corrupto
+   no pida gigabytes ni desborde el producto.
+*/
+bool FlowField::load(const std::string& path) {
+    *this = FlowField();
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    const std::streamoff fileSize = in ? static_cast<std::streamoff>(in.tellg()) : 0;
+    in.seekg(0);
+    FlowHeader header{};
+    in.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!in || std::memcmp(header.magic, FLOW_MAGIC, sizeof(FLOW_MAGIC)) != 0 || header.version != FLOW_VERSION
+        || header.columns <= 0 || header.rows <= 0 || header.checkpointCount == 0) {
+        LOG_ERROR("FlowField", "load", "archivo no valido [{}]", path);
+        return false;
+    }
+
+    // columns * rows cabe en 64 bits (dos int32 positivos), y tambin bytesPerCell; su producto no:
+    // se compara contra lo que queda del archivo dividiendo en lugar de multiplicar.
+    const uint64_t cellCount = static_cast<uint64_t>(header.columns) * static_cast<uint64_t>(header.rows);
+    const uint64_t checkpointBytes = static_cast<uint64_t>(header.checkpointCount) * sizeof(sf::Vector2f);
+    const uint64_t bytesPerCell = 1 + static_cast<uint64_t>(header.checkpointCount) * (sizeof(Direction) + sizeof(float));
+    const uint64_t available = fileSize > static_cast<std::streamoff>(sizeof(header))
+        ? static_cast<uint64_t>(fileSize) - sizeof(header) : 0;
+    if (checkpointBytes > available || cellCount > (available - checkpointBytes) / bytesPerCell) {
+        LOG_ERROR("FlowField", "load", "el encabezado pide mas datos de los que tiene el archivo [{}]", path);
+        return false;
+    }
+
+    std::vector<uint8_t> cells;
+    FlowField field;
+    field.m_goalRadius = header.goalRadius;
+    if (!readArray(in, field.m_checkpoints, header.checkpointCount) || !readArray(in, cells, cellCount)
+        || !readArray(in, field.m_directions, cellCount * header.checkpointCount)
+        || !readArray(in, field.m_distances, cellCount * header.checkpointCount)
+        || !field.m_grid.assign(header.columns, header.rows, header.cellSize,
+            sf::Vector2f(header.originX, header.originY), std::move(cells))) {
+        LOG_ERROR("FlowField", "load", "archivo incompleto [{}]", path);
+        return false;
+    }
+    *this = std::move(field);
+    return true;
+}
+
+bool FlowField::isValid() const {
+    return !m_checkpoints.empty() && m_grid.isValid();
+}
+
+float FlowField::getDistance(size_t checkpoint, const sf::Vector2f& position) const {
+    return m_distances[checkpoint * m_grid.getCellCount() + m_grid.indexAt(position)];
+}
+
+size_t FlowField::getCheckpointCount() const {
+    return m_checkpoints.size();
+}
+
+const std::vector<sf::Vector2f>& FlowField::getCheckpoints() const {
+    return m_checkpoints;
+}
+
+float FlowField::getGoalRadius() const {
+    return m_goalRadius;
+}
+
+const TrackGrid& FlowField::getGrid() const {
+    return m_grid;
+}
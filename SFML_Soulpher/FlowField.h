@@ -0,0 +1,100 @@
+#pragma once
+#include "Prerequisites.h"
+#include "TrackGrid.h"
+#include <cstdint>
+
+/*
+  Clase FlowField
+  - Un campo de direcciones por checkpoint sobre la rejilla del circuito (TrackGrid): cada celda
+    guarda hacia dnde conducir para llegar a ese checkpoint por el camino ms corto.
+  - Se hornea fuera del juego (--bake-flowfield): por cada checkpoint, Dijkstra desde sus celdas
+    calcula la distancia de cada celda por la pista (8 vecinos, las celdas fuera de la pista cuestan
+    offRoadCost veces ms), y la direccin de la celda es la bajada de esa distancia hacia sus vecinos.
+    Los checkpoints se calculan en paralelo, uno por tarea de un ThreadPool.
+  - Las celdas fuera de la pista tambin tienen direccin: llevan de vuelta al asfalto.
+  - En el juego, la direccin de un kart es una sola lectura de la tabla (getDirection), sin importar
+    cuntos karts compartan el mismo objetivo. Con miles de karts esto reemplaza la direccin por
+    waypoints (WaypointFollower::updateFlowField).
+  - Archivo .sflow: cabecera, checkpoints, rejilla y direcciones cuantizadas a 8 bits por eje.
+  En motores 3D, los flow fields se usan para multitudes en juegos de estrategia: el costo de la
+  bsqueda es por objetivo y no por unidad.
+*/
+class FlowField
+{
+public:
+    /*
+      Estructura BakeOptions.
+      - Parmetros del horneado (la clasificacin de la imagen est en grid).
+    */
+    struct BakeOptions
+    {
+        TrackGrid::Options grid;
+        float offRoadCost = 8.0f;       // Costo de cruzar una celda fuera de la pista (asfalto = 1).
+        float goalRadius = 24.0f;       // Distancia a la que un checkpoint se da por alcanzado.
+        unsigned int threadCount = 0;   // 0 = ver ThreadPool.
+    };
+
+    /*
+      Estructura Direction.
+      - Direccin normalizada, cuantizada a [-127, 127] por eje.
+    */
+    struct Direction
+    {
+        int8_t x = 0;
+        int8_t y = 0;
+    };
+
+    /*
+      Funcin bake.
+      - Construye la rejilla de image (estirada sobre worldBounds) y un campo por checkpoint.
+        Los checkpoints se recorren en orden y en bucle; tambin son las muestras de asfalto.
+    */
+    bool bake(const sf::Image& image, const sf::FloatRect& worldBounds,
+        const std::vector<sf::Vector2f>& checkpoints, const BakeOptions& options);
+
+    /*
+      Funcin bakeFile.
+      - Herramienta --bake-flowfield: lee la imagen imagePath, hornea el campo y lo guarda en
+        outputPath. Reporta en la consola la rejilla, los checkpoints y el tiempo del horneado.
+    */
+    static bool bakeFile(const std::string& imagePath, const std::string& outputPath, const sf::FloatRect& worldBounds,
+        const std::vector<sf::Vector2f>& checkpoints, const BakeOptions& options);
+
+    // Guarda el campo horneado en path (.sflow).
+    bool save(const std::string& path) const;
+
+    // Lee un campo de path. Si el archivo no es vlido, el campo queda vaco y devuelve false.
+    bool load(const std::string& path);
+
+    // Indica si hay un campo horneado o cargado.
+    bool isValid() const;
+
+    /*
+      Funcin getDirection.
+      - Direccin hacia el checkpoint desde position (una lectura de la tabla). Las posiciones fuera
+        de la rejilla usan la celda ms cercana del borde. Se define en la cabecera porque se llama
+        una vez por kart en cada tick.
+    */
+    sf::Vector2f getDirection(size_t checkpoint, const sf::Vector2f& position) const {
+        const Direction direction = m_directions[checkpoint * m_grid.getCellCount() + m_grid.indexAt(position)];
+        return sf::Vector2f(direction.x * (1.0f / 127.0f), direction.y * (1.0f / 127.0f));
+    }
+
+    // Distancia horneada (por la pista, con el costo fuera de ella) de la celda de position al checkpoint.
+    float getDistance(size_t checkpoint, const sf::Vector2f& position) const;
+
+    size_t getCheckpointCount() const;
+    const std::vector<sf::Vector2f>& getCheckpoints() const;
+    float getGoalRadius() const;
+    const TrackGrid& getGrid() const;
+
+private:
+    // Dijkstra desde el checkpoint y direcciones de su campo (puede correr en cualquier hilo).
+    void bakeCheckpoint(size_t checkpoint, float offRoadCost);
+
+    TrackGrid m_grid;
+    std::vector<sf::Vector2f> m_checkpoints;
+    float m_goalRadius = 24.0f;
+    std::vector<Direction> m_directions;    // Campo del checkpoint c en [c * celdas, (c + 1) * celdas).
+    std::vector<float> m_distances;         // Mismo orden que m_directions.
+};
@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+/*
+  Utilidades de hash.
+  - Implementan FNV-1a de 64 bits, un hash simple, rpido y estable entre ejecuciones y plataformas.
+  - Se usa para identificar recursos por su ruta (ResourceManager) sin tener que comparar cadenas completas.
+  En motores 3D, los identificadores de recursos suelen ser hashes de la ruta para poder guardarlos
+  en archivos empaquetados o enviarlos por red sin depender del texto original.
+*/
+namespace Hash
+{
+    // Valores estndar de FNV-1a de 64 bits.
+    constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+    constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+    /*
+      Funcin fnv1a64.
+      - Calcula el hash de un bloque de bytes.
+      - seed permite encadenar varios bloques en un mismo hash.
+    */
+    inline uint64_t fnv1a64(const void* data, size_t size, uint64_t seed = FNV_OFFSET_BASIS)
+    {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        uint64_t hash = seed;
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= FNV_PRIME;
+        }
+        return hash;
+    }
+
+    /*
+      Funcin hashPath.
+      - Calcula el hash de una ruta normalizando los separadores ('\' y '/'),
+        para que "a\b.png" y "a/b.png" produzcan el mismo identificador.
+    */
+    inline uint64_t hashPath(const std::string& path)
+    {
+        uint64_t hash = FNV_OFFSET_BASIS;
+        for (char c : path)
+        {
+            const unsigned char byte = static_cast<unsigned char>(c == '\\' ? '/' : c);
+            hash ^= byte;
+            hash *= FNV_PRIME;
+        }
+        return hash;
+    }
+}
@@ -0,0 +1,364 @@
+#include "InputRecorder.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+
+namespace
+{
+    /*
+       Formato .sinput:
+       [InputHeader] y despus un registro por tick:
+       [flags u8][ratn: x i32, y i32][teclas: KEY_BYTES bytes][eventos: cantidad u8, eventos]
+       Cada parte despus de flags solo aparece si su bit est activo.
+    */
+    constexpr char INPUT_MAGIC[4] = { 'S', 'I', 'N', 'P' };
+    constexpr uint32_t INPUT_VERSION = 1;
+
+    constexpr uint8_t TICK_MOUSE = 1 << 0;
+    constexpr uint8_t TICK_KEYS = 1 << 1;
+    constexpr uint8_t TICK_EVENTS = 1 << 2;
+
+    constexpr size_t KEY_BYTES = (sf::Keyboard::KeyCount + 7) / 8;
+    constexpr size_t MAX_EVENTS_PER_TICK = 255;
+
+    struct InputHeader
+    {
+        char magic[4];
+        uint32_t version;
+        float tickRate;
+        uint32_t tickCount;     // Se completa al terminar la grabacin.
+        uint32_t keyCount;      // sf::Keyboard::KeyCount de la versin de SFML que grab.
+        uint32_t reserved;
+    };
+
+    static_assert(sizeof(InputHeader) == 24, "InputHeader debe ocupar 24 bytes");
+
+    template<typename T>
+    void put(std::vector<uint8_t>& out, T value) {
+        const size_t offset = out.size();
+        out.resize(offset + sizeof(T));
+        std::memcpy(out.data() + offset, &value, sizeof(T));
+    }
+
+    template<typename T>
+    bool get(const std::vector<uint8_t>& in, size_t& offset, T& value) {
+        if (offset + sizeof(T) > in.size()) {
+            return false;
+        }
+        std::memcpy(&value, in.data() + offset, sizeof(T));
+        offset += sizeof(T);
+        return true;
+    }
+
+    // Solo se graban los eventos que describen entrada o cambios de la ventana.
+    bool isRecordedEvent(sf::Event::EventType type) {
+        switch (type) {
+        case sf::Event::Closed:
+        case sf::Event::Resized:
+        case sf::Event::LostFocus:
+        case sf::Event::GainedFocus:
+        case sf::Event::TextEntered:
+        case sf::Event::KeyPressed:
+        case sf::Event::KeyReleased:
+        case sf::Event::MouseWheelScrolled:
+        case sf::Event::MouseButtonPressed:
+        case sf::Event::MouseButtonReleased:
+        case sf::Event::MouseEntered:
+        case sf::Event::MouseLeft:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Escribe el tipo del evento y solo los campos que usa ese tipo.
+    void writeEvent(std::vector<uint8_t>& out, const sf::Event& event) {
+        put<uint8_t>(out, static_cast<uint8_t>(event.type));
+        switch (event.type) {
+        case sf::Event::Resized:
+            put<uint32_t>(out, event.size.width);
+            put<uint32_t>(out, event.size.height);
+            break;
+        case sf::Event::TextEntered:
+            put<uint32_t>(out, event.text.unicode);
+            break;
+        case sf::Event::KeyPressed:
+        case sf::Event::KeyReleased:
+            put<int32_t>(out, event.key.code);
+            put<uint8_t>(out, static_cast<uint8_t>((event.key.alt ? 1 : 0) | (event.key.control ? 2 : 0)
+                | (event.key.shift ? 4 : 0) | (event.key.system ? 8 : 0)));
+            break;
+        case sf::Event::MouseWheelScrolled:
+            put<int32_t>(out, event.mouseWheelScroll.wheel);
+            put<float>(out, event.mouseWheelScroll.delta);
+            put<int32_t>(out, event.mouseWheelScroll.x);
+            put<int32_t>(out, event.mouseWheelScroll.y);
+            break;
+        case sf::Event::MouseButtonPressed:
+        case sf::Event::MouseButtonReleased:
+            put<int32_t>(out, event.mouseButton.button);
+            put<int32_t>(out, event.mouseButton.x);
+            put<int32_t>(out, event.mouseButton.y);
+            break;
+        default:
+            break;
+        }
+    }
+
+    bool readEvent(const std::vector<uint8_t>& in, size_t& offset, sf::Event& event) {
+        uint8_t type = 0;
+        if (!get(in, offset, type) || type >= sf::Event::Count) {
+            return false;
+        }
+        event = sf::Event();
+        event.type = static_cast<sf::Event::EventType>(type);
+
+        int32_t a = 0, b = 0, c = 0;
+        switch (event.type) {
+        case sf::Event::Resized:
+            return get(in, offset, event.size.width) && get(in, offset, event.size.height);
+        case sf::Event::TextEntered:
+            return get(in, offset, event.text.unicode);
+        case sf::Event::KeyPressed:
+        case sf::Event::KeyReleased: {
+            uint8_t modifiers = 0;
+            if (!get(in, offset, a) || !get(in, offset, modifiers)) {
+                return false;
+            }
+            event.key.code = static_cast<sf::Keyboard::Key>(a);
+            event.key.scancode = sf::Keyboard::Scan::Unknown;
+            event.key.alt = (modifiers & 1) != 0;
+            event.key.control = (modifiers & 2) != 0;
+            event.key.shift = (modifiers & 4) != 0;
+            event.key.system = (modifiers & 8) != 0;
+            return true;
+        }
+        case sf::Event::MouseWheelScrolled:
+            if (!get(in, offset, a) || !get(in, offset, event.mouseWheelScroll.delta) || !get(in, offset, b) || !get(in, offset, c)) {
+                return false;
+            }
+            event.mouseWheelScroll.wheel = static_cast<sf::Mouse::Wheel>(a);
+            event.mouseWheelScroll.x = b;
+            event.mouseWheelScroll.y = c;
+            return true;
+        case sf::Event::MouseButtonPressed:
+        case sf::Event::MouseButtonReleased:
+            if (!get(in, offset, a) || !get(in, offset, b) || !get(in, offset, c)) {
+                return false;
+            }
+            event.mouseButton.button = static_cast<sf::Mouse::Button>(a);
+            event.mouseButton.x = b;
+            event.mouseButton.y = c;
+            return true;
+        default:
+            return isRecordedEvent(event.type);
+        }
+    }
+}
+
+/*
+   Las teclas se siguen con los eventos en lugar de consultar sf::Keyboard en cada frame.
+   Al perder el foco la ventana deja de recibir KeyReleased, as que se sueltan todas.
+*/
+void InputState::applyEvent(const sf::Event& event) {
+    if (event.type == sf::Event::KeyPressed && event.key.code >= 0 && event.key.code < sf::Keyboard::KeyCount) {
+        keys.set(event.key.code);
+    }
+    else if (event.type == sf::Event::KeyReleased && event.key.code >= 0 && event.key.code < sf::Keyboard::KeyCount) {
+        keys.reset(event.key.code);
+    }
+    else if (event.type == sf::Event::LostFocus) {
+        keys.reset();
+    }
+
+    if (isRecordedEvent(event.type)) {
+        events.push_back(event);
+    }
+}
+
+bool InputState::isKeyPressed(sf::Keyboard::Key key) const {
+    return key >= 0 && key < sf::Keyboard::KeyCount && keys.test(key);
+}
+
+InputRecorder::~InputRecorder() {
+    stop();
+}
+
+/*
+   Crea el archivo de la grabacin. El nmero de ticks se deja en 0 hasta que termine.
+*/
+bool InputRecorder::startRecording(const std::string& path, float tickRate) {
+    stop();
+    m_out.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_out) {
+        LOG_ERROR("InputRecorder", "startRecording", "no se pudo crear [{}]", path);
+        return false;
+    }
+
+    InputHeader header{};
+    std::memcpy(header.magic, INPUT_MAGIC, sizeof(INPUT_MAGIC));
+    header.version = INPUT_VERSION;
+    header.tickRate = tickRate;
+    header.keyCount = sf::Keyboard::KeyCount;
+    m_out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    m_last = InputState();
+    m_tickRate = tickRate;
+    m_tick = 0;
+    m_recording = true;
+    return true;
+}
+
+/*
+   Carga la grabacin y valida la cabecera. Los ticks se decodifican uno a uno en next().
+*/
+bool InputRecorder::startReplay(const std::string& path) {
+    stop();
+    std::ifstream in(path, std::ios::binary);
+    InputHeader header{};
+    in.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!in || std::memcmp(header.magic, INPUT_MAGIC, sizeof(INPUT_MAGIC)) != 0 || header.version != INPUT_VERSION
+        || header.keyCount != sf::Keyboard::KeyCount || !(header.tickRate > 0.0f)) {
+        LOG_ERROR("InputRecorder", "startReplay", "archivo no valido [{}]", path);
+        return false;
+    }
+
+    m_data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    m_readOffset = 0;
+    m_last = InputState();
+    m_tickRate = header.tickRate;
+    m_tickCount = header.tickCount;
+    m_tick = 0;
+    m_replaying = true;
+    return true;
+}
+
+/*
+   Al cerrar una grabacin se completa la cabecera con el nmero de ticks.
+*/
+void InputRecorder::stop() {
+    if (m_recording) {
+        m_out.seekp(offsetof(InputHeader, tickCount));
+        m_out.write(reinterpret_cast<const char*>(&m_tick), sizeof(m_tick));
+        m_out.close();
+        m_recording = false;
+        m_tickCount = m_tick;
+    }
+    if (m_replaying) {
+        m_data.clear();
+        m_data.shrink_to_fit();
+        m_replaying = false;
+    }
+}
+
+/*
+   Codifica solo lo que cambi desde el tick anterior.
+*/
+void InputRecorder::record(const InputState& input) {
+    if (!m_recording) {
+        return;
+    }
+
+    uint8_t flags = 0;
+    if (input.mousePosition != m_last.mousePosition) flags |= TICK_MOUSE;
+    if (input.keys != m_last.keys) flags |= TICK_KEYS;
+    if (!input.events.empty()) flags |= TICK_EVENTS;
+
+    m_scratch.clear();
+    put<uint8_t>(m_scratch, flags);
+    if (flags & TICK_MOUSE) {
+        put<int32_t>(m_scratch, input.mousePosition.x);
+        put<int32_t>(m_scratch, input.mousePosition.y);
+    }
+    if (flags & TICK_KEYS) {
+        uint8_t bytes[KEY_BYTES] = {};
+        for (size_t key = 0; key < input.keys.size(); ++key) {
+            if (input.keys.test(key)) {
+                bytes[key / 8] |= static_cast<uint8_t>(1 << (key % 8));
+            }
+        }
+        m_scratch.insert(m_scratch.end(), bytes, bytes + KEY_BYTES);
+    }
+    if (flags & TICK_EVENTS) {
+        // Ms de 255 eventos en un tick solo ocurre si la simulacin estuvo detenida; el resto se descarta.
+        const size_t count = std::min(input.events.size(), MAX_EVENTS_PER_TICK);
+        put<uint8_t>(m_scratch, static_cast<uint8_t>(count));
+        for (size_t i = 0; i < count; ++i) {
+            writeEvent(m_scratch, input.events[i]);
+        }
+    }
+
+    m_out.write(reinterpret_cast<const char*>(m_scratch.data()), static_cast<std::streamsize>(m_scratch.size()));
+    m_last.mousePosition = input.mousePosition;
+    m_last.keys = input.keys;
+    ++m_tick;
+}
+
+/*
+   Decodifica el siguiente tick. Lo que no aparece en el registro conserva el valor del tick anterior.
+*/
+bool InputRecorder::next(InputState& input) {
+    if (!m_replaying || m_readOffset >= m_data.size()) {
+        return false;
+    }
+
+    size_t offset = m_readOffset;
+    uint8_t flags = 0;
+    InputState decoded = m_last;
+    decoded.events.clear();
+
+    bool valid = get(m_data, offset, flags);
+    if (valid && (flags & TICK_MOUSE)) {
+        valid = get(m_data, offset, decoded.mousePosition.x) && get(m_data, offset, decoded.mousePosition.y);
+    }
+    if (valid && (flags & TICK_KEYS)) {
+        valid = offset + KEY_BYTES <= m_data.size();
+        for (size_t key = 0; valid && key < decoded.keys.size(); ++key) {
+            decoded.keys.set(key, (m_data[offset + key / 8] >> (key % 8)) & 1);
+        }
+        offset += KEY_BYTES;
+    }
+    if (valid && (flags & TICK_EVENTS)) {
+        uint8_t count = 0;
+        valid = get(m_data, offset, count);
+        for (uint8_t i = 0; valid && i < count; ++i) {
+            sf::Event event;
+            valid = readEvent(m_data, offset, event);
+            decoded.events.push_back(event);
+        }
+    }
+
+    if (!valid) {
+        LOG_ERROR("InputRecorder", "next", "grabacion truncada en el tick {}", m_tick);
+        m_readOffset = m_data.size();
+        return false;
+    }
+
+    m_readOffset = offset;
+    m_last.mousePosition = decoded.mousePosition;
+    m_last.keys = decoded.keys;
+    input = std::move(decoded);
+    ++m_tick;
+    return true;
+}
+
+bool InputRecorder::isRecording() const {
+    return m_recording;
+}
+
+bool InputRecorder::isReplaying() const {
+    return m_replaying;
+}
+
+float InputRecorder::getTickRate() const {
+    return m_tickRate;
+}
+
+uint32_t InputRecorder::getTick() const {
+    return m_tick;
+}
+
+uint32_t InputRecorder::getTickCount() const {
+    return m_tickCount;
+}
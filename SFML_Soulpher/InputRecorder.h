@@ -0,0 +1,100 @@
+#pragma once
+#include "Prerequisites.h"
+#include <bitset>
+#include <cstdint>
+#include <fstream>
+
+/*
+  Estructura InputState
+  - Entrada que recibe la simulacin en un tick: posicin del ratn, teclas presionadas y los
+    eventos de ventana que llegaron desde el tick anterior.
+  - La simulacin solo debe leer la entrada desde aqu (nunca sf::Mouse o sf::Keyboard directamente),
+    as el mismo tick se comporta igual en vivo y al reproducir una grabacin.
+*/
+struct InputState
+{
+    sf::Vector2i mousePosition;                       // Coordenadas de la ventana.
+    std::bitset<sf::Keyboard::KeyCount> keys;         // Teclas presionadas.
+    std::vector<sf::Event> events;                    // Eventos del tick (sin MouseMoved).
+
+    /*
+      Funcin applyEvent.
+      - Actualiza las teclas con un evento de la ventana y lo agrega a la lista de eventos.
+      - MouseMoved se ignora: la posicin del ratn ya se guarda en cada tick.
+    */
+    void applyEvent(const sf::Event& event);
+
+    // Indica si la tecla est presionada en este tick.
+    bool isKeyPressed(sf::Keyboard::Key key) const;
+};
+
+/*
+  Clase InputRecorder
+  - Graba la entrada de cada tick en un archivo binario compacto (.sinput) y la reproduce tick a tick.
+  - Cada tick ocupa un byte si nada cambi; el ratn y las teclas solo se escriben cuando cambian,
+    y los eventos solo cuando los hay.
+  - La grabacin guarda la frecuencia de la simulacin: al reproducir con la misma frecuencia y el
+    mismo estado inicial, cada tick recibe exactamente la misma entrada y la simulacin es reproducible.
+  En motores 3D, grabar la entrada en lugar del estado es la base de las repeticiones, de las pruebas
+  automticas y de las cargas de trabajo repetibles para medir rendimiento.
+*/
+class InputRecorder
+{
+public:
+    InputRecorder() = default;
+
+    // Destructor. Cierra la grabacin en curso.
+    ~InputRecorder();
+
+    InputRecorder(const InputRecorder&) = delete;
+    InputRecorder& operator=(const InputRecorder&) = delete;
+
+    /*
+      Funcin startRecording.
+      - Crea el archivo y escribe la cabecera. tickRate se guarda para reproducir a la misma frecuencia.
+    */
+    bool startRecording(const std::string& path, float tickRate);
+
+    /*
+      Funcin startReplay.
+      - Lee la grabacin completa en memoria para no tocar el disco durante la reproduccin.
+    */
+    bool startReplay(const std::string& path);
+
+    // Termina la grabacin (escribe el nmero de ticks en la cabecera) o la reproduccin.
+    void stop();
+
+    // Agrega la entrada de un tick a la grabacin.
+    void record(const InputState& input);
+
+    /*
+      Funcin next.
+      - Escribe en input la entrada del siguiente tick grabado.
+      - Devuelve false cuando la grabacin termin.
+    */
+    bool next(InputState& input);
+
+    bool isRecording() const;
+    bool isReplaying() const;
+
+    // Frecuencia de la simulacin con la que se grab (o se est grabando).
+    float getTickRate() const;
+
+    // Ticks grabados o reproducidos hasta ahora.
+    uint32_t getTick() const;
+
+    // Ticks totales de la grabacin que se reproduce.
+    uint32_t getTickCount() const;
+
+private:
+    std::ofstream m_out;                // Archivo de la grabacin en curso.
+    std::vector<uint8_t> m_scratch;     // Tick codificado antes de escribirlo.
+    std::vector<uint8_t> m_data;        // Grabacin que se reproduce.
+    size_t m_readOffset = 0;
+    InputState m_last;                  // ltimo estado escrito o ledo (para codificar los cambios).
+    float m_tickRate = 60.0f;
+    uint32_t m_tick = 0;
+    uint32_t m_tickCount = 0;
+    bool m_recording = false;
+    bool m_replaying = false;
+};
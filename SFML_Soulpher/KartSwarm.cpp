@@ -0,0 +1,152 @@
+#include "KartSwarm.h"
+#include "AllocationTracker.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+namespace
+{
+    using SwarmClock = std::chrono::steady_clock;
+
+    double elapsedMs(SwarmClock::time_point start) {
+        return std::chrono::duration<double, std::milli>(SwarmClock::now() - start).count();
+    }
+
+    constexpr float BASE_SPEED = 150.0f;     // Velocidad del kart principal (BaseApp::updateMovement).
+}
+
+/*
+   Cada kart empieza en un punto al azar de algn tramo de la ruta, desplazado unos pxeles,
+   y se dirige al waypoint que cierra ese tramo.
+*/
+void KartSwarm::spawn(size_t count, const std::vector<sf::Vector2f>& waypoints, uint32_t seed) {
+    clear();
+    if (waypoints.empty()) {
+        return;
+    }
+    m_follower.setWaypoints(waypoints);
+
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<size_t> segment(0, waypoints.size() - 1);
+    std::uniform_real_distribution<float> along(0.0f, 1.0f);
+    std::uniform_real_distribution<float> jitter(-8.0f, 8.0f);
+    std::uniform_real_distribution<float> speed(0.8f, 1.2f);
+
+    const AllocationTracker::Snapshot before = AllocationTracker::getSnapshot();
+    m_karts.reserve(count);
+    m_shapes.reserve(count);
+    m_follower.reserve(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        const size_t from = segment(random);
+        const size_t to = (from + 1) % waypoints.size();
+        const sf::Vector2f start = waypoints[from] + (waypoints[to] - waypoints[from]) * along(random)
+            + sf::Vector2f(jitter(random), jitter(random));
+
+        EngineUtilities::TSharedPointer<Actor> kart = EngineUtilities::MakeShared<Actor>("Kart");
+        ShapeFactory* shape = kart->getComponent<ShapeFactory>().get();
+        shape->createShape(ShapeType::CIRCLE);
+
+        m_follower.add(start, BASE_SPEED * speed(random), static_cast<uint32_t>(to));
+        m_shapes.push_back(shape);
+        m_karts.push_back(kart);
+    }
+
+    const AllocationTracker::Snapshot spawned = AllocationTracker::getSnapshot() - before;
+    m_stats = Stats();
+    m_stats.count = count;
+    m_stats.bytesPerKart = count > 0 ? static_cast<double>(spawned.bytes) / count : 0.0;
+}
+
+void KartSwarm::clear() {
+    m_follower.clear();
+    m_shapes.clear();
+    m_karts.clear();
+    m_stats = Stats();
+}
+
+void KartSwarm::setTexture(const sf::Texture* texture, bool resetRect) {
+    for (auto& kart : m_karts) {
+        kart->getComponent<ShapeFactory>()->setTexture(texture, resetRect);
+    }
+}
+
+/*
+   Misma regla que el kart principal: avanzar hacia el waypoint y pasar al siguiente al llegar.
+   Con un flow field, la direccin sale del campo del checkpoint en lugar de apuntar al waypoint.
+*/
+void KartSwarm::update(float deltaTime) {
+    PROFILE_SCOPE("KartSwarm::update");
+    const AllocationTracker::Snapshot before = AllocationTracker::getSnapshot();
+    const auto start = SwarmClock::now();
+
+    if (m_flowField != nullptr) {
+        m_follower.updateFlowField(*m_flowField, deltaTime);
+    }
+    else {
+        m_follower.update(deltaTime);
+    }
+
+    m_stats.updateMs = elapsedMs(start);
+    m_stats.updateAllocations = (AllocationTracker::getSnapshot() - before).allocations;
+}
+
+void KartSwarm::prepareRender(RenderCommandBuffer& commands, float pixelsPerUnit, float alpha) {
+    PROFILE_SCOPE("KartSwarm::prepareRender");
+    const AllocationTracker::Snapshot before = AllocationTracker::getSnapshot();
+    const auto start = SwarmClock::now();
+
+    for (size_t i = 0; i < m_shapes.size(); ++i) {
+        m_shapes[i]->setPosition(m_follower.getInterpolatedPosition(i, alpha));
+        m_shapes[i]->record(commands, pixelsPerUnit);
+    }
+
+    m_stats.renderPrepMs = elapsedMs(start);
+    m_stats.renderAllocations = (AllocationTracker::getSnapshot() - before).allocations;
+}
+
+size_t KartSwarm::getCount() const {
+    return m_karts.size();
+}
+
+const KartSwarm::Stats& KartSwarm::getStats() const {
+    return m_stats;
+}
+
+/*
+   Solo ordena los count primeros: con un milln de karts, el costo lo pone la proyeccin y no el
+   orden completo.
+*/
+void KartSwarm::rankByProgress(const RacingLine& line, size_t count, std::vector<Ranked>& leaders) {
+    PROFILE_SCOPE("KartSwarm::rankByProgress");
+    const auto start = SwarmClock::now();
+    leaders.clear();
+    if (!line.isValid()) {
+        return;
+    }
+
+    m_ranking.resize(m_follower.getCount());
+    for (size_t i = 0; i < m_ranking.size(); ++i) {
+        m_ranking[i].kart = i;
+        m_ranking[i].progress = line.project(m_follower.getPosition(i));
+    }
+    count = std::min(count, m_ranking.size());
+    std::partial_sort(m_ranking.begin(), m_ranking.begin() + count, m_ranking.end(),
+        [](const Ranked& a, const Ranked& b) { return a.progress > b.progress; });
+    leaders.assign(m_ranking.begin(), m_ranking.begin() + count);
+
+    m_stats.rankMs = elapsedMs(start);
+}
+
+void KartSwarm::setFlowField(const FlowField* field) {
+    m_flowField = field != nullptr && field->isValid() ? field : nullptr;
+}
+
+const FlowField* KartSwarm::getFlowField() const {
+    return m_flowField;
+}
+
+WaypointFollower& KartSwarm::getFollower() {
+    return m_follower;
+}
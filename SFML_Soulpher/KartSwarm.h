@@ -0,0 +1,102 @@
+#pragma once
+#include "Prerequisites.h"
+#include "Actor.h"
+#include "RenderCommandBuffer.h"
+#include "WaypointFollower.h"
+#include "FlowField.h"
+#include "RacingLine.h"
+
+/*
+  Clase KartSwarm
+  - Escena de estrs: N karts (de 1 a 1,000,000) repartidos por el circuito, cada uno siguiendo
+    los waypoints con su propia velocidad (150 px/s con una variacin de +-20 %).
+  - Cada kart es un Actor completo (ShapeFactory), as la escena mide el costo real del sistema de
+    componentes al dibujar N formas.
+  - update() es la simulacin: todos los karts avanzan juntos en un WaypointFollower (SoA con
+    kernels SIMD); la posicin de los karts vive ah y no en su Transform. prepareRender() interpola
+    y graba los comandos de dibujo en un RenderCommandBuffer, sin necesitar ventana. Ambas miden su
+    tiempo y sus reservas.
+  En motores 3D, una escena de estrs que escala la cantidad de objetos muestra en qu N el costo
+  por objeto deja de ser constante (cachs, reservas de memoria, estructuras que no escalan).
+*/
+class KartSwarm
+{
+public:
+    /*
+      Estructura Stats.
+      - Mediciones de la ltima llamada a update() y a prepareRender().
+    */
+    struct Stats
+    {
+        size_t count = 0;
+        double updateMs = 0.0;
+        double renderPrepMs = 0.0;
+        double bytesPerKart = 0.0;          // Bytes pedidos al crear los karts, entre N.
+        uint64_t updateAllocations = 0;
+        uint64_t renderAllocations = 0;
+        double rankMs = 0.0;                // ltima llamada a rankByProgress().
+    };
+
+    /*
+      Estructura Ranked.
+      - Un kart de la clasificacin y su progreso en la vuelta, en unidades de la lnea de carrera.
+    */
+    struct Ranked
+    {
+        size_t kart = 0;
+        float progress = 0.0f;
+    };
+
+    /*
+      Funcin spawn.
+      - Reemplaza la escena por count karts sobre la ruta de waypoints. Con la misma semilla,
+        la escena es siempre la misma.
+    */
+    void spawn(size_t count, const std::vector<sf::Vector2f>& waypoints, uint32_t seed = 1234);
+
+    // Elimina todos los karts.
+    void clear();
+
+    // Textura de todos los karts (misma regla que ShapeFactory::setTexture).
+    void setTexture(const sf::Texture* texture, bool resetRect = false);
+
+    // Avanza la simulacin un tick.
+    void update(float deltaTime);
+
+    /*
+      Funcin prepareRender.
+      - Coloca cada forma interpolando con alpha y graba su comando en commands (que no se vaca).
+    */
+    void prepareRender(RenderCommandBuffer& commands, float pixelsPerUnit, float alpha);
+
+    size_t getCount() const;
+    const Stats& getStats() const;
+
+    /*
+      Funcin rankByProgress.
+      - Proyecta cada kart sobre line (O(log n) por kart, sin buscar entre los waypoints) y deja en
+        leaders los count karts ms adelantados en la vuelta, de mayor a menor progreso.
+        leaders conserva su capacidad entre llamadas.
+    */
+    void rankByProgress(const RacingLine& line, size_t count, std::vector<Ranked>& leaders);
+
+    /*
+      Funcin setFlowField.
+      - Con un campo vlido, update() conduce a los karts con l en lugar de los waypoints. La escena
+        debe crearse con spawn(n, field->getCheckpoints()) para que los ndices coincidan.
+        nullptr vuelve a los waypoints. El campo debe vivir mientras la escena lo use.
+    */
+    void setFlowField(const FlowField* field);
+    const FlowField* getFlowField() const;
+
+    // Simulacin de todos los karts (por ejemplo, para elegir el kernel).
+    WaypointFollower& getFollower();
+
+private:
+    std::vector<EngineUtilities::TSharedPointer<Actor>> m_karts;
+    std::vector<ShapeFactory*> m_shapes;    // Forma de cada kart, en el mismo orden que el simulador.
+    WaypointFollower m_follower;
+    const FlowField* m_flowField = nullptr;
+    std::vector<Ranked> m_ranking;          // Progreso de todos los karts, reutilizado por rankByProgress().
+    Stats m_stats;
+};
@@ -0,0 +1,228 @@
+#include "Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace
+{
+    const std::chrono::steady_clock::time_point s_epoch = std::chrono::steady_clock::now();
+
+    thread_local LogThreadBuffer* t_buffer = nullptr;
+
+    const char* levelName(LogLevel level) {
+        switch (level) {
+        case LogLevel::Trace: return "TRACE";
+        case LogLevel::Debug: return "DEBUG";
+        case LogLevel::Info: return "INFO ";
+        case LogLevel::Warning: return "WARN ";
+        case LogLevel::Error: return "ERROR";
+        case LogLevel::Fatal: return "FATAL";
+        }
+        return "?    ";
+    }
+}
+
+LogThreadBuffer::LogThreadBuffer(uint16_t index)
+    : m_records(new LogRecord[CAPACITY]), m_index(index) {
+}
+
+// El productor solo escribe en ranuras que el consumidor ya ley.
+LogRecord* LogThreadBuffer::beginWrite() {
+    const size_t head = m_head.load(std::memory_order_relaxed);
+    if (head - m_tail.load(std::memory_order_acquire) >= CAPACITY) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    return &m_records[head % CAPACITY];
+}
+
+// La escritura de m_head con release publica el mensaje completo.
+void LogThreadBuffer::commit() {
+    m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+void LogThreadBuffer::drain(std::vector<LogRecord>& out) {
+    const size_t tail = m_tail.load(std::memory_order_relaxed);
+    const size_t head = m_head.load(std::memory_order_acquire);
+    for (size_t i = tail; i != head; ++i) {
+        out.push_back(m_records[i % CAPACITY]);
+    }
+    m_tail.store(head, std::memory_order_release);
+}
+
+uint16_t LogThreadBuffer::getIndex() const {
+    return m_index;
+}
+
+uint64_t LogThreadBuffer::takeDropped() {
+    return m_dropped.exchange(0, std::memory_order_relaxed);
+}
+
+// Constructor. Arranca el hilo que da formato y escribe.
+Logger::Logger() {
+    m_drained.reserve(1024);
+    m_thread = std::thread(&Logger::backgroundLoop, this);
+}
+
+// Destructor. Detiene el hilo de fondo y escribe lo que qued pendiente.
+Logger::~Logger() {
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    drainAndWrite();
+}
+
+Logger& Logger::getInstance() {
+    static Logger instance;
+    return instance;
+}
+
+uint64_t Logger::now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - s_epoch).count());
+}
+
+// Solo la primera llamada de cada hilo toma el candado.
+LogThreadBuffer& Logger::getThreadBuffer() {
+    if (t_buffer == nullptr) {
+        t_buffer = &getInstance().registerThread();
+    }
+    return *t_buffer;
+}
+
+// Las colas no se liberan al terminar su hilo: el hilo de fondo podra estar leyndolas.
+LogThreadBuffer& Logger::registerThread() {
+    std::lock_guard<std::mutex> lock(m_threadsMutex);
+    const uint16_t index = static_cast<uint16_t>(m_threads.size());
+    m_threads.push_back(std::make_unique<LogThreadBuffer>(index));
+    return *m_threads.back();
+}
+
+void Logger::flush() {
+    drainAndWrite();
+}
+
+// Abre (o cierra, con path vaco) el archivo de log.
+bool Logger::setFile(const std::string& path) {
+    std::lock_guard<std::mutex> lock(m_outputMutex);
+    m_file.reset();
+    if (path.empty()) {
+        return true;
+    }
+    m_file.reset(std::fopen(path.c_str(), "w"));
+    if (!m_file) {
+        std::cerr << "Logger::setFile : no se pudo abrir [" << path << "]\n";
+        return false;
+    }
+    return true;
+}
+
+void Logger::wake() {
+    m_wake.notify_one();
+}
+
+/*
+   Los productores no avisan en cada mensaje (despertar a otro hilo cuesta ms que escribir el
+   mensaje), as que el hilo de fondo revisa las colas cada FLUSH_INTERVAL_MS milisegundos.
+*/
+void Logger::backgroundLoop() {
+    std::unique_lock<std::mutex> lock(m_wakeMutex);
+    while (!m_stopping) {
+        m_wake.wait_for(lock, std::chrono::milliseconds(FLUSH_INTERVAL_MS));
+        lock.unlock();
+        drainAndWrite();
+        lock.lock();
+    }
+}
+
+/*
+   Junta los mensajes de todos los hilos y los ordena por hora, para que el log se lea en el
+   orden en que ocurrieron aunque vengan de colas distintas.
+*/
+void Logger::drainAndWrite() {
+    std::lock_guard<std::mutex> outputLock(m_outputMutex);
+    m_drained.clear();
+    uint64_t dropped = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_threadsMutex);
+        for (auto& thread : m_threads) {
+            thread->drain(m_drained);
+            dropped += thread->takeDropped();
+        }
+    }
+    if (m_drained.empty() && dropped == 0) {
+        return;
+    }
+
+    std::stable_sort(m_drained.begin(), m_drained.end(),
+        [](const LogRecord& a, const LogRecord& b) { return a.time < b.time; });
+
+    m_line.clear();
+    for (const LogRecord& record : m_drained) {
+        format(record, m_line);
+    }
+    if (dropped > 0) {
+        m_line += "Logger : " + std::to_string(dropped) + " mensajes descartados (cola llena)\n";
+    }
+
+    std::cerr << m_line;
+    std::cerr.flush();
+    if (m_file) {
+        std::fwrite(m_line.data(), 1, m_line.size(), m_file.get());
+        std::fflush(m_file.get());
+    }
+}
+
+/*
+   "[   1.234567] INFO  [t0] Clase::metodo : mensaje". Cada {} del formato se reemplaza por el
+   siguiente argumento; los {} sin argumento se dejan como estn.
+*/
+void Logger::format(const LogRecord& record, std::string& out) const {
+    const LogSite& site = *record.site;
+    char prefix[64];
+    std::snprintf(prefix, sizeof(prefix), "[%11.6f] %s [t%u] ", record.time / 1e9, levelName(site.level),
+        static_cast<unsigned>(record.thread));
+    out += prefix;
+    out += site.classObj;
+    out += "::";
+    out += site.method;
+    out += " : ";
+
+    size_t arg = 0;
+    for (const char* c = site.format; *c != '\0'; ++c) {
+        if (c[0] != '{' || c[1] != '}' || arg >= record.argCount) {
+            out += *c;
+            continue;
+        }
+        ++c;
+
+        const LogRecord::Arg& value = record.args[arg];
+        char number[32];
+        switch (record.types[arg++]) {
+        case LogRecord::INT:
+            std::snprintf(number, sizeof(number), "%lld", static_cast<long long>(value.i));
+            out += number;
+            break;
+        case LogRecord::UINT:
+            std::snprintf(number, sizeof(number), "%llu", static_cast<unsigned long long>(value.u));
+            out += number;
+            break;
+        case LogRecord::DOUBLE:
+            std::snprintf(number, sizeof(number), "%g", value.d);
+            out += number;
+            break;
+        case LogRecord::BOOL:
+            out += value.u != 0 ? "true" : "false";
+            break;
+        case LogRecord::TEXT:
+            out.append(record.text + value.text.offset, value.text.length);
+            break;
+        }
+    }
+    out += '\n';
+}
@@ -0,0 +1,330 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/*
+  Nivel mnimo de los mensajes que se compilan (0 = TRACE ... 5 = FATAL).
+  Los mensajes por debajo de l desaparecen por completo: ni sus argumentos se evalan.
+  Por defecto, Debug compila desde DEBUG y Release desde INFO. Se puede fijar en el proyecto
+  (por ejemplo SOULPHER_LOG_MIN_LEVEL=3 para dejar solo advertencias y errores).
+*/
+#ifndef SOULPHER_LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define SOULPHER_LOG_MIN_LEVEL 2
+#else
+#define SOULPHER_LOG_MIN_LEVEL 1
+#endif
+#endif
+
+/*
+  Enumeracin LogLevel
+  - Gravedad de un mensaje. FATAL termina el programa despus de escribirlo.
+*/
+enum class LogLevel : uint8_t
+{
+    Trace = 0,
+    Debug = 1,
+    Info = 2,
+    Warning = 3,
+    Error = 4,
+    Fatal = 5,
+};
+
+/*
+  Estructura LogSite
+  - Datos fijos de un punto del cdigo que escribe en el log. Cada macro LOG_* crea uno esttico,
+    as que un mensaje solo guarda un puntero a l (el "id" del formato) en lugar de copiar el texto.
+  - format usa {} para cada argumento, en orden: "cargado {} ({} bytes)".
+*/
+struct LogSite
+{
+    LogLevel level;
+    const char* classObj;
+    const char* method;
+    const char* format;
+};
+
+/*
+  Estructura LogRecord
+  - Un mensaje sin formatear: su LogSite, el momento en que se escribi y hasta MAX_ARGS argumentos.
+  - Los nmeros se guardan tal cual; el texto (std::string, const char*) se copia a text, que se
+    trunca si no alcanza. El formato se arma despus, en el hilo del Logger.
+*/
+struct LogRecord
+{
+    static constexpr size_t MAX_ARGS = 6;
+    static constexpr size_t TEXT_SIZE = 80;
+
+    enum ArgType : uint8_t { INT, UINT, DOUBLE, BOOL, TEXT };
+
+    struct TextRange
+    {
+        uint16_t offset;
+        uint16_t length;
+    };
+
+    union Arg
+    {
+        int64_t i;
+        uint64_t u;
+        double d;
+        TextRange text;
+    };
+
+    const LogSite* site = nullptr;
+    uint64_t time = 0;           // Nanosegundos desde que arranc el Logger.
+    Arg args[MAX_ARGS];
+    ArgType types[MAX_ARGS];
+    uint8_t argCount = 0;
+    uint8_t textUsed = 0;
+    uint16_t thread = 0;
+    char text[TEXT_SIZE];
+};
+
+/*
+  Clase LogThreadBuffer
+  - Cola circular de mensajes de un solo hilo productor (el dueo) y un solo consumidor (el hilo
+    del Logger). Igual que ProfileThreadBuffer, no usa candados y descarta (contando) si se llena.
+  - El productor escribe directo en la ranura (beginWrite) y la publica con commit().
+*/
+class LogThreadBuffer
+{
+public:
+    explicit LogThreadBuffer(uint16_t index);
+
+    // (Productor) Ranura libre para el prximo mensaje, o nullptr si la cola est llena.
+    LogRecord* beginWrite();
+
+    // (Productor) Publica el mensaje escrito en la ranura de beginWrite.
+    void commit();
+
+    // (Consumidor) Copia a out todos los mensajes publicados.
+    void drain(std::vector<LogRecord>& out);
+
+    uint16_t getIndex() const;
+
+    // Mensajes descartados desde la ltima llamada (la cuenta vuelve a cero).
+    uint64_t takeDropped();
+
+private:
+    static constexpr size_t CAPACITY = 1 << 12;
+
+    std::unique_ptr<LogRecord[]> m_records;
+    std::atomic<size_t> m_head{ 0 };
+    std::atomic<size_t> m_tail{ 0 };
+    std::atomic<uint64_t> m_dropped{ 0 };
+    uint16_t m_index;
+};
+
+/*
+  Clase Logger
+  - Log asncrono. El hilo que escribe solo copia un LogRecord compacto (puntero al LogSite, hora
+    y argumentos) en su propia cola, sin candados ni reservas de memoria; un hilo de fondo vaca las
+    colas cada pocos milisegundos, ordena los mensajes por hora, les da formato y los escribe en
+    std::cerr (y en un archivo, si se configur).
+  - Los mensajes ERROR y FATAL despiertan al hilo de fondo; FATAL adems vaca el log al momento
+    y termina el programa, como la antigua macro ERROR.
+  - Se usa a travs de las macros LOG_TRACE ... LOG_FATAL.
+  En motores 3D, escribir a consola en el hilo de render puede costar ms que el frame entero;
+  separar la captura del formateo deja el costo en el hilo que escribe en unos nanosegundos.
+*/
+class Logger
+{
+public:
+    static Logger& getInstance();
+
+    // Nanosegundos desde que arranc el Logger (reloj monotnico).
+    static uint64_t now();
+
+    /*
+      Funcin getThreadBuffer.
+      - Cola del hilo actual; la primera llamada de cada hilo la registra (con candado).
+    */
+    static LogThreadBuffer& getThreadBuffer();
+
+    /*
+      Funcin write.
+      - Captura un mensaje. Si la cola del hilo est llena, el mensaje se descarta y se cuenta
+        (salvo ERROR y FATAL, que vacan las colas en el hilo que escribe).
+    */
+    template <typename... Args>
+    void write(const LogSite& site, const Args&... args);
+
+    /*
+      Funcin flush.
+      - Formatea y escribe al momento todo lo pendiente. La usa FATAL y el cierre de la aplicacin.
+    */
+    void flush();
+
+    /*
+      Funcin setFile.
+      - Adems de std::cerr, escribe el log en path (se sobrescribe). Con path vaco deja de hacerlo.
+    */
+    bool setFile(const std::string& path);
+
+    // Despierta al hilo de fondo (lo usan ERROR y FATAL para no esperar al siguiente ciclo).
+    void wake();
+
+    ~Logger();
+
+private:
+    Logger();
+
+    LogThreadBuffer& registerThread();
+    void backgroundLoop();
+
+    // Vaca las colas y escribe; el candado de salida garantiza un solo consumidor a la vez.
+    void drainAndWrite();
+    void format(const LogRecord& record, std::string& out) const;
+
+    static constexpr int FLUSH_INTERVAL_MS = 10;
+
+    std::mutex m_threadsMutex;                               // Protege el registro de hilos.
+    std::vector<std::unique_ptr<LogThreadBuffer>> m_threads;
+
+    std::mutex m_outputMutex;                                // Protege el vaciado y la salida.
+    std::vector<LogRecord> m_drained;
+    std::string m_line;
+    std::unique_ptr<std::FILE, int (*)(std::FILE*)> m_file{ nullptr, &std::fclose };
+
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wake;
+    bool m_stopping = false;
+    std::thread m_thread;
+};
+
+namespace LogDetail
+{
+    // Copia texto al final del registro; lo que no cabe se trunca.
+    inline void packText(LogRecord& record, LogRecord::Arg& arg, std::string_view value) {
+        const size_t length = std::min(value.size(), LogRecord::TEXT_SIZE - record.textUsed);
+        std::memcpy(record.text + record.textUsed, value.data(), length);
+        arg.text = { record.textUsed, static_cast<uint16_t>(length) };
+        record.textUsed = static_cast<uint8_t>(record.textUsed + length);
+    }
+
+    template <typename T>
+    void packArg(LogRecord& record, const T& value) {
+        if (record.argCount >= LogRecord::MAX_ARGS) {
+            return;
+        }
+        LogRecord::Arg& arg = record.args[record.argCount];
+        LogRecord::ArgType& type = record.types[record.argCount];
+        ++record.argCount;
+
+        if constexpr (std::is_same_v<T, bool>) {
+            type = LogRecord::BOOL;
+            arg.u = value ? 1 : 0;
+        }
+        else if constexpr (std::is_enum_v<T>) {
+            type = LogRecord::INT;
+            arg.i = static_cast<int64_t>(value);
+        }
+        else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            type = LogRecord::INT;
+            arg.i = value;
+        }
+        else if constexpr (std::is_integral_v<T>) {
+            type = LogRecord::UINT;
+            arg.u = value;
+        }
+        else if constexpr (std::is_floating_point_v<T>) {
+            type = LogRecord::DOUBLE;
+            arg.d = value;
+        }
+        else if constexpr (std::is_convertible_v<const T&, const char*>) {
+            type = LogRecord::TEXT;
+            const char* text = value;
+            packText(record, arg, text != nullptr ? std::string_view(text) : std::string_view("(null)"));
+        }
+        else {
+            type = LogRecord::TEXT;
+            packText(record, arg, std::string_view(value));
+        }
+    }
+}
+
+template <typename... Args>
+void Logger::write(const LogSite& site, const Args&... args) {
+    LogThreadBuffer& buffer = getThreadBuffer();
+    LogRecord* record = buffer.beginWrite();
+    if (record == nullptr && site.level >= LogLevel::Error) {
+        // Los errores no se descartan: se vacan las colas en este hilo y se vuelve a intentar.
+        flush();
+        record = buffer.beginWrite();
+    }
+    if (record == nullptr) {
+        return;
+    }
+    record->site = &site;
+    record->time = now();
+    record->argCount = 0;
+    record->textUsed = 0;
+    record->thread = buffer.getIndex();
+    (LogDetail::packArg(*record, args), ...);
+    buffer.commit();
+
+    if (site.level >= LogLevel::Error) {
+        wake();
+    }
+}
+
+/*
+  Macros de log: LOG_INFO("Clase", "metodo", "formato con {}", argumentos...).
+  Los niveles por debajo de SOULPHER_LOG_MIN_LEVEL se reemplazan por ((void)0).
+*/
+#define SOULPHER_LOG(level, classObj, method, format, ...)                          \
+    do {                                                                            \
+        static const LogSite soulpherLogSite_{ level, classObj, method, format };   \
+        Logger::getInstance().write(soulpherLogSite_, ##__VA_ARGS__);               \
+    } while (0)
+
+#if SOULPHER_LOG_MIN_LEVEL <= 0
+#define LOG_TRACE(classObj, method, ...) SOULPHER_LOG(LogLevel::Trace, classObj, method, __VA_ARGS__)
+#else
+#define LOG_TRACE(classObj, method, ...) ((void)0)
+#endif
+
+#if SOULPHER_LOG_MIN_LEVEL <= 1
+#define LOG_DEBUG(classObj, method, ...) SOULPHER_LOG(LogLevel::Debug, classObj, method, __VA_ARGS__)
+#else
+#define LOG_DEBUG(classObj, method, ...) ((void)0)
+#endif
+
+#if SOULPHER_LOG_MIN_LEVEL <= 2
+#define LOG_INFO(classObj, method, ...) SOULPHER_LOG(LogLevel::Info, classObj, method, __VA_ARGS__)
+#else
+#define LOG_INFO(classObj, method, ...) ((void)0)
+#endif
+
+#if SOULPHER_LOG_MIN_LEVEL <= 3
+#define LOG_WARN(classObj, method, ...) SOULPHER_LOG(LogLevel::Warning, classObj, method, __VA_ARGS__)
+#else
+#define LOG_WARN(classObj, method, ...) ((void)0)
+#endif
+
+#if SOULPHER_LOG_MIN_LEVEL <= 4
+#define LOG_ERROR(classObj, method, ...) SOULPHER_LOG(LogLevel::Error, classObj, method, __VA_ARGS__)
+#else
+#define LOG_ERROR(classObj, method, ...) ((void)0)
+#endif
+
+// FATAL nunca se elimina: escribe, vaca el log y termina el programa.
+#define LOG_FATAL(classObj, method, ...)                                            \
+    do {                                                                            \
+        SOULPHER_LOG(LogLevel::Fatal, classObj, method, __VA_ARGS__);               \
+        Logger::getInstance().flush();                                              \
+        std::exit(1);                                                               \
+    } while (0)
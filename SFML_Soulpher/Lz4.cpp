@@ -0,0 +1,165 @@
+#include "Lz4.h"
+#include <cstring>
+
+namespace
+{
+    constexpr size_t MIN_MATCH = 4;        // Longitud mnima de una copia.
+    constexpr size_t LAST_LITERALS = 5;    // Los ltimos 5 bytes de un bloque siempre son literales.
+    constexpr size_t MF_LIMIT = 12;        // Una copia no puede empezar en los ltimos 12 bytes.
+    constexpr size_t MAX_OFFSET = 65535;   // Distancia mxima de una copia.
+    constexpr unsigned int HASH_BITS = 12;
+
+    // Lee 4 bytes sin requisitos de alineacin.
+    inline uint32_t read32(const uint8_t* p) {
+        uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    // Hash multiplicativo de 4 bytes para la tabla de coincidencias.
+    inline uint32_t hash4(uint32_t sequence) {
+        return (sequence * 2654435761u) >> (32 - HASH_BITS);
+    }
+
+    // Escribe una longitud extendida (bytes de 255 seguidos del resto).
+    inline void writeLength(std::vector<uint8_t>& out, size_t length) {
+        while (length >= 255) {
+            out.push_back(255);
+            length -= 255;
+        }
+        out.push_back(static_cast<uint8_t>(length));
+    }
+
+    // Escribe una secuencia: token, literales y (si matchLength > 0) la copia.
+    void writeSequence(std::vector<uint8_t>& out, const uint8_t* literals, size_t literalLength,
+        size_t offset, size_t matchLength) {
+        const size_t matchCode = matchLength > 0 ? matchLength - MIN_MATCH : 0;
+        const uint8_t token = static_cast<uint8_t>(
+            ((literalLength >= 15 ? 15 : literalLength) << 4) | (matchCode >= 15 ? 15 : matchCode));
+        out.push_back(token);
+
+        if (literalLength >= 15) {
+            writeLength(out, literalLength - 15);
+        }
+        out.insert(out.end(), literals, literals + literalLength);
+
+        if (matchLength > 0) {
+            out.push_back(static_cast<uint8_t>(offset & 0xFF));
+            out.push_back(static_cast<uint8_t>(offset >> 8));
+            if (matchCode >= 15) {
+                writeLength(out, matchCode - 15);
+            }
+        }
+    }
+}
+
+size_t Lz4::compressBound(size_t inputSize) {
+    return inputSize + inputSize / 255 + 16;
+}
+
+/*
+   Compresor greedy: en cada posicin busca en la tabla hash la ltima aparicin de los
+   mismos 4 bytes; si est a menos de 64 KB se extiende la coincidencia y se emite una copia.
+*/
+std::vector<uint8_t> Lz4::compress(const uint8_t* input, size_t inputSize) {
+    std::vector<uint8_t> out;
+    out.reserve(compressBound(inputSize));
+
+    size_t anchor = 0;
+    if (inputSize > MF_LIMIT) {
+        std::vector<int64_t> table(size_t(1) << HASH_BITS, -1);
+        const size_t matchLimit = inputSize - LAST_LITERALS;
+        size_t ip = 0;
+
+        while (ip < inputSize - MF_LIMIT) {
+            const uint32_t sequence = read32(input + ip);
+            const uint32_t h = hash4(sequence);
+            const int64_t candidate = table[h];
+            table[h] = static_cast<int64_t>(ip);
+
+            if (candidate < 0 || ip - static_cast<size_t>(candidate) > MAX_OFFSET
+                || read32(input + candidate) != sequence) {
+                ++ip;
+                continue;
+            }
+
+            const size_t ref = static_cast<size_t>(candidate);
+            size_t length = MIN_MATCH;
+            while (ip + length < matchLimit && input[ref + length] == input[ip + length]) {
+                ++length;
+            }
+
+            writeSequence(out, input + anchor, ip - anchor, ip - ref, length);
+            ip += length;
+            anchor = ip;
+        }
+    }
+
+    // ltimos literales (sin copia).
+    writeSequence(out, input + anchor, inputSize - anchor, 0, 0);
+    return out;
+}
+
+/*
+   Descompresor con comprobacin de lmites en cada lectura y escritura.
+*/
+bool Lz4::decompress(const uint8_t* input, size_t inputSize, uint8_t* output, size_t outputSize) {
+    size_t ip = 0;
+    size_t op = 0;
+
+    while (ip < inputSize) {
+        const uint8_t token = input[ip++];
+
+        // Literales.
+        size_t literalLength = token >> 4;
+        if (literalLength == 15) {
+            uint8_t extra;
+            do {
+                if (ip >= inputSize) return false;
+                extra = input[ip++];
+                literalLength += extra;
+            } while (extra == 255);
+        }
+        if (literalLength > inputSize - ip || literalLength > outputSize - op) {
+            return false;
+        }
+        std::memcpy(output + op, input + ip, literalLength);
+        ip += literalLength;
+        op += literalLength;
+
+        // La ltima secuencia termina despus de los literales.
+        if (ip == inputSize) {
+            break;
+        }
+
+        // Copia.
+        if (inputSize - ip < 2) return false;
+        const size_t offset = static_cast<size_t>(input[ip]) | (static_cast<size_t>(input[ip + 1]) << 8);
+        ip += 2;
+        if (offset == 0 || offset > op) {
+            return false;
+        }
+
+        size_t matchLength = token & 0x0F;
+        if (matchLength == 15) {
+            uint8_t extra;
+            do {
+                if (ip >= inputSize) return false;
+                extra = input[ip++];
+                matchLength += extra;
+            } while (extra == 255);
+        }
+        matchLength += MIN_MATCH;
+        if (matchLength > outputSize - op) {
+            return false;
+        }
+
+        // Byte a byte, porque la copia puede solaparse con lo que se est escribiendo.
+        const uint8_t* source = output + op - offset;
+        for (size_t i = 0; i < matchLength; ++i) {
+            output[op + i] = source[i];
+        }
+        op += matchLength;
+    }
+    return op == outputSize;
+}
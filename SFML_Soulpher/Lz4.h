@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+/*
+  Compresin LZ4 (formato de bloque).
+  - Implementacin mnima y sin dependencias del formato de bloque de LZ4: secuencias de literales
+    seguidas de una copia (offset de 16 bits + longitud) dentro de los ltimos 64 KB.
+  - El compresor es "greedy" con una tabla hash de 4 bytes; comprime menos que la biblioteca oficial,
+    pero produce bloques compatibles con cualquier descompresor LZ4.
+  - La descompresin es muy rpida (solo copias de memoria), por eso se usa en los archivos empaquetados.
+*/
+namespace Lz4
+{
+    // Tamao mximo que puede ocupar un bloque comprimido de inputSize bytes (peor caso: datos incompresibles).
+    size_t compressBound(size_t inputSize);
+
+    /*
+      Funcin compress.
+      - Comprime input y devuelve el bloque resultante.
+    */
+    std::vector<uint8_t> compress(const uint8_t* input, size_t inputSize);
+
+    /*
+      Funcin decompress.
+      - Descomprime un bloque en output, que debe tener exactamente el tamao original.
+      - Devuelve false si el bloque est corrupto o no coincide con el tamao esperado.
+    */
+    bool decompress(const uint8_t* input, size_t inputSize, uint8_t* output, size_t outputSize);
+}
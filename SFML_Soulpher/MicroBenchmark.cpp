@@ -0,0 +1,149 @@
+#include "MicroBenchmark.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+const void* volatile MicroBenchmarkDetail::g_sink = nullptr;
+
+namespace
+{
+    // Valor de texto de "key":"value" en una lnea del JSON de resultados.
+    bool findString(const std::string& line, const std::string& key, std::string& value) {
+        const std::string pattern = "\"" + key + "\":\"";
+        const size_t start = line.find(pattern);
+        if (start == std::string::npos) {
+            return false;
+        }
+        const size_t begin = start + pattern.size();
+        const size_t end = line.find('"', begin);
+        if (end == std::string::npos) {
+            return false;
+        }
+        value = line.substr(begin, end - begin);
+        return true;
+    }
+
+    // Valor numrico de "key":nmero en una lnea del JSON de resultados.
+    bool findNumber(const std::string& line, const std::string& key, double& value) {
+        const std::string pattern = "\"" + key + "\":";
+        const size_t start = line.find(pattern);
+        if (start == std::string::npos) {
+            return false;
+        }
+        return std::sscanf(line.c_str() + start + pattern.size(), "%lf", &value) == 1;
+    }
+}
+
+MicroBenchmark::MicroBenchmark(double minSampleMs, int samples)
+    : m_minSampleNs(minSampleMs * 1000000.0), m_samples(std::max(1, samples)) {
+}
+
+const std::vector<BenchmarkResult>& MicroBenchmark::getResults() const {
+    return m_results;
+}
+
+/*
+   Agrupa los resultados por caso, en el orden en que se midieron.
+*/
+void MicroBenchmark::print(const std::string& referenceVariant) const {
+    std::vector<std::string> names;
+    for (const BenchmarkResult& result : m_results) {
+        if (std::find(names.begin(), names.end(), result.name) == names.end()) {
+            names.push_back(result.name);
+        }
+    }
+
+    for (const std::string& name : names) {
+        const BenchmarkResult* reference = nullptr;
+        for (const BenchmarkResult& result : m_results) {
+            if (result.name == name && result.variant == referenceVariant) {
+                reference = &result;
+            }
+        }
+
+        std::printf("%-28s", name.c_str());
+        for (const BenchmarkResult& result : m_results) {
+            if (result.name != name) {
+                continue;
+            }
+            std::printf("  %s %9.2f ns", result.variant.c_str(), result.nsPerOp);
+            if (reference != nullptr && &result != reference && reference->nsPerOp > 0.0) {
+                std::printf(" (x%.2f)", result.nsPerOp / reference->nsPerOp);
+            }
+        }
+        std::printf("\n");
+    }
+}
+
+/*
+   Un objeto por lnea, para que loadJson no necesite un parser completo
+   y los archivos se puedan comparar con diff.
+*/
+bool MicroBenchmark::saveJson(const std::string& path) const {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        std::cerr << "MicroBenchmark::saveJson : no se pudo crear [" << path << "]\n";
+        return false;
+    }
+
+    out << "{\"benchmarks\":[\n";
+    char line[512];
+    for (size_t i = 0; i < m_results.size(); ++i) {
+        const BenchmarkResult& result = m_results[i];
+        std::snprintf(line, sizeof(line),
+            "{\"name\":\"%s\",\"variant\":\"%s\",\"ns_per_op\":%.4f,\"min_ns_per_op\":%.4f,\"iterations\":%llu}%s\n",
+            result.name.c_str(), result.variant.c_str(), result.nsPerOp, result.minNsPerOp,
+            static_cast<unsigned long long>(result.iterations), i + 1 < m_results.size() ? "," : "");
+        out << line;
+    }
+    out << "]}\n";
+    return static_cast<bool>(out);
+}
+
+bool MicroBenchmark::loadJson(const std::string& path, std::vector<BenchmarkResult>& results) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "MicroBenchmark::loadJson : no se pudo abrir [" << path << "]\n";
+        return false;
+    }
+
+    results.clear();
+    std::string line;
+    while (std::getline(in, line)) {
+        BenchmarkResult result;
+        double iterations = 0.0;
+        if (findString(line, "name", result.name) && findString(line, "variant", result.variant)
+            && findNumber(line, "ns_per_op", result.nsPerOp)) {
+            findNumber(line, "min_ns_per_op", result.minNsPerOp);
+            findNumber(line, "iterations", iterations);
+            result.iterations = static_cast<uint64_t>(iterations);
+            results.push_back(result);
+        }
+    }
+    return true;
+}
+
+/*
+   Los casos que no existen en la lnea base (o ya no existen ahora) se informan pero no cuentan.
+*/
+int MicroBenchmark::compare(const std::vector<BenchmarkResult>& baseline, double thresholdPercent) const {
+    int regressions = 0;
+    for (const BenchmarkResult& result : m_results) {
+        auto previous = std::find_if(baseline.begin(), baseline.end(), [&result](const BenchmarkResult& other) {
+            return other.name == result.name && other.variant == result.variant;
+            });
+        if (previous == baseline.end() || previous->nsPerOp <= 0.0) {
+            std::printf("%-28s %-8s nuevo\n", result.name.c_str(), result.variant.c_str());
+            continue;
+        }
+
+        const double change = 100.0 * (result.nsPerOp - previous->nsPerOp) / previous->nsPerOp;
+        const bool regression = change > thresholdPercent;
+        std::printf("%-28s %-8s %9.2f -> %9.2f ns (%+6.1f %%)%s\n", result.name.c_str(), result.variant.c_str(),
+            previous->nsPerOp, result.nsPerOp, change, regression ? "  REGRESION" : "");
+        if (regression) {
+            ++regressions;
+        }
+    }
+    return regressions;
+}
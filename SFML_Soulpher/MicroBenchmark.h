@@ -0,0 +1,120 @@
+#pragma once
+#include "Prerequisites.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+namespace MicroBenchmarkDetail
+{
+    extern const void* volatile g_sink;
+}
+
+/*
+  Funcin doNotOptimize.
+  - Obliga al compilador a considerar value como usado, para que no elimine el cdigo medido.
+*/
+template<typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r"(&value) : "memory");
+#else
+    MicroBenchmarkDetail::g_sink = &value;
+#endif
+}
+
+/*
+  Estructura BenchmarkResult
+  - Resultado de una medicin: nombre del caso, variante (por ejemplo "engine" contra "std")
+    y nanosegundos por operacin (mediana de las muestras).
+*/
+struct BenchmarkResult
+{
+    std::string name;
+    std::string variant;
+    double nsPerOp = 0.0;
+    double minNsPerOp = 0.0;
+    uint64_t iterations = 0;   // Iteraciones por muestra.
+};
+
+/*
+  Clase MicroBenchmark
+  - Mide cuerpos de cdigo pequeos: calibra cuntas iteraciones caben en una muestra de al menos
+    minSampleMs milisegundos y toma la mediana de varias muestras.
+  - Los resultados se imprimen agrupados por caso (con la proporcin entre variantes), se guardan en
+    JSON y se comparan contra un JSON guardado antes para detectar regresiones.
+  En motores 3D, estas mediciones de "microbenchmarks" vigilan el costo de las piezas que se llaman
+  miles de veces por frame (punteros inteligentes, bsqueda de componentes, actualizacin de actores).
+*/
+class MicroBenchmark
+{
+public:
+    explicit MicroBenchmark(double minSampleMs = 10.0, int samples = 7);
+
+    /*
+      Funcin run.
+      - body(iterations) debe ejecutar el caso iterations veces.
+    */
+    template<typename Body>
+    void run(const std::string& name, const std::string& variant, Body&& body);
+
+    const std::vector<BenchmarkResult>& getResults() const;
+
+    /*
+      Funcin print.
+      - Una fila por caso con el tiempo de cada variante; la proporcin se calcula contra
+        la variante referenceVariant si existe.
+    */
+    void print(const std::string& referenceVariant) const;
+
+    // Guarda los resultados en JSON ({"benchmarks":[{...}, ...]}).
+    bool saveJson(const std::string& path) const;
+
+    // Lee un JSON escrito por saveJson.
+    static bool loadJson(const std::string& path, std::vector<BenchmarkResult>& results);
+
+    /*
+      Funcin compare.
+      - Compara contra resultados guardados (mismo caso y variante) e imprime la diferencia.
+      - Devuelve el nmero de casos ms lentos que la lnea base en ms de thresholdPercent.
+    */
+    int compare(const std::vector<BenchmarkResult>& baseline, double thresholdPercent) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    double m_minSampleNs;
+    int m_samples;
+    std::vector<BenchmarkResult> m_results;
+};
+
+template<typename Body>
+void MicroBenchmark::run(const std::string& name, const std::string& variant, Body&& body) {
+    // Calibracin: duplicar las iteraciones hasta que una muestra dure lo suficiente.
+    uint64_t iterations = 1;
+    while (true) {
+        const auto start = Clock::now();
+        body(iterations);
+        const double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+        if (ns >= m_minSampleNs || iterations >= (uint64_t(1) << 40)) {
+            break;
+        }
+        iterations *= 2;
+    }
+
+    std::vector<double> perOp;
+    for (int sample = 0; sample < m_samples; ++sample) {
+        const auto start = Clock::now();
+        body(iterations);
+        const double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+        perOp.push_back(ns / iterations);
+    }
+    std::sort(perOp.begin(), perOp.end());
+
+    BenchmarkResult result;
+    result.name = name;
+    result.variant = variant;
+    result.nsPerOp = perOp[perOp.size() / 2];
+    result.minNsPerOp = perOp.front();
+    result.iterations = iterations;
+    m_results.push_back(result);
+}
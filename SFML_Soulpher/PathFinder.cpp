@@ -0,0 +1,739 @@
+#include "PathFinder.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iterator>
+#include <memory>
+
+namespace
+{
+    constexpr size_t BATCH_SIZE = 32;           // Bsquedas por tarea del ThreadPool.
+    constexpr int NEAREST_SEARCH_RADIUS = 8;    // Celdas alrededor de un punto fuera de la pista.
+    constexpr int SHORT_ENTRANCE = 6;           // Tramos ms cortos tienen un solo portal.
+    constexpr float DIAGONAL = 1.41421356f;
+
+    constexpr int NEIGHBOR_X[8] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+    constexpr int NEIGHBOR_Y[8] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+
+    using OpenEntry = std::pair<float, uint32_t>;
+
+    /*
+       Memoria de trabajo de una bsqueda, una por hilo. En lugar de limpiar los arreglos en cada
+       bsqueda, cada una usa un nmero de generacin: una entrada solo es vlida si su marca
+       coincide con la generacin actual.
+    */
+    struct SearchScratch
+    {
+        std::vector<float> cost;
+        std::vector<uint32_t> parent;
+        std::vector<uint32_t> seen;
+        std::vector<uint32_t> closed;
+        std::vector<OpenEntry> open;
+        uint32_t generation = 0;
+
+        void prepare(size_t size) {
+            if (seen.size() < size) {
+                cost.resize(size);
+                parent.resize(size);
+                seen.assign(size, 0);
+                closed.assign(size, 0);
+                generation = 0;
+            }
+            if (++generation == 0) {
+                std::fill(seen.begin(), seen.end(), 0);
+                std::fill(closed.begin(), closed.end(), 0);
+                generation = 1;
+            }
+            open.clear();
+        }
+
+        bool isSeen(uint32_t index) const { return seen[index] == generation; }
+        bool isClosed(uint32_t index) const { return closed[index] == generation; }
+
+        // Baja el costo de index si mejora y lo agrega a la lista abierta con prioridad cost + estimate.
+        void relax(uint32_t index, uint32_t from, float newCost, float estimate) {
+            if (isSeen(index) && newCost >= cost[index]) {
+                return;
+            }
+            seen[index] = generation;
+            cost[index] = newCost;
+            parent[index] = from;
+            open.push_back(OpenEntry(newCost + estimate, index));
+            std::push_heap(open.begin(), open.end(), std::greater<OpenEntry>());
+        }
+
+        // Saca la entrada de menor prioridad que no est cerrada. Devuelve false si no quedan.
+        bool pop(uint32_t& index) {
+            while (!open.empty()) {
+                std::pop_heap(open.begin(), open.end(), std::greater<OpenEntry>());
+                index = open.back().second;
+                open.pop_back();
+                if (!isClosed(index)) {
+                    closed[index] = generation;
+                    return true;
+                }
+            }
+            return false;
+        }
+    };
+
+    thread_local SearchScratch t_cellScratch;   // Bsquedas por celdas.
+    thread_local SearchScratch t_nodeScratch;   // Bsquedas en el grafo abstracto.
+
+    uint64_t cacheKey(uint32_t start, uint32_t goal) {
+        return (static_cast<uint64_t>(start) << 32) | goal;
+    }
+}
+
+PathFinder::PathFinder(unsigned int threadCount)
+    : m_threadCount(threadCount) {
+}
+
+/*
+   1. Portales: en cada borde entre dos clusters, los tramos de celdas transitables por ambos lados.
+      Cada portal son dos nodos (uno por lado) unidos por una arista de una celda.
+   2. Aristas internas: desde cada nodo, Dijkstra dentro de su cluster hasta los dems nodos del
+      mismo cluster. Cada cluster es una tarea independiente: solo escribe las aristas de sus nodos.
+*/
+bool PathFinder::build(const TrackGrid& grid, int clusterSize) {
+    PROFILE_SCOPE("PathFinder::build");
+    waitIdle();
+    {
+        std::lock_guard<std::mutex> lock(m_finishedMutex);
+        m_finished.clear();
+    }
+    m_pending.clear();
+    m_inFlight = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_cacheMutex);
+        m_cache.clear();
+        m_cacheOrder.clear();
+    }
+    m_nodes.clear();
+    m_clusterNodes.clear();
+    m_edgeCount = 0;
+    m_queries = 0;
+    m_cacheHits = 0;
+    m_searchMicroseconds = 0;
+    m_searches = 0;
+
+    if (!grid.isValid() || clusterSize < 2) {
+        LOG_ERROR("PathFinder", "build", "rejilla vacia o clusters de menos de 2 celdas");
+        m_grid = TrackGrid();
+        return false;
+    }
+    // Los hilos solo se crean con una rejilla vlida: un build fallido no deja hilos ociosos.
+    if (!m_workers) {
+        m_workers = std::make_unique<ThreadPool>(m_threadCount, "Path");
+    }
+    m_grid = grid;
+    m_clusterSize = clusterSize;
+    const int columns = m_grid.getColumns();
+    const int rows = m_grid.getRows();
+    m_clusterColumns = (columns + clusterSize - 1) / clusterSize;
+    m_clusterRows = (rows + clusterSize - 1) / clusterSize;
+    m_clusterNodes.resize(static_cast<size_t>(m_clusterColumns) * m_clusterRows);
+
+    std::unordered_map<uint32_t, uint32_t> nodeOfCell;
+    auto getNode = [&](uint32_t cell) {
+        auto found = nodeOfCell.find(cell);
+        if (found != nodeOfCell.end()) {
+            return found->second;
+        }
+        const uint32_t node = static_cast<uint32_t>(m_nodes.size());
+        Node created;
+        created.cell = cell;
+        created.cluster = clusterOf(cell);
+        m_nodes.push_back(created);
+        m_clusterNodes[created.cluster].push_back(node);
+        nodeOfCell.emplace(cell, node);
+        return node;
+    };
+    auto addPortal = [&](uint32_t a, uint32_t b) {
+        const uint32_t nodeA = getNode(a);
+        const uint32_t nodeB = getNode(b);
+        m_nodes[nodeA].edges.push_back(Edge{ nodeB, m_grid.getCellSize() });
+        m_nodes[nodeB].edges.push_back(Edge{ nodeA, m_grid.getCellSize() });
+    };
+
+    // Recorre un borde de length celdas; cellsAt(i) da las dos celdas enfrentadas en la posicin i.
+    auto scanBorder = [&](int length, const std::function<std::pair<uint32_t, uint32_t>(int)>& cellsAt) {
+        int runStart = -1;
+        for (int i = 0; i <= length; ++i) {
+            bool open = false;
+            if (i < length) {
+                const std::pair<uint32_t, uint32_t> cells = cellsAt(i);
+                open = m_grid.isDrivable(cells.first) && m_grid.isDrivable(cells.second);
+            }
+            if (open && runStart < 0) {
+                runStart = i;
+            }
+            if (!open && runStart >= 0) {
+                const int runEnd = i - 1;
+                if (runEnd - runStart + 1 < SHORT_ENTRANCE) {
+                    const std::pair<uint32_t, uint32_t> middle = cellsAt((runStart + runEnd) / 2);
+                    addPortal(middle.first, middle.second);
+                }
+                else {
+                    const std::pair<uint32_t, uint32_t> first = cellsAt(runStart);
+                    const std::pair<uint32_t, uint32_t> last = cellsAt(runEnd);
+                    addPortal(first.first, first.second);
+                    addPortal(last.first, last.second);
+                }
+                runStart = -1;
+            }
+        }
+    };
+
+    for (int clusterY = 0; clusterY < m_clusterRows; ++clusterY) {
+        const int top = clusterY * clusterSize;
+        const int bottom = std::min(rows, top + clusterSize);
+        for (int clusterX = 0; clusterX < m_clusterColumns; ++clusterX) {
+            const int left = clusterX * clusterSize;
+            const int right = std::min(columns, left + clusterSize);
+            if (right < columns) {
+                scanBorder(bottom - top, [&](int i) {
+                    return std::make_pair(static_cast<uint32_t>(m_grid.toIndex(right - 1, top + i)),
+                        static_cast<uint32_t>(m_grid.toIndex(right, top + i)));
+                    });
+            }
+            if (bottom < rows) {
+                scanBorder(right - left, [&](int i) {
+                    return std::make_pair(static_cast<uint32_t>(m_grid.toIndex(left + i, bottom - 1)),
+                        static_cast<uint32_t>(m_grid.toIndex(left + i, bottom)));
+                    });
+            }
+        }
+    }
+
+    for (uint32_t cluster = 0; cluster < m_clusterNodes.size(); ++cluster) {
+        if (m_clusterNodes[cluster].size() < 2) {
+            continue;
+        }
+        m_workers->submit([this, cluster]() {
+            const std::vector<uint32_t>& nodes = m_clusterNodes[cluster];
+            std::vector<uint32_t> targets;
+            for (uint32_t node : nodes) {
+                targets.push_back(m_nodes[node].cell);
+            }
+            std::vector<float> costs;
+            for (size_t i = 0; i < nodes.size(); ++i) {
+                searchLocal(clusterRect(cluster), targets[i], -1, nullptr, &targets, &costs);
+                for (size_t j = 0; j < nodes.size(); ++j) {
+                    if (j != i && costs[j] >= 0.0f) {
+                        m_nodes[nodes[i]].edges.push_back(Edge{ nodes[j], costs[j] });
+                    }
+                }
+            }
+            });
+    }
+    m_workers->waitIdle();
+
+    for (const Node& node : m_nodes) {
+        m_edgeCount += node.edges.size();
+    }
+    return true;
+}
+
+bool PathFinder::isValid() const {
+    return m_grid.isValid();
+}
+
+uint32_t PathFinder::clusterOf(uint32_t cell) const {
+    const int column = static_cast<int>(cell % m_grid.getColumns());
+    const int row = static_cast<int>(cell / m_grid.getColumns());
+    return static_cast<uint32_t>((row / m_clusterSize) * m_clusterColumns + column / m_clusterSize);
+}
+
+PathFinder::CellRect PathFinder::clusterRect(uint32_t cluster) const {
+    CellRect rect;
+    rect.left = static_cast<int>(cluster % m_clusterColumns) * m_clusterSize;
+    rect.top = static_cast<int>(cluster / m_clusterColumns) * m_clusterSize;
+    rect.right = std::min(m_grid.getColumns(), rect.left + m_clusterSize);
+    rect.bottom = std::min(m_grid.getRows(), rect.top + m_clusterSize);
+    return rect;
+}
+
+/*
+   Recorre anillos cuadrados cada vez ms grandes y, en el primero que tenga celdas transitables,
+   elige la ms cercana a position.
+*/
+int64_t PathFinder::nearestDrivable(const sf::Vector2f& position) const {
+    const sf::Vector2i center = m_grid.toCell(position);
+    if (m_grid.isDrivable(m_grid.toIndex(center.x, center.y))) {
+        return static_cast<int64_t>(m_grid.toIndex(center.x, center.y));
+    }
+    for (int radius = 1; radius <= NEAREST_SEARCH_RADIUS; ++radius) {
+        int64_t best = -1;
+        float bestDistance = 0.0f;
+        for (int y = center.y - radius; y <= center.y + radius; ++y) {
+            const bool edgeRow = y == center.y - radius || y == center.y + radius;
+            for (int x = center.x - radius; x <= center.x + radius; x += edgeRow ? 1 : 2 * radius) {
+                if (!m_grid.contains(x, y) || !m_grid.isDrivable(m_grid.toIndex(x, y))) {
+                    continue;
+                }
+                const sf::Vector2f offset = m_grid.getCellCenter(m_grid.toIndex(x, y)) - position;
+                const float distance = offset.x * offset.x + offset.y * offset.y;
+                if (best < 0 || distance < bestDistance) {
+                    best = static_cast<int64_t>(m_grid.toIndex(x, y));
+                    bestDistance = distance;
+                }
+            }
+        }
+        if (best >= 0) {
+            return best;
+        }
+    }
+    return -1;
+}
+
+float PathFinder::searchLocal(const CellRect& rect, uint32_t start, int64_t goal, std::vector<uint32_t>* cells,
+    const std::vector<uint32_t>* targets, std::vector<float>* costs) const {
+    SearchScratch& scratch = t_cellScratch;
+    scratch.prepare(m_grid.getCellCount());
+
+    const int columns = m_grid.getColumns();
+    const float cellSize = m_grid.getCellSize();
+    const int goalColumn = goal >= 0 ? static_cast<int>(goal % columns) : 0;
+    const int goalRow = goal >= 0 ? static_cast<int>(goal / columns) : 0;
+    // Distancia octil: el costo exacto sin obstculos con 8 vecinos.
+    auto estimate = [&](int column, int row) {
+        if (goal < 0) {
+            return 0.0f;
+        }
+        const int dx = std::abs(column - goalColumn);
+        const int dy = std::abs(row - goalRow);
+        return cellSize * (std::max(dx, dy) + (DIAGONAL - 1.0f) * std::min(dx, dy));
+    };
+    auto inside = [&](int column, int row) {
+        return column >= rect.left && column < rect.right && row >= rect.top && row < rect.bottom
+            && m_grid.isDrivable(m_grid.toIndex(column, row));
+    };
+
+    scratch.relax(start, start, 0.0f, estimate(static_cast<int>(start % columns), static_cast<int>(start / columns)));
+    uint32_t current = 0;
+    bool reached = false;
+    while (scratch.pop(current)) {
+        if (goal >= 0 && current == static_cast<uint32_t>(goal)) {
+            reached = true;
+            break;
+        }
+        const int column = static_cast<int>(current % columns);
+        const int row = static_cast<int>(current / columns);
+        for (int n = 0; n < 8; ++n) {
+            const int nextColumn = column + NEIGHBOR_X[n];
+            const int nextRow = row + NEIGHBOR_Y[n];
+            if (!inside(nextColumn, nextRow)) {
+                continue;
+            }
+            const bool diagonal = n >= 4;
+            if (diagonal && (!inside(nextColumn, row) || !inside(column, nextRow))) {
+                continue;   // No cortar esquinas.
+            }
+            const uint32_t next = static_cast<uint32_t>(m_grid.toIndex(nextColumn, nextRow));
+            if (scratch.isClosed(next)) {
+                continue;
+            }
+            scratch.relax(next, current, scratch.cost[current] + (diagonal ? cellSize * DIAGONAL : cellSize),
+                estimate(nextColumn, nextRow));
+        }
+    }
+
+    if (goal < 0) {
+        costs->assign(targets->size(), -1.0f);
+        for (size_t i = 0; i < targets->size(); ++i) {
+            if (scratch.isClosed((*targets)[i])) {
+                (*costs)[i] = scratch.cost[(*targets)[i]];
+            }
+        }
+        return 0.0f;
+    }
+    if (!reached) {
+        return -1.0f;
+    }
+    if (cells != nullptr) {
+        const size_t first = cells->size();
+        for (uint32_t cell = current; ; cell = scratch.parent[cell]) {
+            cells->push_back(cell);
+            if (cell == start) {
+                break;
+            }
+        }
+        std::reverse(cells->begin() + static_cast<std::ptrdiff_t>(first), cells->end());
+    }
+    return scratch.cost[current];
+}
+
+/*
+   1. Si el inicio y la meta estn en el mismo cluster, se intenta primero un A* local.
+   2. El inicio y la meta se conectan a los nodos de su cluster con un Dijkstra local cada uno, y
+      entran al A* del grafo abstracto como dos nodos temporales (START y GOAL).
+   3. Cada par de nodos consecutivos del camino abstracto se refina: dentro de un cluster con A*
+      local, y entre clusters (un portal) son celdas vecinas.
+*/
+bool PathFinder::searchHierarchical(uint32_t start, uint32_t goal, std::vector<uint32_t>& cells) const {
+    const uint32_t startCluster = clusterOf(start);
+    const uint32_t goalCluster = clusterOf(goal);
+    if (startCluster == goalCluster && searchLocal(clusterRect(startCluster), start, goal, &cells) >= 0.0f) {
+        return true;
+    }
+
+    auto clusterCells = [&](uint32_t cluster) {
+        std::vector<uint32_t> result;
+        for (uint32_t node : m_clusterNodes[cluster]) {
+            result.push_back(m_nodes[node].cell);
+        }
+        return result;
+    };
+    std::vector<float> startCosts;
+    std::vector<float> goalCosts;
+    const std::vector<uint32_t> startTargets = clusterCells(startCluster);
+    const std::vector<uint32_t> goalTargets = clusterCells(goalCluster);
+    searchLocal(clusterRect(startCluster), start, -1, nullptr, &startTargets, &startCosts);
+    searchLocal(clusterRect(goalCluster), goal, -1, nullptr, &goalTargets, &goalCosts);
+
+    const uint32_t startNode = static_cast<uint32_t>(m_nodes.size());
+    const uint32_t goalNode = startNode + 1;
+    const int columns = m_grid.getColumns();
+    const float cellSize = m_grid.getCellSize();
+    const int goalColumn = static_cast<int>(goal % columns);
+    const int goalRow = static_cast<int>(goal / columns);
+    auto estimate = [&](uint32_t cell) {
+        const int dx = std::abs(static_cast<int>(cell % columns) - goalColumn);
+        const int dy = std::abs(static_cast<int>(cell / columns) - goalRow);
+        return cellSize * (std::max(dx, dy) + (DIAGONAL - 1.0f) * std::min(dx, dy));
+    };
+
+    SearchScratch& scratch = t_nodeScratch;
+    scratch.prepare(m_nodes.size() + 2);
+    scratch.relax(startNode, startNode, 0.0f, estimate(start));
+    uint32_t current = 0;
+    bool reached = false;
+    while (scratch.pop(current)) {
+        if (current == goalNode) {
+            reached = true;
+            break;
+        }
+        const float here = scratch.cost[current];
+        if (current == startNode) {
+            const std::vector<uint32_t>& nodes = m_clusterNodes[startCluster];
+            for (size_t i = 0; i < nodes.size(); ++i) {
+                if (startCosts[i] >= 0.0f) {
+                    scratch.relax(nodes[i], startNode, startCosts[i], estimate(m_nodes[nodes[i]].cell));
+                }
+            }
+            continue;
+        }
+        const Node& node = m_nodes[current];
+        for (const Edge& edge : node.edges) {
+            if (!scratch.isClosed(edge.to)) {
+                scratch.relax(edge.to, current, here + edge.cost, estimate(m_nodes[edge.to].cell));
+            }
+        }
+        if (node.cluster == goalCluster) {
+            const std::vector<uint32_t>& nodes = m_clusterNodes[goalCluster];
+            const size_t i = static_cast<size_t>(std::find(nodes.begin(), nodes.end(), current) - nodes.begin());
+            if (goalCosts[i] >= 0.0f) {
+                scratch.relax(goalNode, current, here + goalCosts[i], 0.0f);
+            }
+        }
+    }
+    if (!reached) {
+        return false;
+    }
+
+    std::vector<uint32_t> abstractPath;
+    for (uint32_t node = goalNode; ; node = scratch.parent[node]) {
+        abstractPath.push_back(node);
+        if (node == startNode) {
+            break;
+        }
+    }
+    std::reverse(abstractPath.begin(), abstractPath.end());
+
+    auto cellOf = [&](uint32_t node) { return node == startNode ? start : node == goalNode ? goal : m_nodes[node].cell; };
+    auto clusterOfNode = [&](uint32_t node) { return node == startNode ? startCluster : node == goalNode ? goalCluster : m_nodes[node].cluster; };
+
+    cells.push_back(start);
+    for (size_t i = 0; i + 1 < abstractPath.size(); ++i) {
+        const uint32_t from = cellOf(abstractPath[i]);
+        const uint32_t to = cellOf(abstractPath[i + 1]);
+        const uint32_t cluster = clusterOfNode(abstractPath[i]);
+        if (cluster != clusterOfNode(abstractPath[i + 1])) {
+            cells.push_back(to);
+            continue;
+        }
+        std::vector<uint32_t> segment;
+        if (searchLocal(clusterRect(cluster), from, to, &segment) < 0.0f) {
+            return false;
+        }
+        cells.insert(cells.end(), segment.begin() + 1, segment.end());
+    }
+    return true;
+}
+
+/*
+   Algoritmo de "string pulling": desde cada punto conservado se salta al punto ms lejano del camino
+   que se ve en lnea recta.
+*/
+void PathFinder::smooth(std::vector<uint32_t>& cells) const {
+    if (cells.size() < 3) {
+        return;
+    }
+    std::vector<uint32_t> result;
+    result.push_back(cells.front());
+    size_t anchor = 0;
+    while (anchor + 1 < cells.size()) {
+        size_t next = anchor + 1;
+        while (next + 1 < cells.size() && lineOfSight(cells[anchor], cells[next + 1])) {
+            ++next;
+        }
+        result.push_back(cells[next]);
+        anchor = next;
+    }
+    cells.swap(result);
+}
+
+/*
+   Recorre todas las celdas que toca el segmento entre los centros de from y to. Cuando el segmento
+   pasa justo por una esquina, las dos celdas de la esquina deben ser transitables.
+*/
+bool PathFinder::lineOfSight(uint32_t from, uint32_t to) const {
+    const int columns = m_grid.getColumns();
+    int x = static_cast<int>(from % columns);
+    int y = static_cast<int>(from / columns);
+    const int endX = static_cast<int>(to % columns);
+    const int endY = static_cast<int>(to / columns);
+    const int stepX = endX > x ? 1 : -1;
+    const int stepY = endY > y ? 1 : -1;
+    int dx = std::abs(endX - x);
+    int dy = std::abs(endY - y);
+    int error = dx - dy;
+    dx *= 2;
+    dy *= 2;
+
+    auto drivable = [&](int column, int row) { return m_grid.isDrivable(m_grid.toIndex(column, row)); };
+    for (int remaining = 1 + (dx + dy) / 2; remaining > 0; --remaining) {
+        if (!drivable(x, y)) {
+            return false;
+        }
+        if (error > 0) {
+            x += stepX;
+            error -= dy;
+        }
+        else if (error < 0) {
+            y += stepY;
+            error += dx;
+        }
+        else {
+            if (remaining > 1 && (!drivable(x + stepX, y) || !drivable(x, y + stepY))) {
+                return false;
+            }
+            x += stepX;
+            y += stepY;
+            error += dx - dy;
+            --remaining;
+        }
+    }
+    return true;
+}
+
+void PathFinder::toResult(const std::vector<uint32_t>& cells, const sf::Vector2f& start, const sf::Vector2f& goal,
+    PathResult& result) const {
+    result.points.clear();
+    result.length = 0.0f;
+    result.found = !cells.empty();
+    if (!result.found) {
+        return;
+    }
+    result.points.push_back(start);
+    for (size_t i = 1; i + 1 < cells.size(); ++i) {
+        result.points.push_back(m_grid.getCellCenter(cells[i]));
+    }
+    result.points.push_back(goal);
+    for (size_t i = 1; i < result.points.size(); ++i) {
+        const sf::Vector2f segment = result.points[i] - result.points[i - 1];
+        result.length += std::sqrt(segment.x * segment.x + segment.y * segment.y);
+    }
+}
+
+bool PathFinder::findPath(const sf::Vector2f& start, const sf::Vector2f& goal, PathResult& result) const {
+    PROFILE_SCOPE("PathFinder::findPath");
+    result.found = false;
+    result.cached = false;
+    result.length = 0.0f;
+    result.points.clear();
+    if (!isValid()) {
+        return false;
+    }
+    ++m_queries;
+    const int64_t startCell = nearestDrivable(start);
+    const int64_t goalCell = nearestDrivable(goal);
+    if (startCell < 0 || goalCell < 0) {
+        return false;
+    }
+
+    // Los caminos sin salida tambin se guardan (vacos), para no repetir bsquedas que fallan.
+    const uint64_t key = cacheKey(static_cast<uint32_t>(startCell), static_cast<uint32_t>(goalCell));
+    CachedPath cells;
+    if (lookupCache(key, cells)) {
+        ++m_cacheHits;
+        result.cached = true;
+        toResult(cells, start, goal, result);
+        return result.found;
+    }
+
+    const auto begin = std::chrono::steady_clock::now();
+    if (searchHierarchical(static_cast<uint32_t>(startCell), static_cast<uint32_t>(goalCell), cells)) {
+        smooth(cells);
+    }
+    else {
+        cells.clear();
+    }
+    recordQuery(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count());
+    storeCache(key, cells);
+    toResult(cells, start, goal, result);
+    return result.found;
+}
+
+bool PathFinder::findPathFlat(const sf::Vector2f& start, const sf::Vector2f& goal, PathResult& result) const {
+    result.found = false;
+    result.cached = false;
+    result.length = 0.0f;
+    result.points.clear();
+    if (!isValid()) {
+        return false;
+    }
+    const int64_t startCell = nearestDrivable(start);
+    const int64_t goalCell = nearestDrivable(goal);
+    if (startCell < 0 || goalCell < 0) {
+        return false;
+    }
+    CellRect everything;
+    everything.right = m_grid.getColumns();
+    everything.bottom = m_grid.getRows();
+    std::vector<uint32_t> cells;
+    if (searchLocal(everything, static_cast<uint32_t>(startCell), goalCell, &cells) < 0.0f) {
+        return false;
+    }
+    smooth(cells);
+    toResult(cells, start, goal, result);
+    return result.found;
+}
+
+bool PathFinder::lookupCache(uint64_t key, CachedPath& cells) const {
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    auto found = m_cache.find(key);
+    if (found == m_cache.end()) {
+        return false;
+    }
+    m_cacheOrder.splice(m_cacheOrder.begin(), m_cacheOrder, found->second);
+    cells = found->second->second;
+    return true;
+}
+
+void PathFinder::storeCache(uint64_t key, const CachedPath& cells) const {
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    if (m_cacheCapacity == 0 || m_cache.count(key) != 0) {
+        return;
+    }
+    m_cacheOrder.emplace_front(key, cells);
+    m_cache.emplace(key, m_cacheOrder.begin());
+    while (m_cache.size() > m_cacheCapacity) {
+        m_cache.erase(m_cacheOrder.back().first);
+        m_cacheOrder.pop_back();
+    }
+}
+
+void PathFinder::setCacheCapacity(size_t capacity) {
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    m_cacheCapacity = capacity;
+    while (m_cache.size() > m_cacheCapacity) {
+        m_cache.erase(m_cacheOrder.back().first);
+        m_cacheOrder.pop_back();
+    }
+}
+
+void PathFinder::recordQuery(double milliseconds) const {
+    m_searchMicroseconds += static_cast<uint64_t>(milliseconds * 1000.0);
+    ++m_searches;
+}
+
+uint32_t PathFinder::requestPath(const sf::Vector2f& start, const sf::Vector2f& goal,
+    std::function<void(const PathResult&)> callback) {
+    Request request;
+    request.start = start;
+    request.goal = goal;
+    request.callback = std::move(callback);
+    request.result.id = m_nextId++;
+    m_pending.push_back(std::move(request));
+    return m_pending.back().result.id;
+}
+
+/*
+   Las pendientes se reparten en lotes de BATCH_SIZE: un lote por tarea reduce el costo de encolar
+   y de despertar hilos. Las funciones se llaman aqu, nunca en los hilos de trabajo.
+*/
+void PathFinder::update() {
+    PROFILE_SCOPE("PathFinder::update");
+    const auto begin = std::chrono::steady_clock::now();
+
+    if (!isValid()) {
+        std::lock_guard<std::mutex> lock(m_finishedMutex);
+        std::move(m_pending.begin(), m_pending.end(), std::back_inserter(m_finished));
+        m_inFlight += m_pending.size();
+        m_pending.clear();
+    }
+    for (size_t first = 0; first < m_pending.size(); first += BATCH_SIZE) {
+        const size_t last = std::min(m_pending.size(), first + BATCH_SIZE);
+        auto batch = std::make_shared<std::vector<Request>>(std::make_move_iterator(m_pending.begin() + first),
+            std::make_move_iterator(m_pending.begin() + last));
+        m_inFlight += batch->size();
+        m_workers->submit([this, batch]() {
+            for (Request& request : *batch) {
+                findPath(request.start, request.goal, request.result);
+            }
+            std::lock_guard<std::mutex> lock(m_finishedMutex);
+            std::move(batch->begin(), batch->end(), std::back_inserter(m_finished));
+            });
+    }
+    m_pending.clear();
+
+    std::vector<Request> finished;
+    {
+        std::lock_guard<std::mutex> lock(m_finishedMutex);
+        finished.swap(m_finished);
+    }
+    m_inFlight -= finished.size();
+    for (const Request& request : finished) {
+        if (request.callback) {
+            request.callback(request.result);
+        }
+    }
+    m_lastUpdateMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+void PathFinder::waitIdle() {
+    if (m_workers) {
+        m_workers->waitIdle();
+    }
+}
+
+PathFinder::Stats PathFinder::getStats() const {
+    Stats stats;
+    stats.clusters = m_clusterNodes.size();
+    stats.nodes = m_nodes.size();
+    stats.edges = m_edgeCount;
+    stats.queries = m_queries;
+    stats.cacheHits = m_cacheHits;
+    const uint64_t searches = m_searches;
+    stats.averageQueryMs = searches > 0 ? m_searchMicroseconds / 1000.0 / searches : 0.0;
+    stats.pending = m_pending.size() + m_inFlight;
+    stats.lastUpdateMs = m_lastUpdateMs;
+    return stats;
+}
+
+const TrackGrid& PathFinder::getGrid() const {
+    return m_grid;
+}
@@ -0,0 +1,218 @@
+#pragma once
+#include "Prerequisites.h"
+#include "TrackGrid.h"
+#include "ThreadPool.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+/*
+  Estructura PathResult.
+  - Resultado de una bsqueda de camino pedida con PathFinder::requestPath.
+*/
+struct PathResult
+{
+    uint32_t id = 0;                    // El que devolvi requestPath.
+    bool found = false;
+    bool cached = false;                // El camino sali de la cach.
+    float length = 0.0f;                // Longitud en unidades del mundo.
+    std::vector<sf::Vector2f> points;   // Desde el inicio hasta la meta (vaco si no hay camino).
+};
+
+/*
+  Clase PathFinder
+  - Bsqueda de caminos HPA* (A* jerrquico) sobre las celdas transitables de un TrackGrid, para
+    karts con objetivos propios (recoger un objeto, tomar un atajo).
+  - Al construirla, la rejilla se divide en clusters de clusterSize x clusterSize celdas. En cada borde
+    entre dos clusters, los tramos transitables por ambos lados se convierten en portales (uno en el
+    centro de los tramos cortos, dos en los extremos de los largos). Dentro de cada cluster se calcula
+    el costo entre todos sus portales. El resultado es el grafo abstracto: pocos cientos de nodos en
+    lugar de miles de celdas.
+  - Una bsqueda conecta el inicio y la meta a los portales de su cluster, corre A* sobre el grafo
+    abstracto y refina cada tramo con A* dentro de un solo cluster. El camino se suaviza quitando los
+    puntos intermedios que se ven en lnea recta.
+  - Los caminos se guardan en una cach LRU por par de celdas (inicio, meta).
+  - requestPath encola la bsqueda; update() (en el hilo principal, una vez por frame) manda las
+    pendientes en lotes a un ThreadPool y entrega los resultados terminados a sus funciones. As
+    cientos de bsquedas por frame no detienen BaseApp::update.
+  En motores 3D, HPA* se usa en mapas grandes: el grafo abstracto se calcula al cargar el nivel y cada
+  bsqueda solo explora celdas en los clusters por los que pasa el camino.
+*/
+class PathFinder
+{
+public:
+    /*
+      Estructura Stats.
+      - Contadores desde que se construy el grafo.
+    */
+    struct Stats
+    {
+        size_t clusters = 0;
+        size_t nodes = 0;                 // Nodos del grafo abstracto (celdas de portal).
+        size_t edges = 0;
+        uint64_t queries = 0;
+        uint64_t cacheHits = 0;
+        double averageQueryMs = 0.0;      // Bsquedas fuera de la cach.
+        size_t pending = 0;               // Pedidas con requestPath y todava sin entregar.
+        double lastUpdateMs = 0.0;        // Tiempo de la ltima llamada a update().
+    };
+
+    /*
+      Constructor parametrizado.
+      - threadCount: hilos para las bsquedas asncronas (0 = ver ThreadPool). Se crean en el primer
+        build(), as que un PathFinder sin rejilla no tiene hilos.
+    */
+    explicit PathFinder(unsigned int threadCount = 0);
+
+    /*
+      Destructor.
+      - Espera a las bsquedas en ejecucin; las pendientes se descartan sin llamar a su funcin.
+    */
+    ~PathFinder() = default;
+
+    PathFinder(const PathFinder&) = delete;
+    PathFinder& operator=(const PathFinder&) = delete;
+
+    /*
+      Funcin build.
+      - Copia la rejilla y calcula el grafo abstracto (los clusters se procesan en paralelo).
+      - Vaca la cach y descarta las bsquedas pendientes.
+    */
+    bool build(const TrackGrid& grid, int clusterSize = 16);
+
+    // Indica si el grafo est construido.
+    bool isValid() const;
+
+    /*
+      Funcin findPath.
+      - Bsqueda HPA* sncrona (se puede llamar desde cualquier hilo). Si el inicio o la meta caen
+        fuera de la pista se usa la celda transitable ms cercana. Devuelve false si no hay camino.
+    */
+    bool findPath(const sf::Vector2f& start, const sf::Vector2f& goal, PathResult& result) const;
+
+    // A* sobre toda la rejilla, sin grafo abstracto ni cach. Referencia para medir HPA*.
+    bool findPathFlat(const sf::Vector2f& start, const sf::Vector2f& goal, PathResult& result) const;
+
+    /*
+      Funcin requestPath.
+      - Encola una bsqueda y devuelve su id. callback se llama en el hilo que llama a update(),
+        en algn frame posterior.
+    */
+    uint32_t requestPath(const sf::Vector2f& start, const sf::Vector2f& goal, std::function<void(const PathResult&)> callback);
+
+    /*
+      Funcin update.
+      - Manda las bsquedas pendientes a los hilos en lotes y llama a las funciones de las terminadas.
+    */
+    void update();
+
+    // Bloquea hasta que no haya bsquedas en ejecucin (sin entregar los resultados).
+    void waitIdle();
+
+    // Caminos que guarda la cach (0 = sin cach). Por defecto 4096.
+    void setCacheCapacity(size_t capacity);
+
+    Stats getStats() const;
+    const TrackGrid& getGrid() const;
+
+private:
+    // Arista del grafo abstracto.
+    struct Edge
+    {
+        uint32_t to = 0;
+        float cost = 0.0f;
+    };
+
+    // Nodo del grafo abstracto: una celda de portal.
+    struct Node
+    {
+        uint32_t cell = 0;
+        uint32_t cluster = 0;
+        std::vector<Edge> edges;
+    };
+
+    // Rectngulo de celdas [left, right) x [top, bottom) al que se limita una bsqueda local.
+    struct CellRect
+    {
+        int left = 0;
+        int top = 0;
+        int right = 0;
+        int bottom = 0;
+    };
+
+    // Bsqueda encolada con requestPath.
+    struct Request
+    {
+        sf::Vector2f start;
+        sf::Vector2f goal;
+        std::function<void(const PathResult&)> callback;
+        PathResult result;
+    };
+
+    // Camino guardado en la cach: celdas por las que pasa, ya suavizado.
+    using CachedPath = std::vector<uint32_t>;
+
+    uint32_t clusterOf(uint32_t cell) const;
+    CellRect clusterRect(uint32_t cluster) const;
+
+    // Celda transitable ms cercana a position (o -1 si no hay ninguna cerca).
+    int64_t nearestDrivable(const sf::Vector2f& position) const;
+
+    /*
+      A* (o Dijkstra, si goal < 0) de 8 vecinos dentro de rect. Las diagonales no cortan esquinas.
+      Con goal, deja el camino en cells y devuelve su costo; sin goal, deja en costs el costo de cada
+      celda de targets. Devuelve un costo negativo si no llega.
+    */
+    float searchLocal(const CellRect& rect, uint32_t start, int64_t goal, std::vector<uint32_t>* cells,
+        const std::vector<uint32_t>* targets = nullptr, std::vector<float>* costs = nullptr) const;
+
+    // HPA* entre dos celdas transitables; deja el camino (sin suavizar) en cells.
+    bool searchHierarchical(uint32_t start, uint32_t goal, std::vector<uint32_t>& cells) const;
+
+    // Quita las celdas intermedias que se ven en lnea recta por celdas transitables.
+    void smooth(std::vector<uint32_t>& cells) const;
+    bool lineOfSight(uint32_t from, uint32_t to) const;
+
+    // Puntos del mundo del camino, con los extremos exactos de la bsqueda.
+    void toResult(const std::vector<uint32_t>& cells, const sf::Vector2f& start, const sf::Vector2f& goal, PathResult& result) const;
+
+    bool lookupCache(uint64_t key, CachedPath& cells) const;
+    void storeCache(uint64_t key, const CachedPath& cells) const;
+
+    void recordQuery(double milliseconds) const;
+
+    TrackGrid m_grid;
+    int m_clusterSize = 16;
+    int m_clusterColumns = 0;
+    int m_clusterRows = 0;
+    std::vector<Node> m_nodes;
+    std::vector<std::vector<uint32_t>> m_clusterNodes;   // Nodos de cada cluster.
+    size_t m_edgeCount = 0;
+
+    // Cach LRU: la lista va de la ms reciente a la ms vieja.
+    mutable std::mutex m_cacheMutex;
+    mutable std::list<std::pair<uint64_t, CachedPath>> m_cacheOrder;
+    mutable std::unordered_map<uint64_t, std::list<std::pair<uint64_t, CachedPath>>::iterator> m_cache;
+    size_t m_cacheCapacity = 4096;
+
+    mutable std::atomic<uint64_t> m_queries{ 0 };
+    mutable std::atomic<uint64_t> m_cacheHits{ 0 };
+    mutable std::atomic<uint64_t> m_searchMicroseconds{ 0 };
+    mutable std::atomic<uint64_t> m_searches{ 0 };
+
+    // Bsquedas asncronas: las pendientes solo las toca el hilo de update(); las terminadas
+    // las entregan los hilos de trabajo bajo m_finishedMutex.
+    std::vector<Request> m_pending;
+    std::vector<Request> m_finished;
+    std::mutex m_finishedMutex;
+    size_t m_inFlight = 0;
+    uint32_t m_nextId = 1;
+    double m_lastUpdateMs = 0.0;
+
+    // Va al final: se destruye primero y espera a las bsquedas en ejecucin antes de liberar el grafo.
+    unsigned int m_threadCount = 0;
+    std::unique_ptr<ThreadPool> m_workers;      // Se crea en el primer build().
+};
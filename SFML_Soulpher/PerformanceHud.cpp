@@ -0,0 +1,96 @@
+#include "PerformanceHud.h"
+#include "AllocationTracker.h"
+#include <algorithm>
+
+void PerformanceHud::setVisible(bool visible) {
+    m_visible = visible;
+    if (!visible) {
+        // Al volver a mostrarse, la grfica empieza de cero en lugar de unir dos momentos distintos.
+        m_count = 0;
+        m_next = 0;
+    }
+}
+
+bool PerformanceHud::isVisible() const {
+    return m_visible;
+}
+
+void PerformanceHud::toggle() {
+    setVisible(!m_visible);
+}
+
+void PerformanceHud::addSample(const FrameSample& sample) {
+    m_frameMs[m_next] = sample.frameMs;
+    m_next = (m_next + 1) % HISTORY;
+    m_count = std::min(m_count + 1, HISTORY);
+    m_last = sample;
+
+    if (--m_framesUntilPercentiles <= 0) {
+        updatePercentiles();
+        m_framesUntilPercentiles = PERCENTILE_INTERVAL;
+    }
+}
+
+/*
+   Percentiles por rango ms cercano sobre los frames del historial.
+*/
+void PerformanceHud::updatePercentiles() {
+    if (m_count == 0) {
+        return;
+    }
+    std::copy(m_frameMs.begin(), m_frameMs.begin() + m_count, m_sorted.begin());
+    auto begin = m_sorted.begin();
+    auto end = m_sorted.begin() + m_count;
+    auto at = [&](float percentile) {
+        const size_t index = std::min(m_count - 1, static_cast<size_t>(percentile * m_count));
+        std::nth_element(begin, begin + index, end);
+        return m_sorted[index];
+    };
+    m_p50 = at(0.50f);
+    m_p95 = at(0.95f);
+    m_p99 = at(0.99f);
+}
+
+/*
+   Ventana fija en la esquina superior izquierda, sin decoraciones ni foco.
+*/
+void PerformanceHud::draw() {
+    if (!m_visible) {
+        return;
+    }
+
+    ImGui::SetNextWindowPos(ImVec2(10.0f, 10.0f), ImGuiCond_Always);
+    ImGui::SetNextWindowBgAlpha(0.65f);
+    const ImGuiWindowFlags flags = ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize
+        | ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav
+        | ImGuiWindowFlags_NoMove;
+    if (ImGui::Begin("PERFORMANCE", nullptr, flags)) {
+        const float fps = m_last.frameMs > 0.0f ? 1000.0f / m_last.frameMs : 0.0f;
+        ImGui::Text("%.0f FPS  %.2f ms", fps, m_last.frameMs);
+        ImGui::Text("p50 %.2f  p95 %.2f  p99 %.2f ms", m_p50, m_p95, m_p99);
+
+        // La grfica empieza en el frame ms viejo del arreglo circular.
+        const int offset = m_count < HISTORY ? 0 : static_cast<int>(m_next);
+        ImGui::PlotLines("##frametime", m_frameMs.data(), static_cast<int>(m_count), offset, nullptr,
+            0.0f, std::max(33.3f, m_p99 * 1.25f), ImVec2(240.0f, 50.0f));
+
+        const float busy = m_last.updateMs + m_last.renderMs;
+        const float updateShare = busy > 0.0f ? m_last.updateMs / busy : 0.0f;
+        ImGui::Text("Update %.2f ms / Render %.2f ms", m_last.updateMs, m_last.renderMs);
+        ImGui::ProgressBar(updateShare, ImVec2(240.0f, 0.0f), "update | render");
+
+        ImGui::Text("Draw calls %zu   Vertices %zu", m_last.drawCalls, m_last.vertices);
+        ImGui::Text("Texturas %zu   Cambios de estado %zu", m_last.textureBinds, m_last.stateChanges);
+        if (m_last.overBudget) {
+            ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "Sobre el presupuesto de draw calls");
+        }
+        if (AllocationTracker::isEnabled()) {
+            ImGui::Text("Actores %zu   Reservas/frame %llu", m_last.entities, static_cast<unsigned long long>(m_last.allocations));
+        }
+        else {
+            ImGui::Text("Actores %zu   Reservas/frame n/d", m_last.entities);
+        }
+        ImGui::Text("Texturas %.2f MB", m_last.textureBytes / (1024.0 * 1024.0));
+    }
+    ImGui::End();
+}
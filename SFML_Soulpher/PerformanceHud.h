@@ -0,0 +1,64 @@
+#pragma once
+#include "Prerequisites.h"
+#include <array>
+#include <cstdint>
+
+/*
+  Estructura FrameSample
+  - Mediciones de un frame que la aplicacin entrega al HUD.
+*/
+struct FrameSample
+{
+    float frameMs = 0.0f;         // Tiempo total del frame (deltaTime).
+    float updateMs = 0.0f;        // Eventos, update y ticks de simulacin.
+    float renderMs = 0.0f;        // Preparacin del dibujo, envo y ImGui.
+    size_t drawCalls = 0;
+    size_t vertices = 0;
+    size_t textureBinds = 0;
+    size_t stateChanges = 0;
+    bool overBudget = false;      // El frame super el presupuesto de llamadas de dibujo.
+    size_t entities = 0;          // Actores vivos.
+    uint64_t allocations = 0;     // Reservas de memoria dinmica en el frame.
+    size_t textureBytes = 0;
+};
+
+/*
+  Clase PerformanceHud
+  - Superposicin de rendimiento en ImGui: FPS, grfica del tiempo de frame con percentiles
+    p50/p95/p99, reparto entre update y render, llamadas de dibujo, vrtices, actores vivos,
+    reservas de memoria por frame y memoria de texturas.
+  - Se muestra u oculta con F3 (o con --hud al iniciar). Oculta no mide ni dibuja nada:
+    la aplicacin consulta isVisible() antes de tomar las mediciones.
+  - Visible cuesta muy poco: las muestras se guardan en un arreglo circular fijo (sin reservas)
+    y los percentiles se recalculan cada PERCENTILE_INTERVAL frames.
+*/
+class PerformanceHud
+{
+public:
+    static constexpr size_t HISTORY = 240;             // Frames en la grfica (4 s a 60 FPS).
+    static constexpr int PERCENTILE_INTERVAL = 15;     // Frames entre clculos de percentiles.
+
+    void setVisible(bool visible);
+    bool isVisible() const;
+    void toggle();
+
+    // Agrega las mediciones de un frame.
+    void addSample(const FrameSample& sample);
+
+    // Dibuja la ventana del HUD (solo si est visible).
+    void draw();
+
+private:
+    void updatePercentiles();
+
+    std::array<float, HISTORY> m_frameMs{};
+    std::array<float, HISTORY> m_sorted{};
+    size_t m_next = 0;
+    size_t m_count = 0;
+    int m_framesUntilPercentiles = 0;
+    float m_p50 = 0.0f;
+    float m_p95 = 0.0f;
+    float m_p99 = 0.0f;
+    FrameSample m_last;
+    bool m_visible = false;
+};
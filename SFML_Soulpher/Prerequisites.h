@@ -43,36 +43,12 @@ enum ShapeType
 #define SAFE_PTR_RELEASE(x) if(x != nullptr) { delete x; x = nullptr; }
 
  /*
-   Macro MESSAGE
-   - Imprime un mensaje de informacin cuando se crea un recurso.
-   Esta macro se utiliza para depurar el estado de creacin de recursos, como ventanas o actores,
-   mostrando en la consola el nombre de la clase y mtodo donde se ejecuta.
-   En grficas computacionales 3D, este tipo de mensajes es til para rastrear la creacin de objetos
-   complejos como mallas y texturas en tiempo real.
+   Log
+   - Los mensajes se escriben con las macros LOG_TRACE, LOG_DEBUG, LOG_INFO, LOG_WARN, LOG_ERROR
+     y LOG_FATAL (ver Logger.h), que reemplazan a las antiguas macros MESSAGE y ERROR:
+     LOG_INFO("Window", "Window", "OK") o LOG_FATAL("Window", "clear", "CHECK FOR WINDOW POINTER DATA").
+   - El hilo que escribe solo guarda un registro compacto en su propia cola; el formato y la salida
+     a consola se hacen en un hilo de fondo, as que se puede usar en funciones del frame.
+   - LOG_FATAL termina el programa igual que lo haca ERROR.
  */
-
-#define MESSAGE(classObj, method, state)                      \
-{                                                             \
-    std::ostringstream os_;                                   \
-    os_ << classObj << "::" << method << " : "                \
-        << "[CREATION OF RESOURCE" << ": " << state << "] \n";\
-    std::cerr << os_.str();                                   \
-}
-
-  /*
-    Macro ERROR
-    - Imprime un mensaje de error detallado y termina la ejecucin del programa.
-    Esta macro es crucial para detectar errores en tiempo de ejecucin, mostrando el nombre de la clase,
-    mtodo y un mensaje de error especfico. Si ocurre un error, se detiene la ejecucin inmediatamente.
-    En un entorno 3D, se puede utilizar para identificar fallos en la inicializacin de objetos,
-    como la carga de texturas, la creacin de buffers de vrtices, o problemas en el enlace de shaders.
-  */
-
-#define ERROR(classObj, method, errorMSG)                         \
-{                                                                 \
-    std::ostringstream os_;                                       \
-    os_ << "ERROR : " << classObj << "::" << method << " : "      \
-        << "  Error en los datos de los parmetros [" << errorMSG << "] \n"; \
-    std::cerr << os_.str();                                       \
-    exit(1);                                                      \
-}
+#include "Logger.h"
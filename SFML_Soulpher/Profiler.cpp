@@ -0,0 +1,491 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string_view>
+#include <unordered_map>
+
+namespace
+{
+    const std::chrono::steady_clock::time_point s_epoch = std::chrono::steady_clock::now();
+
+    thread_local ProfileThreadBuffer* t_buffer = nullptr;
+
+#ifdef SOULPHER_PROFILING
+    constexpr bool ENABLED_AT_START = true;
+#else
+    constexpr bool ENABLED_AT_START = false;
+#endif
+
+    constexpr int WORST_FRAMES = 5;
+    constexpr float FLAME_ROW_HEIGHT = 18.0f;
+
+    // Color estable por nombre de mbito (el mismo mbito siempre tiene el mismo color).
+    ImU32 scopeColor(const char* name) {
+        uint32_t hash = 2166136261u;
+        for (const char* c = name; *c != '\0'; ++c) {
+            hash = (hash ^ static_cast<uint8_t>(*c)) * 16777619u;
+        }
+        const float hue = (hash % 360) / 360.0f;
+        float r, g, b;
+        ImGui::ColorConvertHSVtoRGB(hue, 0.55f, 0.85f, r, g, b);
+        return ImGui::ColorConvertFloat4ToU32(ImVec4(r, g, b, 1.0f));
+    }
+
+    double toMs(uint64_t nanoseconds) {
+        return nanoseconds / 1000000.0;
+    }
+}
+
+ProfileThreadBuffer::ProfileThreadBuffer(const std::string& name, uint16_t index)
+    : m_events(new ProfileEvent[CAPACITY]), m_name(name), m_index(index) {
+}
+
+/*
+   El productor solo escribe en posiciones que el consumidor ya ley; la escritura de m_head
+   con release publica el evento completo.
+*/
+bool ProfileThreadBuffer::push(const ProfileEvent& event) {
+    const size_t head = m_head.load(std::memory_order_relaxed);
+    if (head - m_tail.load(std::memory_order_acquire) >= CAPACITY) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    m_events[head % CAPACITY] = event;
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+void ProfileThreadBuffer::drain(std::vector<ProfileEvent>& out) {
+    const size_t tail = m_tail.load(std::memory_order_relaxed);
+    const size_t head = m_head.load(std::memory_order_acquire);
+    for (size_t i = tail; i != head; ++i) {
+        out.push_back(m_events[i % CAPACITY]);
+    }
+    m_tail.store(head, std::memory_order_release);
+}
+
+const std::string& ProfileThreadBuffer::getName() const {
+    return m_name;
+}
+
+void ProfileThreadBuffer::setName(const std::string& name) {
+    m_name = name;
+}
+
+uint16_t ProfileThreadBuffer::getIndex() const {
+    return m_index;
+}
+
+uint64_t ProfileThreadBuffer::getDropped() const {
+    return m_dropped.load(std::memory_order_relaxed);
+}
+
+std::atomic<bool> Profiler::s_enabled{ ENABLED_AT_START };
+
+Profiler::Profiler()
+    : m_frameStart(now()) {
+}
+
+Profiler& Profiler::getInstance() {
+    static Profiler instance;
+    return instance;
+}
+
+uint64_t Profiler::now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - s_epoch).count());
+}
+
+// Solo la primera llamada de cada hilo toma el candado.
+ProfileThreadBuffer& Profiler::getThreadBuffer() {
+    if (t_buffer == nullptr) {
+        t_buffer = &getInstance().registerThread();
+    }
+    return *t_buffer;
+}
+
+/*
+   Las colas no se liberan al terminar su hilo: el consumidor podra estar leyndolas,
+   y el nmero de hilos del programa es pequeo y fijo.
+*/
+ProfileThreadBuffer& Profiler::registerThread() {
+    std::lock_guard<std::mutex> lock(m_threadsMutex);
+    const uint16_t index = static_cast<uint16_t>(m_threads.size());
+    m_threads.push_back(std::make_unique<ProfileThreadBuffer>("Thread " + std::to_string(index), index));
+    return *m_threads.back();
+}
+
+void Profiler::setThreadName(const std::string& name) {
+    ProfileThreadBuffer& buffer = getThreadBuffer();
+    std::lock_guard<std::mutex> lock(m_threadsMutex);
+    buffer.setName(name);
+}
+
+void Profiler::setEnabled(bool enabled) {
+    if (enabled && !isEnabled()) {
+        m_frameStart = now();  // El primer frame medido empieza ahora, no cuando se desactiv.
+    }
+    s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+/*
+   Vaca todas las colas en el frame que termina y descarta los frames ms viejos que el historial.
+   En pausa las colas se siguen vaciando (para que no se llenen), pero el historial no cambia.
+*/
+void Profiler::endFrame() {
+    if (!isEnabled()) {
+        return;
+    }
+    const uint64_t frameEnd = now();
+
+    m_drained.clear();
+    {
+        std::lock_guard<std::mutex> lock(m_threadsMutex);
+        for (auto& thread : m_threads) {
+            thread->drain(m_drained);
+        }
+    }
+
+    if (m_tracing) {
+        ProfileEvent frameEvent;
+        frameEvent.name = "Frame";
+        frameEvent.start = m_frameStart;
+        frameEvent.end = frameEnd;
+        frameEvent.thread = getThreadBuffer().getIndex();
+        m_trace.push_back(frameEvent);
+        m_trace.insert(m_trace.end(), m_drained.begin(), m_drained.end());
+        if (m_trace.size() >= MAX_TRACE_EVENTS) {
+            LOG_WARN("Profiler", "endFrame", "la traza llego a {} eventos, se guarda y se detiene", MAX_TRACE_EVENTS);
+            stopTrace();
+        }
+    }
+
+    if (!m_paused) {
+        Frame frame;
+        frame.index = m_frameIndex;
+        frame.start = m_frameStart;
+        frame.end = frameEnd;
+        frame.events = m_drained;
+        m_frames.push_back(std::move(frame));
+
+        const uint64_t history = static_cast<uint64_t>(HISTORY_SECONDS * 1e9);
+        while (!m_frames.empty() && frameEnd - m_frames.front().end > history) {
+            m_frames.pop_front();
+        }
+    }
+
+    ++m_frameIndex;
+    m_frameStart = frameEnd;
+}
+
+const std::deque<Profiler::Frame>& Profiler::getFrames() const {
+    return m_frames;
+}
+
+std::string Profiler::getThreadName(uint16_t thread) const {
+    std::lock_guard<std::mutex> lock(m_threadsMutex);
+    return thread < m_threads.size() ? m_threads[thread]->getName() : std::string();
+}
+
+size_t Profiler::getThreadCount() const {
+    std::lock_guard<std::mutex> lock(m_threadsMutex);
+    return m_threads.size();
+}
+
+/*
+   Panel del profiler:
+   - Resumen del historial y eventos descartados.
+   - Frames ms lentos (clic para ver su flame graph).
+   - Flame graph del frame elegido (por defecto, el ltimo).
+   - Estadsticas por mbito sobre todo el historial (tiempo inclusivo: incluye los mbitos hijos).
+*/
+void Profiler::drawPanel() {
+    ImGui::Begin("PROFILER");
+
+    ImGui::Checkbox("Pausa", &m_paused);
+    ImGui::SameLine();
+    if (ImGui::Button("Ultimo frame")) {
+        m_selectedFrame = UINT64_MAX;
+    }
+    ImGui::SameLine();
+    if (m_tracing) {
+        char label[64];
+        std::snprintf(label, sizeof(label), "Detener traza (%zu eventos)", m_trace.size());
+        if (ImGui::Button(label)) {
+            stopTrace();
+        }
+    }
+    else if (ImGui::Button("Grabar traza (F9)")) {
+        startTrace();
+    }
+
+    if (m_frames.empty()) {
+        ImGui::Text("Sin frames registrados.");
+        ImGui::End();
+        return;
+    }
+
+    uint64_t totalFrameTime = 0;
+    uint64_t dropped = 0;
+    for (const Frame& frame : m_frames) {
+        totalFrameTime += frame.end - frame.start;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_threadsMutex);
+        for (const auto& thread : m_threads) {
+            dropped += thread->getDropped();
+        }
+    }
+    ImGui::SameLine();
+    ImGui::Text("%zu frames (%.1f s), media %.2f ms, %llu eventos descartados", m_frames.size(),
+        toMs(m_frames.back().end - m_frames.front().start) / 1000.0, toMs(totalFrameTime) / m_frames.size(),
+        static_cast<unsigned long long>(dropped));
+
+    // Frames ms lentos del historial.
+    std::vector<const Frame*> worst;
+    for (const Frame& frame : m_frames) {
+        worst.push_back(&frame);
+    }
+    const size_t worstCount = std::min<size_t>(WORST_FRAMES, worst.size());
+    std::partial_sort(worst.begin(), worst.begin() + worstCount, worst.end(), [](const Frame* a, const Frame* b) {
+        return a->end - a->start > b->end - b->start;
+        });
+    ImGui::Text("Frames mas lentos:");
+    for (size_t i = 0; i < worstCount; ++i) {
+        ImGui::SameLine();
+        char label[48];
+        std::snprintf(label, sizeof(label), "#%llu %.1f ms", static_cast<unsigned long long>(worst[i]->index),
+            toMs(worst[i]->end - worst[i]->start));
+        if (ImGui::SmallButton(label)) {
+            m_selectedFrame = worst[i]->index;
+        }
+    }
+
+    const Frame* selected = &m_frames.back();
+    for (const Frame& frame : m_frames) {
+        if (frame.index == m_selectedFrame) {
+            selected = &frame;
+        }
+    }
+    ImGui::Separator();
+    ImGui::Text("Frame #%llu: %.3f ms", static_cast<unsigned long long>(selected->index), toMs(selected->end - selected->start));
+    drawFlameGraph(*selected);
+
+    // Estadsticas por mbito.
+    struct ScopeStats
+    {
+        uint64_t calls = 0;
+        uint64_t total = 0;
+        uint64_t max = 0;
+    };
+    std::unordered_map<std::string_view, ScopeStats> stats;
+    for (const Frame& frame : m_frames) {
+        for (const ProfileEvent& event : frame.events) {
+            ScopeStats& scope = stats[event.name];
+            const uint64_t duration = event.end - event.start;
+            ++scope.calls;
+            scope.total += duration;
+            scope.max = std::max(scope.max, duration);
+        }
+    }
+    std::vector<std::pair<std::string_view, ScopeStats>> sorted(stats.begin(), stats.end());
+    std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) { return a.second.total > b.second.total; });
+
+    ImGui::Separator();
+    if (ImGui::BeginTable("ProfilerStats", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp)) {
+        ImGui::TableSetupColumn("Ambito");
+        ImGui::TableSetupColumn("Llamadas/frame");
+        ImGui::TableSetupColumn("ms/frame");
+        ImGui::TableSetupColumn("ms/llamada");
+        ImGui::TableSetupColumn("Max ms");
+        ImGui::TableHeadersRow();
+        const double frames = static_cast<double>(m_frames.size());
+        for (const auto& [name, scope] : sorted) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(name.data(), name.data() + name.size());
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", scope.calls / frames);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", toMs(scope.total) / frames);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", toMs(scope.total) / scope.calls);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", toMs(scope.max));
+        }
+        ImGui::EndTable();
+    }
+
+    ImGui::End();
+}
+
+/*
+   Empieza una traza vaca; los eventos se agregan en cada endFrame.
+*/
+void Profiler::startTrace(const std::string& path) {
+    if (!path.empty()) {
+        m_tracePath = path;
+    }
+    if (m_tracing) {
+        return;
+    }
+    m_trace.clear();
+    m_tracing = true;
+    if (!isEnabled()) {
+        m_enabledByTrace = true;
+        setEnabled(true);
+    }
+    LOG_INFO("Profiler", "startTrace", "grabando traza en [{}]", m_tracePath);
+}
+
+bool Profiler::stopTrace() {
+    if (!m_tracing) {
+        return false;
+    }
+    m_tracing = false;
+    if (m_enabledByTrace) {
+        m_enabledByTrace = false;
+        setEnabled(false);
+    }
+
+    const bool written = writeChromeTrace(m_tracePath);
+    if (written) {
+        LOG_INFO("Profiler", "stopTrace", "{} eventos guardados en [{}]", m_trace.size(), m_tracePath);
+    }
+    m_trace.clear();
+    m_trace.shrink_to_fit();
+    return written;
+}
+
+void Profiler::toggleTrace() {
+    if (m_tracing) {
+        stopTrace();
+    }
+    else {
+        startTrace();
+    }
+}
+
+bool Profiler::isTracing() const {
+    return m_tracing;
+}
+
+size_t Profiler::getTraceEventCount() const {
+    return m_trace.size();
+}
+
+/*
+   Formato Chrome trace-event (JSON):
+   - Un evento "M" (metadatos) por hilo con su nombre y su orden, as cada hilo es una pista.
+   - Un evento "X" (completo) por mbito, con inicio y duracin en microsegundos.
+   Los nombres de los mbitos son literales del cdigo, pero se escapan por si acaso.
+*/
+bool Profiler::writeChromeTrace(const std::string& path) const {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        LOG_ERROR("Profiler", "writeChromeTrace", "no se pudo crear [{}]", path);
+        return false;
+    }
+
+    auto escape = [](const std::string& text) {
+        std::string escaped;
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                escaped += '\\';
+            }
+            escaped += (static_cast<unsigned char>(c) < 0x20) ? ' ' : c;
+        }
+        return escaped;
+    };
+
+    out << "{\"traceEvents\":[\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"SFML_Soulpher\"}}";
+    {
+        std::lock_guard<std::mutex> lock(m_threadsMutex);
+        for (const auto& thread : m_threads) {
+            out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread->getIndex()
+                << ",\"args\":{\"name\":\"" << escape(thread->getName()) << "\"}}";
+            out << ",\n{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread->getIndex()
+                << ",\"args\":{\"sort_index\":" << thread->getIndex() << "}}";
+        }
+    }
+
+    std::unordered_map<const char*, std::string> names;
+    char line[512];
+    for (const ProfileEvent& event : m_trace) {
+        auto name = names.find(event.name);
+        if (name == names.end()) {
+            name = names.emplace(event.name, escape(event.name)).first;
+        }
+        std::snprintf(line, sizeof(line), ",\n{\"name\":\"%s\",\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+            name->second.c_str(), static_cast<unsigned int>(event.thread), event.start / 1000.0, (event.end - event.start) / 1000.0);
+        out << line;
+    }
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    if (!out) {
+        LOG_ERROR("Profiler", "writeChromeTrace", "error al escribir [{}]", path);
+        return false;
+    }
+    return true;
+}
+
+/*
+   Flame graph de un frame: una franja por hilo, una fila por nivel de anidamiento,
+   y el eje horizontal es el tiempo del frame. Los eventos de otros hilos se recortan al frame.
+*/
+void Profiler::drawFlameGraph(const Frame& frame) {
+    std::vector<uint16_t> threads;
+    std::vector<uint16_t> maxDepth;
+    for (const ProfileEvent& event : frame.events) {
+        auto found = std::find(threads.begin(), threads.end(), event.thread);
+        if (found == threads.end()) {
+            threads.push_back(event.thread);
+            maxDepth.push_back(event.depth);
+        }
+        else {
+            uint16_t& depth = maxDepth[found - threads.begin()];
+            depth = std::max(depth, event.depth);
+        }
+    }
+
+    const float width = std::max(100.0f, ImGui::GetContentRegionAvail().x);
+    const double frameDuration = static_cast<double>(std::max<uint64_t>(1, frame.end - frame.start));
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+    for (size_t t = 0; t < threads.size(); ++t) {
+        ImGui::TextUnformatted(getThreadName(threads[t]).c_str());
+        const ImVec2 origin = ImGui::GetCursorScreenPos();
+        const float height = (maxDepth[t] + 1) * FLAME_ROW_HEIGHT;
+        ImGui::InvisibleButton(("flame" + std::to_string(threads[t])).c_str(), ImVec2(width, height));
+        drawList->AddRectFilled(origin, ImVec2(origin.x + width, origin.y + height), IM_COL32(30, 30, 30, 255));
+
+        for (const ProfileEvent& event : frame.events) {
+            if (event.thread != threads[t]) {
+                continue;
+            }
+            const uint64_t start = std::max(event.start, frame.start);
+            const uint64_t end = std::min(event.end, frame.end);
+            if (end <= start) {
+                continue;
+            }
+            const float x0 = origin.x + static_cast<float>((start - frame.start) / frameDuration) * width;
+            const float x1 = std::max(x0 + 1.0f, origin.x + static_cast<float>((end - frame.start) / frameDuration) * width);
+            const float y0 = origin.y + event.depth * FLAME_ROW_HEIGHT;
+            const ImVec2 minCorner(x0, y0);
+            const ImVec2 maxCorner(x1, y0 + FLAME_ROW_HEIGHT - 1.0f);
+
+            drawList->AddRectFilled(minCorner, maxCorner, scopeColor(event.name));
+            if (x1 - x0 > 30.0f) {
+                drawList->PushClipRect(minCorner, maxCorner, true);
+                drawList->AddText(ImVec2(x0 + 2.0f, y0 + 2.0f), IM_COL32(0, 0, 0, 255), event.name);
+                drawList->PopClipRect();
+            }
+            if (ImGui::IsMouseHoveringRect(minCorner, maxCorner)) {
+                ImGui::SetTooltip("%s\n%.3f ms", event.name, toMs(event.end - event.start));
+            }
+        }
+    }
+}
@@ -0,0 +1,228 @@
+#pragma once
+#include "Prerequisites.h"
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+/*
+  Estructura ProfileEvent
+  - Un mbito medido: nombre, inicio y fin en nanosegundos desde que arranc el profiler,
+    profundidad de anidamiento dentro de su hilo e ndice del hilo.
+*/
+struct ProfileEvent
+{
+    const char* name = nullptr;  // Literal de vida esttica (no se copia).
+    uint64_t start = 0;
+    uint64_t end = 0;
+    uint16_t depth = 0;          // 0 = mbito raz del hilo.
+    uint16_t thread = 0;         // Orden en que se registr el hilo.
+};
+
+/*
+  Clase ProfileThreadBuffer
+  - Cola circular de eventos de un solo hilo productor (el dueo) y un solo consumidor (el hilo
+    principal en Profiler::endFrame). No usa candados: cada lado avanza su propio ndice atmico.
+  - Si la cola se llena, los eventos nuevos se descartan y se cuentan en lugar de bloquear al hilo.
+*/
+class ProfileThreadBuffer
+{
+public:
+    ProfileThreadBuffer(const std::string& name, uint16_t index);
+
+    // (Productor) Agrega un evento. false si la cola est llena.
+    bool push(const ProfileEvent& event);
+
+    // (Consumidor) Mueve a out todos los eventos disponibles.
+    void drain(std::vector<ProfileEvent>& out);
+
+    const std::string& getName() const;
+    void setName(const std::string& name);
+    uint16_t getIndex() const;
+    uint64_t getDropped() const;
+
+    uint16_t depth = 0;  // mbitos abiertos en el hilo (solo lo toca el dueo).
+
+private:
+    static constexpr size_t CAPACITY = 1 << 14;
+
+    std::unique_ptr<ProfileEvent[]> m_events;
+    std::atomic<size_t> m_head{ 0 };      // Siguiente posicin a escribir (productor).
+    std::atomic<size_t> m_tail{ 0 };      // Siguiente posicin a leer (consumidor).
+    std::atomic<uint64_t> m_dropped{ 0 };
+    std::string m_name;                   // Protegido por el candado de registro del Profiler.
+    uint16_t m_index;
+};
+
+/*
+  Clase Profiler
+  - Profiler de CPU por mbitos jerrquicos. Cada hilo escribe en su propio ProfileThreadBuffer;
+    el hilo principal los vaca una vez por frame (endFrame) y conserva los frames de los ltimos
+    HISTORY_SECONDS segundos.
+  - drawPanel muestra en ImGui un flame graph del frame elegido, estadsticas por mbito y los
+    frames ms lentos del historial.
+  - Puede grabar una traza (startTrace/stopTrace) con todos los eventos de todos los hilos y guardarla
+    en formato Chrome trace-event JSON, que se abre en chrome://tracing o en ui.perfetto.dev con una
+    pista por hilo (principal, simulacin, hilos de trabajo y de carga de recursos).
+  - Se usa a travs de las macros PROFILE_SCOPE, PROFILE_THREAD y PROFILE_FRAME, compiladas en todas
+    las configuraciones. La medicin se activa en tiempo de ejecucin (setEnabled): con
+    SOULPHER_PROFILING (configuraciones Debug) empieza activa; en Release empieza inactiva y solo se
+    activa mientras se graba una traza, de modo que --trace y F9 tambin funcionan en Release.
+    Inactivo, cada PROFILE_SCOPE cuesta una lectura atmica.
+  En motores 3D, este tipo de profiler instrumentado complementa al profiler por muestreo: mide
+  exactamente los mbitos que el motor conoce (frame, simulacin, render, carga) y sus picos.
+*/
+class Profiler
+{
+public:
+    struct Frame
+    {
+        uint64_t index = 0;
+        uint64_t start = 0;
+        uint64_t end = 0;
+        std::vector<ProfileEvent> events;  // Eventos de todos los hilos que terminaron en este frame.
+    };
+
+    static constexpr double HISTORY_SECONDS = 10.0;
+
+    static Profiler& getInstance();
+
+    // Nanosegundos desde que arranc el programa (reloj monotnico).
+    static uint64_t now();
+
+    /*
+      Funcin getThreadBuffer.
+      - Cola del hilo actual; la primera llamada de cada hilo la registra (con candado).
+    */
+    static ProfileThreadBuffer& getThreadBuffer();
+
+    // Nombre del hilo actual en el panel (por ejemplo "Main", "Simulation", "Worker 2").
+    void setThreadName(const std::string& name);
+
+    /*
+      Funcin setEnabled.
+      - Activa o desactiva la medicin de mbitos y el historial de frames. startTrace la activa
+        si estaba inactiva y stopTrace la vuelve a desactivar.
+    */
+    void setEnabled(bool enabled);
+
+    // Indica si los mbitos se estn midiendo (se puede llamar desde cualquier hilo).
+    static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+    /*
+      Funcin endFrame.
+      - Cierra el frame actual: vaca las colas de todos los hilos y lo agrega al historial.
+      - Se llama una vez por frame desde el hilo principal.
+    */
+    void endFrame();
+
+    // Dibuja el panel "PROFILER" de ImGui.
+    void drawPanel();
+
+    /*
+      Funcin startTrace.
+      - Empieza a grabar una traza que se guardar en path al detenerla. Con path vaco se usa
+        la ruta de la traza anterior ("soulpher_trace.json" la primera vez).
+    */
+    void startTrace(const std::string& path = std::string());
+
+    /*
+      Funcin stopTrace.
+      - Deja de grabar y escribe la traza en formato Chrome trace-event JSON.
+      - Devuelve false si no se estaba grabando o no se pudo escribir el archivo.
+    */
+    bool stopTrace();
+
+    // Alterna entre startTrace() y stopTrace().
+    void toggleTrace();
+
+    bool isTracing() const;
+
+    // Eventos grabados en la traza en curso.
+    size_t getTraceEventCount() const;
+
+    // Historial de frames (solo desde el hilo principal).
+    const std::deque<Frame>& getFrames() const;
+
+    // Nombre del hilo con ndice thread.
+    std::string getThreadName(uint16_t thread) const;
+
+    // Nmero de hilos registrados.
+    size_t getThreadCount() const;
+
+private:
+    Profiler();
+
+    ProfileThreadBuffer& registerThread();
+    void drawFlameGraph(const Frame& frame);
+    bool writeChromeTrace(const std::string& path) const;
+
+    // Lmite de eventos de una traza (~64 MB); al llegar a l se guarda y se detiene.
+    static constexpr size_t MAX_TRACE_EVENTS = 2000000;
+
+    static std::atomic<bool> s_enabled;                         // Medicin activa.
+
+    mutable std::mutex m_threadsMutex;                          // Protege el registro de hilos.
+    std::vector<std::unique_ptr<ProfileThreadBuffer>> m_threads;
+    std::deque<Frame> m_frames;
+    std::vector<ProfileEvent> m_drained;                        // Reutilizado en cada endFrame.
+    uint64_t m_frameStart = 0;
+    uint64_t m_frameIndex = 0;
+    uint64_t m_selectedFrame = UINT64_MAX;                      // UINT64_MAX = ltimo frame.
+    bool m_paused = false;
+
+    // Traza en curso.
+    bool m_tracing = false;
+    bool m_enabledByTrace = false;                              // La traza activ la medicin.
+    std::string m_tracePath = "soulpher_trace.json";
+    std::vector<ProfileEvent> m_trace;
+};
+
+/*
+  Clase ProfileScope
+  - Mide desde su construccin hasta su destruccin y lo registra en la cola del hilo.
+  - Si el profiler est inactivo al construirse, no mide nada.
+*/
+class ProfileScope
+{
+public:
+    explicit ProfileScope(const char* name) {
+        if (!Profiler::isEnabled()) {
+            return;
+        }
+        m_buffer = &Profiler::getThreadBuffer();
+        m_name = name;
+        m_depth = m_buffer->depth++;
+        m_start = Profiler::now();
+    }
+
+    ~ProfileScope() {
+        if (m_buffer == nullptr) {
+            return;
+        }
+        ProfileEvent event;
+        event.name = m_name;
+        event.start = m_start;
+        event.end = Profiler::now();
+        event.depth = m_depth;
+        event.thread = m_buffer->getIndex();
+        --m_buffer->depth;
+        m_buffer->push(event);
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    ProfileThreadBuffer* m_buffer = nullptr;  // nullptr: el profiler estaba inactivo.
+    const char* m_name = nullptr;
+    uint16_t m_depth = 0;
+    uint64_t m_start = 0;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_THREAD(name) Profiler::getInstance().setThreadName(name)
+#define PROFILE_FRAME() Profiler::getInstance().endFrame()
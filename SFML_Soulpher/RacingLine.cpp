@@ -0,0 +1,250 @@
+#include "RacingLine.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    constexpr int SUBSTEPS = 64;        // Evaluaciones por tramo al medir la longitud de la curva.
+    constexpr float MIN_KNOT = 1e-4f;   // Evita divisiones entre cero con waypoints repetidos.
+
+    float lengthOf(const sf::Vector2f& v) {
+        return std::sqrt(v.x * v.x + v.y * v.y);
+    }
+
+    float squaredLength(const sf::Vector2f& v) {
+        return v.x * v.x + v.y * v.y;
+    }
+
+    // Interpolacin de un paso del algoritmo de Barry-Goldman.
+    sf::Vector2f blend(const sf::Vector2f& a, const sf::Vector2f& b, float ta, float tb, float t) {
+        return a * ((tb - t) / (tb - ta)) + b * ((t - ta) / (tb - ta));
+    }
+}
+
+/*
+   1. Mide la curva con SUBSTEPS cuerdas por tramo (longitud acumulada contra parmetro t).
+   2. Ajusta el espaciado para que la vuelta tenga un nmero entero de muestras.
+   3. Recorre la tabla acumulada una sola vez para colocar una muestra cada m_spacing unidades.
+*/
+bool RacingLine::build(const std::vector<sf::Vector2f>& points, float spacing) {
+    m_points.clear();
+    m_samples.clear();
+    m_tree.clear();
+    m_length = 0.0f;
+    if (points.size() < 3 || spacing <= 0.0f) {
+        LOG_ERROR("RacingLine", "build", "se necesitan al menos 3 puntos y un espaciado positivo");
+        return false;
+    }
+    m_points = points;
+
+    const size_t segments = m_points.size();
+    std::vector<float> parameters;
+    std::vector<float> distances;
+    parameters.reserve(segments * SUBSTEPS + 1);
+    distances.reserve(segments * SUBSTEPS + 1);
+
+    sf::Vector2f previous = evaluate(0.0f);
+    parameters.push_back(0.0f);
+    distances.push_back(0.0f);
+    for (size_t step = 1; step <= segments * SUBSTEPS; ++step) {
+        const float t = static_cast<float>(step) / SUBSTEPS;
+        const sf::Vector2f current = evaluate(t);
+        parameters.push_back(t);
+        distances.push_back(distances.back() + lengthOf(current - previous));
+        previous = current;
+    }
+    m_length = distances.back();
+
+    const size_t count = std::max<size_t>(static_cast<size_t>(m_length / spacing), 3);
+    m_spacing = m_length / count;
+    m_samples.reserve(count);
+
+    size_t j = 0;
+    for (size_t k = 0; k < count; ++k) {
+        const float s = k * m_spacing;
+        while (j + 2 < distances.size() && distances[j + 1] < s) {
+            ++j;
+        }
+        const float span = distances[j + 1] - distances[j];
+        const float fraction = span > 0.0f ? (s - distances[j]) / span : 0.0f;
+        m_samples.push_back(evaluate(parameters[j] + (parameters[j + 1] - parameters[j]) * fraction));
+    }
+
+    m_tree.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        m_tree[i].sample = static_cast<uint32_t>(i);
+    }
+    buildTree(0, count, 0);
+    return true;
+}
+
+bool RacingLine::isValid() const {
+    return !m_samples.empty();
+}
+
+float RacingLine::getLength() const {
+    return m_length;
+}
+
+// O(1): la distancia se convierte directamente en ndice de la tabla.
+sf::Vector2f RacingLine::sample(float distance) const {
+    if (m_samples.empty()) {
+        return sf::Vector2f();
+    }
+    float wrapped = std::fmod(distance, m_length);
+    if (wrapped < 0.0f) {
+        wrapped += m_length;
+    }
+    const float position = wrapped / m_spacing;
+    const size_t index = std::min(static_cast<size_t>(position), m_samples.size() - 1);
+    const float fraction = position - index;
+    const sf::Vector2f& a = m_samples[index];
+    const sf::Vector2f& b = m_samples[(index + 1) % m_samples.size()];
+    return a + (b - a) * fraction;
+}
+
+// Diferencia central entre las muestras vecinas.
+sf::Vector2f RacingLine::tangent(float distance) const {
+    const sf::Vector2f direction = sample(distance + m_spacing) - sample(distance - m_spacing);
+    const float length = lengthOf(direction);
+    return length > 0.0f ? direction / length : sf::Vector2f(1.0f, 0.0f);
+}
+
+/*
+   La muestra ms cercana se busca en el rbol k-d; despus se proyecta sobre los dos tramos que
+   la tocan, para no quedar limitado a la resolucin de la tabla.
+*/
+float RacingLine::project(const sf::Vector2f& position, float* squaredOffset) const {
+    if (m_samples.empty()) {
+        if (squaredOffset != nullptr) {
+            *squaredOffset = 0.0f;
+        }
+        return 0.0f;
+    }
+
+    uint32_t closest = 0;
+    float closestDistance = std::numeric_limits<float>::max();
+    nearest(0, m_tree.size(), position, closest, closestDistance);
+
+    const size_t count = m_samples.size();
+    float bestDistance = std::numeric_limits<float>::max();
+    float bestProgress = 0.0f;
+    for (size_t start : { (closest + count - 1) % count, static_cast<size_t>(closest) }) {
+        const sf::Vector2f& a = m_samples[start];
+        const sf::Vector2f segment = m_samples[(start + 1) % count] - a;
+        const float segmentLength = squaredLength(segment);
+        float u = segmentLength > 0.0f ? ((position.x - a.x) * segment.x + (position.y - a.y) * segment.y) / segmentLength : 0.0f;
+        u = std::clamp(u, 0.0f, 1.0f);
+        const float distance = squaredLength(position - (a + segment * u));
+        if (distance < bestDistance) {
+            bestDistance = distance;
+            bestProgress = (start + u) * m_spacing;
+        }
+    }
+
+    if (squaredOffset != nullptr) {
+        *squaredOffset = bestDistance;
+    }
+    return bestProgress >= m_length ? bestProgress - m_length : bestProgress;
+}
+
+std::vector<sf::Vector2f> RacingLine::resample(float spacing) const {
+    std::vector<sf::Vector2f> points;
+    if (m_samples.empty() || spacing <= 0.0f) {
+        return points;
+    }
+    const size_t count = std::max<size_t>(static_cast<size_t>(m_length / spacing), 3);
+    points.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        points.push_back(sample(i * m_length / count));
+    }
+    return points;
+}
+
+const std::vector<sf::Vector2f>& RacingLine::getSamples() const {
+    return m_samples;
+}
+
+/*
+   Catmull-Rom centrpeta (alpha = 0.5) con el algoritmo de Barry-Goldman. El tramo i va del
+   waypoint i al i + 1; la lnea es cerrada, as que los ndices dan la vuelta.
+*/
+sf::Vector2f RacingLine::evaluate(float t) const {
+    const size_t count = m_points.size();
+    size_t segment = static_cast<size_t>(t);
+    float u = t - segment;
+    if (segment >= count) {
+        segment = count - 1;
+        u = 1.0f;
+    }
+
+    const sf::Vector2f& p0 = m_points[(segment + count - 1) % count];
+    const sf::Vector2f& p1 = m_points[segment];
+    const sf::Vector2f& p2 = m_points[(segment + 1) % count];
+    const sf::Vector2f& p3 = m_points[(segment + 2) % count];
+
+    const float t0 = 0.0f;
+    const float t1 = t0 + std::max(std::sqrt(lengthOf(p1 - p0)), MIN_KNOT);
+    const float t2 = t1 + std::max(std::sqrt(lengthOf(p2 - p1)), MIN_KNOT);
+    const float t3 = t2 + std::max(std::sqrt(lengthOf(p3 - p2)), MIN_KNOT);
+    const float tt = t1 + (t2 - t1) * u;
+
+    const sf::Vector2f a1 = blend(p0, p1, t0, t1, tt);
+    const sf::Vector2f a2 = blend(p1, p2, t1, t2, tt);
+    const sf::Vector2f a3 = blend(p2, p3, t2, t3, tt);
+    const sf::Vector2f b1 = blend(a1, a2, t0, t2, tt);
+    const sf::Vector2f b2 = blend(a2, a3, t1, t3, tt);
+    return blend(b1, b2, t1, t2, tt);
+}
+
+// Los ejes se alternan por profundidad; nth_element coloca la mediana en la mitad del rango.
+void RacingLine::buildTree(size_t begin, size_t end, uint32_t depth) {
+    if (end - begin <= 1) {
+        if (begin < end) {
+            m_tree[begin].axis = depth % 2;
+        }
+        return;
+    }
+    const uint32_t axis = depth % 2;
+    const size_t middle = begin + (end - begin) / 2;
+    std::nth_element(m_tree.begin() + begin, m_tree.begin() + middle, m_tree.begin() + end,
+        [this, axis](const KdNode& a, const KdNode& b) {
+            const sf::Vector2f& pa = m_samples[a.sample];
+            const sf::Vector2f& pb = m_samples[b.sample];
+            return axis == 0 ? pa.x < pb.x : pa.y < pb.y;
+        });
+    m_tree[middle].axis = axis;
+    buildTree(begin, middle, depth + 1);
+    buildTree(middle + 1, end, depth + 1);
+}
+
+// Primero baja por el lado de la posicin; el otro lado solo se visita si puede tener algo ms cerca.
+void RacingLine::nearest(size_t begin, size_t end, const sf::Vector2f& position, uint32_t& best, float& bestDistance) const {
+    if (begin >= end) {
+        return;
+    }
+    const size_t middle = begin + (end - begin) / 2;
+    const KdNode& node = m_tree[middle];
+    const sf::Vector2f& point = m_samples[node.sample];
+
+    const float distance = squaredLength(position - point);
+    if (distance < bestDistance) {
+        bestDistance = distance;
+        best = node.sample;
+    }
+
+    const float delta = node.axis == 0 ? position.x - point.x : position.y - point.y;
+    if (delta < 0.0f) {
+        nearest(begin, middle, position, best, bestDistance);
+        if (delta * delta < bestDistance) {
+            nearest(middle + 1, end, position, best, bestDistance);
+        }
+    }
+    else {
+        nearest(middle + 1, end, position, best, bestDistance);
+        if (delta * delta < bestDistance) {
+            nearest(begin, middle, position, best, bestDistance);
+        }
+    }
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include "Prerequisites.h"
+
+/*
+  Clase RacingLine
+  - Lnea de carrera suave y cerrada que pasa por los waypoints: una spline Catmull-Rom centrpeta
+    (no forma bucles ni picos aunque los puntos estn a distancias muy distintas).
+  - Al construirla se mide su longitud y se guarda una tabla de puntos separados por la misma
+    distancia a lo largo de la curva (parametrizacin por longitud de arco). Con ella:
+      - sample(distancia) es O(1): un ndice y una interpolacin entre dos puntos de la tabla.
+      - project(posicin) es O(log n): el punto ms cercano de la tabla se busca en un rbol k-d y se
+        refina proyectando sobre los dos tramos vecinos.
+  - El progreso (distancia recorrida en la vuelta) sirve para ordenar a los karts en la carrera sin
+    buscar en cada frame contra todos los waypoints.
+  En motores 3D, las curvas se reparametrizan por longitud de arco para mover cmaras y objetos a
+  velocidad constante; el parmetro natural de la spline avanza ms rpido en los tramos largos.
+*/
+class RacingLine
+{
+public:
+    /*
+      Funcin build.
+      - Construye la lnea cerrada que pasa por points (al menos 3), con una muestra de la tabla
+        cada spacing unidades del mundo.
+    */
+    bool build(const std::vector<sf::Vector2f>& points, float spacing = 2.0f);
+
+    // Indica si la lnea est construida.
+    bool isValid() const;
+
+    // Longitud de una vuelta.
+    float getLength() const;
+
+    /*
+      Funcin sample.
+      - Posicin a distance unidades del inicio (el primer waypoint). Cualquier distancia es vlida:
+        se ajusta a la vuelta, as que las distancias negativas o mayores que la longitud dan vueltas.
+    */
+    sf::Vector2f sample(float distance) const;
+
+    // Direccin (normalizada) de la lnea a distance unidades del inicio.
+    sf::Vector2f tangent(float distance) const;
+
+    /*
+      Funcin project.
+      - Distancia a lo largo de la lnea del punto de la curva ms cercano a position, en [0, longitud).
+      - Si se pasa squaredOffset, recibe la distancia al cuadrado de position a la lnea.
+    */
+    float project(const sf::Vector2f& position, float* squaredOffset = nullptr) const;
+
+    /*
+      Funcin resample.
+      - Puntos de la lnea cada spacing unidades, por ejemplo para usarlos como waypoints densos
+        en WaypointFollower y que los karts sigan la curva.
+    */
+    std::vector<sf::Vector2f> resample(float spacing) const;
+
+    // Puntos de la tabla (para dibujar la lnea).
+    const std::vector<sf::Vector2f>& getSamples() const;
+
+private:
+    // Nodo del rbol k-d: ndice de muestra y eje de corte (0 = x, 1 = y).
+    struct KdNode
+    {
+        uint32_t sample = 0;
+        uint32_t axis = 0;
+    };
+
+    // Posicin en la spline, con t en [0, nmero de waypoints).
+    sf::Vector2f evaluate(float t) const;
+
+    /*
+      rbol k-d sobre el rango [begin, end) de m_tree: el nodo del rango est en su mitad, la mitad
+      izquierda tiene las muestras menores en el eje del nodo y la derecha las mayores.
+    */
+    void buildTree(size_t begin, size_t end, uint32_t depth);
+    void nearest(size_t begin, size_t end, const sf::Vector2f& position, uint32_t& best, float& bestDistance) const;
+
+    std::vector<sf::Vector2f> m_points;    // Waypoints de control.
+    std::vector<sf::Vector2f> m_samples;   // Tabla por longitud de arco: m_samples[i] est a i * m_spacing.
+    float m_spacing = 2.0f;
+    float m_length = 0.0f;
+
+    std::vector<KdNode> m_tree;            // rbol k-d implcito (ver buildTree).
+};
@@ -0,0 +1,437 @@
+#include "RenderCommandBuffer.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+    /*
+       Formato .sframe:
+       [FrameHeader][tamaos de textura][transformaciones][modos de mezcla][vrtices][comandos]
+    */
+    constexpr char FRAME_MAGIC[4] = { 'S', 'F', 'R', 'M' };
+    constexpr uint32_t FRAME_VERSION = 1;
+
+    // Los 32 bits bajos de la clave de orden son el orden dentro de la capa.
+    constexpr uint64_t SORT_ORDER_MASK = 0xFFFFFFFFull;
+
+    struct FrameHeader
+    {
+        char magic[4];
+        uint32_t version;
+        uint32_t viewportWidth;
+        uint32_t viewportHeight;
+        uint32_t textureCount;
+        uint32_t transformCount;
+        uint32_t blendCount;
+        uint32_t vertexCount;
+        uint32_t commandCount;
+        uint32_t reserved;
+    };
+
+    struct FrameCommand
+    {
+        uint64_t sortKey;
+        uint32_t firstVertex;
+        uint32_t vertexCount;
+        uint32_t transformIndex;
+        uint16_t textureIndex;
+        uint8_t blendIndex;
+        uint8_t primitive;
+    };
+
+    static_assert(sizeof(FrameHeader) == 40, "FrameHeader debe ocupar 40 bytes");
+    static_assert(sizeof(FrameCommand) == 24, "FrameCommand debe ocupar 24 bytes");
+    static_assert(sizeof(sf::Vertex) == 20, "sf::Vertex debe ser posicion, color y coordenada de textura");
+
+    template<typename T>
+    void writeArray(std::ofstream& out, const std::vector<T>& values) {
+        out.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+    }
+
+    template<typename T>
+    bool readArray(std::ifstream& in, std::vector<T>& values, size_t count) {
+        values.resize(count);
+        in.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+        return static_cast<bool>(in);
+    }
+}
+
+// Cada tabla empieza con su valor por defecto en el ndice 0.
+RenderCommandBuffer::RenderCommandBuffer() {
+    clear();
+}
+
+/*
+   Copia los vrtices y guarda ndices a los estados.
+*/
+void RenderCommandBuffer::record(const sf::Vertex* vertices, size_t vertexCount, sf::PrimitiveType type,
+    const sf::RenderStates& states, uint16_t layer, uint32_t order) {
+    if (vertices == nullptr || vertexCount == 0) {
+        return;
+    }
+
+    RenderCommand command;
+    command.sortKey = makeSortKey(layer, order);
+    command.firstVertex = static_cast<uint32_t>(m_vertices.size());
+    command.vertexCount = static_cast<uint32_t>(vertexCount);
+    command.transformIndex = addTransform(states.transform);
+    command.textureIndex = addTexture(states.texture);
+    command.blendIndex = addBlendMode(states.blendMode);
+    command.primitive = static_cast<uint8_t>(type);
+    command.pass = m_pass;
+
+    m_vertices.insert(m_vertices.end(), vertices, vertices + vertexCount);
+    m_commands.push_back(command);
+}
+
+// Graba un drawable por referencia.
+void RenderCommandBuffer::record(const sf::Drawable& drawable, const sf::RenderStates& states, uint16_t layer,
+    const sf::VertexArray* cpuVertices, uint32_t order) {
+    RenderCommand command;
+    command.sortKey = makeSortKey(layer, order);
+    command.drawable = &drawable;
+    command.cpuVertices = cpuVertices;
+    command.transformIndex = addTransform(states.transform);
+    command.textureIndex = addTexture(states.texture);
+    command.blendIndex = addBlendMode(states.blendMode);
+    command.pass = m_pass;
+    m_commands.push_back(command);
+}
+
+/*
+   Une otro bfer. Las transformaciones se copian tal cual (pueden repetirse); las texturas y
+   los modos de mezcla se vuelven a buscar en las tablas de este bfer. Los rdenes de los
+   comandos unidos se desplazan por m_nextOrder para que, dentro de cada capa, queden detrs
+   de los ya grabados en lugar de intercalarse con ellos.
+*/
+void RenderCommandBuffer::append(const RenderCommandBuffer& other) {
+    const uint32_t vertexOffset = static_cast<uint32_t>(m_vertices.size());
+    const uint32_t transformOffset = static_cast<uint32_t>(m_transforms.size()) - 1;
+    const uint32_t orderOffset = m_nextOrder;
+
+    m_vertices.insert(m_vertices.end(), other.m_vertices.begin(), other.m_vertices.end());
+    m_transforms.insert(m_transforms.end(), other.m_transforms.begin() + 1, other.m_transforms.end());
+    m_ownedTextures.insert(m_ownedTextures.end(), other.m_ownedTextures.begin(), other.m_ownedTextures.end());
+
+    m_commands.reserve(m_commands.size() + other.m_commands.size());
+    for (RenderCommand command : other.m_commands) {
+        if (command.drawable == nullptr) {
+            command.firstVertex += vertexOffset;
+        }
+        if (command.transformIndex != 0) {
+            command.transformIndex += transformOffset;
+        }
+        command.textureIndex = addTexture(other.m_textures[command.textureIndex]);
+        command.blendIndex = addBlendMode(other.m_blendModes[command.blendIndex]);
+        const uint32_t order = static_cast<uint32_t>(command.sortKey & SORT_ORDER_MASK) + orderOffset;
+        command.sortKey = (command.sortKey & ~SORT_ORDER_MASK) | order;
+        m_commands.push_back(command);
+    }
+    m_nextOrder += other.m_nextOrder;
+}
+
+// Pase de los prximos comandos.
+void RenderCommandBuffer::setPass(uint8_t pass) {
+    m_pass = pass;
+}
+
+/*
+   Orden estable por clave. Los comandos grabados sin orden explcito tienen claves nicas, as
+   que dentro de una capa se dibujan en el orden de grabacin (el de pintor, que importa cuando
+   se superponen); a igualdad de clave tambin se conserva el orden de grabacin.
+*/
+size_t RenderCommandBuffer::submit(sf::RenderTarget& target, RenderStats* stats) {
+    std::stable_sort(m_commands.begin(), m_commands.end(), [](const RenderCommand& a, const RenderCommand& b) {
+        return a.sortKey < b.sortKey;
+        });
+
+    for (const RenderCommand& command : m_commands) {
+        sf::RenderStates states;
+        states.transform = m_transforms[command.transformIndex];
+        states.texture = m_textures[command.textureIndex];
+        states.blendMode = m_blendModes[command.blendIndex];
+
+        if (command.drawable != nullptr) {
+            target.draw(*command.drawable, states);
+        }
+        else {
+            target.draw(&m_vertices[command.firstVertex], command.vertexCount,
+                static_cast<sf::PrimitiveType>(command.primitive), states);
+        }
+
+        if (stats == nullptr) {
+            continue;
+        }
+        if (command.drawable != nullptr) {
+            stats->countDrawable(command.pass, *command.drawable, command.cpuVertices, states);
+        }
+        else {
+            stats->countDraw(command.pass, command.vertexCount, states.texture, states.blendMode,
+                static_cast<sf::PrimitiveType>(command.primitive));
+        }
+    }
+    return m_commands.size();
+}
+
+// Vaca las listas y deja los valores por defecto de las tablas.
+void RenderCommandBuffer::clear() {
+    m_commands.clear();
+    m_vertices.clear();
+    m_transforms.assign(1, sf::Transform::Identity);
+    m_textures.assign(1, nullptr);
+    m_blendModes.assign(1, sf::BlendAlpha);
+    m_textureIndices.clear();
+    m_ownedTextures.clear();
+    m_nextOrder = 0;
+}
+
+size_t RenderCommandBuffer::getCommandCount() const {
+    return m_commands.size();
+}
+
+size_t RenderCommandBuffer::getVertexCount() const {
+    return m_vertices.size();
+}
+
+/*
+   Guarda el frame. Los drawables con copia en CPU se convierten en rangos de vrtices,
+   as el archivo no depende de objetos que solo existen en la GPU.
+*/
+bool RenderCommandBuffer::save(const std::string& path, const sf::Vector2u& viewportSize) const {
+    std::vector<sf::Vertex> vertices = m_vertices;
+    std::vector<FrameCommand> commands;
+    size_t skipped = 0;
+
+    for (const RenderCommand& command : m_commands) {
+        FrameCommand saved{ command.sortKey, command.firstVertex, command.vertexCount,
+            command.transformIndex, command.textureIndex, command.blendIndex, command.primitive };
+
+        if (command.drawable != nullptr) {
+            if (command.cpuVertices == nullptr || command.cpuVertices->getVertexCount() == 0) {
+                ++skipped;
+                continue;
+            }
+            saved.firstVertex = static_cast<uint32_t>(vertices.size());
+            saved.vertexCount = static_cast<uint32_t>(command.cpuVertices->getVertexCount());
+            saved.primitive = static_cast<uint8_t>(command.cpuVertices->getPrimitiveType());
+            vertices.insert(vertices.end(), &(*command.cpuVertices)[0], &(*command.cpuVertices)[0] + saved.vertexCount);
+        }
+        commands.push_back(saved);
+    }
+
+    // Solo se guarda el tamao de cada textura.
+    std::vector<sf::Vector2u> textureSizes;
+    for (const sf::Texture* texture : m_textures) {
+        textureSizes.push_back(texture != nullptr ? texture->getSize() : sf::Vector2u());
+    }
+
+    // sf::Transform solo expone su matriz 4x4; se guardan los 9 valores de la matriz 3x3.
+    std::vector<float> transforms;
+    for (const sf::Transform& transform : m_transforms) {
+        const float* m = transform.getMatrix();
+        const float values[9] = { m[0], m[4], m[12], m[1], m[5], m[13], m[3], m[7], m[15] };
+        transforms.insert(transforms.end(), values, values + 9);
+    }
+
+    std::vector<uint8_t> blends;
+    for (const sf::BlendMode& blend : m_blendModes) {
+        const uint8_t values[6] = {
+            static_cast<uint8_t>(blend.colorSrcFactor), static_cast<uint8_t>(blend.colorDstFactor),
+            static_cast<uint8_t>(blend.colorEquation), static_cast<uint8_t>(blend.alphaSrcFactor),
+            static_cast<uint8_t>(blend.alphaDstFactor), static_cast<uint8_t>(blend.alphaEquation) };
+        blends.insert(blends.end(), values, values + 6);
+    }
+
+    FrameHeader header{};
+    std::memcpy(header.magic, FRAME_MAGIC, sizeof(FRAME_MAGIC));
+    header.version = FRAME_VERSION;
+    header.viewportWidth = viewportSize.x;
+    header.viewportHeight = viewportSize.y;
+    header.textureCount = static_cast<uint32_t>(textureSizes.size());
+    header.transformCount = static_cast<uint32_t>(m_transforms.size());
+    header.blendCount = static_cast<uint32_t>(m_blendModes.size());
+    header.vertexCount = static_cast<uint32_t>(vertices.size());
+    header.commandCount = static_cast<uint32_t>(commands.size());
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    writeArray(out, textureSizes);
+    writeArray(out, transforms);
+    writeArray(out, blends);
+    writeArray(out, vertices);
+    writeArray(out, commands);
+    if (!out) {
+        LOG_ERROR("RenderCommandBuffer", "save", "error al escribir [{}]", path);
+        return false;
+    }
+
+    LOG_INFO("RenderCommandBuffer", "save", "{} comandos, {} vertices en [{}]", commands.size(), vertices.size(), path);
+    if (skipped != 0) {
+        LOG_WARN("RenderCommandBuffer", "save", "{} drawables sin copia en CPU omitidos", skipped);
+    }
+    return true;
+}
+
+/*
+   Carga un frame y valida todos los ndices antes de aceptarlo. Los contadores de la cabecera
+   se comparan con el tamao del archivo antes de reservar memoria, para que un archivo daado
+   no pida gigabytes.
+*/
+bool RenderCommandBuffer::load(const std::string& path, sf::Vector2u& viewportSize) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    const std::streamoff fileSize = in ? static_cast<std::streamoff>(in.tellg()) : 0;
+    in.seekg(0);
+    FrameHeader header{};
+    in.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!in || std::memcmp(header.magic, FRAME_MAGIC, sizeof(FRAME_MAGIC)) != 0 || header.version != FRAME_VERSION
+        || header.textureCount == 0 || header.textureCount > UINT16_MAX || header.transformCount == 0
+        || header.blendCount == 0 || header.blendCount > UINT8_MAX + 1u) {
+        LOG_ERROR("RenderCommandBuffer", "load", "archivo no valido [{}]", path);
+        return false;
+    }
+
+    // Cada trmino es un uint32_t por un tamao pequeo: la suma en 64 bits no se desborda.
+    const uint64_t payload = static_cast<uint64_t>(header.textureCount) * sizeof(sf::Vector2u)
+        + static_cast<uint64_t>(header.transformCount) * 9 * sizeof(float)
+        + static_cast<uint64_t>(header.blendCount) * 6
+        + static_cast<uint64_t>(header.vertexCount) * sizeof(sf::Vertex)
+        + static_cast<uint64_t>(header.commandCount) * sizeof(FrameCommand);
+    if (fileSize < static_cast<std::streamoff>(sizeof(header))
+        || payload > static_cast<uint64_t>(fileSize) - sizeof(header)) {
+        LOG_ERROR("RenderCommandBuffer", "load", "contadores mayores que el archivo [{}]", path);
+        return false;
+    }
+
+    std::vector<sf::Vector2u> textureSizes;
+    std::vector<float> transforms;
+    std::vector<uint8_t> blends;
+    std::vector<sf::Vertex> vertices;
+    std::vector<FrameCommand> commands;
+    if (!readArray(in, textureSizes, header.textureCount)
+        || !readArray(in, transforms, static_cast<size_t>(header.transformCount) * 9)
+        || !readArray(in, blends, static_cast<size_t>(header.blendCount) * 6) || !readArray(in, vertices, header.vertexCount)
+        || !readArray(in, commands, header.commandCount)) {
+        LOG_ERROR("RenderCommandBuffer", "load", "archivo incompleto [{}]", path);
+        return false;
+    }
+
+    for (const FrameCommand& command : commands) {
+        if (command.textureIndex >= header.textureCount || command.transformIndex >= header.transformCount
+            || command.blendIndex >= header.blendCount || command.primitive > sf::TriangleFan
+            || static_cast<uint64_t>(command.firstVertex) + command.vertexCount > header.vertexCount) {
+            LOG_ERROR("RenderCommandBuffer", "load", "comando no valido en [{}]", path);
+            return false;
+        }
+    }
+
+    // Los modos de mezcla se guardan como bytes: fuera del rango del enum seran valores que
+    // OpenGL no conoce al reproducir.
+    for (uint32_t i = 0; i < header.blendCount; ++i) {
+        const uint8_t* b = &blends[i * 6];
+        if (b[0] > sf::BlendMode::OneMinusDstAlpha || b[1] > sf::BlendMode::OneMinusDstAlpha
+            || b[2] > sf::BlendMode::Max || b[3] > sf::BlendMode::OneMinusDstAlpha
+            || b[4] > sf::BlendMode::OneMinusDstAlpha || b[5] > sf::BlendMode::Max) {
+            LOG_ERROR("RenderCommandBuffer", "load", "modo de mezcla no valido en [{}]", path);
+            return false;
+        }
+    }
+
+    // La textura 0 es "sin textura"; las dems se crean con el tamao guardado.
+    const unsigned int maxTextureSize = sf::Texture::getMaximumSize();
+    for (uint32_t i = 1; i < header.textureCount; ++i) {
+        if (textureSizes[i].x > maxTextureSize || textureSizes[i].y > maxTextureSize) {
+            LOG_ERROR("RenderCommandBuffer", "load", "textura de {}x{} mayor que el maximo ({}) en [{}]",
+                textureSizes[i].x, textureSizes[i].y, maxTextureSize, path);
+            return false;
+        }
+    }
+
+    clear();
+    for (uint32_t i = 1; i < header.textureCount; ++i) {
+        EngineUtilities::TSharedPointer<sf::Texture> texture = EngineUtilities::MakeShared<sf::Texture>();
+        texture->create(std::max(1u, textureSizes[i].x), std::max(1u, textureSizes[i].y));
+        m_ownedTextures.push_back(texture);
+        m_textures.push_back(texture.get());
+    }
+
+    m_transforms.clear();
+    for (uint32_t i = 0; i < header.transformCount; ++i) {
+        const float* t = &transforms[static_cast<size_t>(i) * 9];
+        m_transforms.emplace_back(t[0], t[1], t[2], t[3], t[4], t[5], t[6], t[7], t[8]);
+    }
+
+    m_blendModes.clear();
+    for (uint32_t i = 0; i < header.blendCount; ++i) {
+        const uint8_t* b = &blends[i * 6];
+        m_blendModes.emplace_back(static_cast<sf::BlendMode::Factor>(b[0]), static_cast<sf::BlendMode::Factor>(b[1]),
+            static_cast<sf::BlendMode::Equation>(b[2]), static_cast<sf::BlendMode::Factor>(b[3]),
+            static_cast<sf::BlendMode::Factor>(b[4]), static_cast<sf::BlendMode::Equation>(b[5]));
+    }
+
+    m_vertices = std::move(vertices);
+    for (const FrameCommand& saved : commands) {
+        RenderCommand command;
+        command.sortKey = saved.sortKey;
+        command.firstVertex = saved.firstVertex;
+        command.vertexCount = saved.vertexCount;
+        command.transformIndex = saved.transformIndex;
+        command.textureIndex = saved.textureIndex;
+        command.blendIndex = saved.blendIndex;
+        command.primitive = saved.primitive;
+        m_commands.push_back(command);
+    }
+
+    viewportSize = sf::Vector2u(header.viewportWidth, header.viewportHeight);
+    return true;
+}
+
+// Las transformaciones identidad comparten el ndice 0.
+uint32_t RenderCommandBuffer::addTransform(const sf::Transform& transform) {
+    if (std::memcmp(transform.getMatrix(), sf::Transform::Identity.getMatrix(), 16 * sizeof(float)) == 0) {
+        return 0;
+    }
+    m_transforms.push_back(transform);
+    return static_cast<uint32_t>(m_transforms.size() - 1);
+}
+
+// Cada textura distinta recibe un ndice la primera vez que aparece.
+uint16_t RenderCommandBuffer::addTexture(const sf::Texture* texture) {
+    if (texture == nullptr) {
+        return 0;
+    }
+    auto it = m_textureIndices.find(texture);
+    if (it != m_textureIndices.end()) {
+        return it->second;
+    }
+    if (m_textures.size() > UINT16_MAX) {
+        LOG_ERROR("RenderCommandBuffer", "addTexture", "demasiadas texturas en un frame");
+        return 0;
+    }
+    const uint16_t index = static_cast<uint16_t>(m_textures.size());
+    m_textures.push_back(texture);
+    m_textureIndices.emplace(texture, index);
+    return index;
+}
+
+// Hay muy pocos modos de mezcla por frame: una bsqueda lineal basta.
+uint8_t RenderCommandBuffer::addBlendMode(const sf::BlendMode& blendMode) {
+    for (size_t i = 0; i < m_blendModes.size(); ++i) {
+        if (m_blendModes[i] == blendMode) {
+            return static_cast<uint8_t>(i);
+        }
+    }
+    if (m_blendModes.size() > UINT8_MAX) {
+        return 0;
+    }
+    m_blendModes.push_back(blendMode);
+    return static_cast<uint8_t>(m_blendModes.size() - 1);
+}
+
+// Capa en los 16 bits altos y orden en los 32 bajos.
+uint64_t RenderCommandBuffer::makeSortKey(uint16_t layer, uint32_t order) {
+    if (order == UINT32_MAX) {
+        order = m_nextOrder++;
+    }
+    return (static_cast<uint64_t>(layer) << 48) | order;
+}
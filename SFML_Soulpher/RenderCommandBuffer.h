@@ -0,0 +1,132 @@
+#pragma once
+#include "Prerequisites.h"
+#include "RenderStats.h"
+#include <cstdint>
+#include <unordered_map>
+
+/*
+  Enumeracin RenderLayer
+  - Capa de un comando de dibujo. Es la parte ms significativa de la clave de orden:
+    todo lo esttico se dibuja antes que el mundo, y el mundo antes que las superposiciones.
+*/
+enum RenderLayer
+{
+    LAYER_STATIC = 0,   // Geometra horneada (pista).
+    LAYER_WORLD = 1,    // Actores dinmicos.
+    LAYER_OVERLAY = 2,  // Elementos de depuracin sobre el mundo.
+};
+
+/*
+  Estructura RenderCommand
+  - Un comando de dibujo compacto. Los RenderStates no se copian: se guardan ndices a tablas
+    de transformaciones, texturas y modos de mezcla del bfer, que se repiten mucho entre comandos.
+  - Un comando dibuja un rango de vrtices copiados en el bfer, o un sf::Drawable por referencia
+    (por ejemplo, un sf::VertexBuffer), que debe seguir vivo hasta que se enve el bfer.
+*/
+struct RenderCommand
+{
+    uint64_t sortKey = 0;                         // Capa (16 bits altos) y orden dentro de la capa.
+    const sf::Drawable* drawable = nullptr;       // nullptr: el comando usa el rango de vrtices.
+    const sf::VertexArray* cpuVertices = nullptr; // Copia en CPU del drawable, solo para guardar el frame.
+    uint32_t firstVertex = 0;
+    uint32_t vertexCount = 0;
+    uint32_t transformIndex = 0;                  // 0 = identidad.
+    uint16_t textureIndex = 0;                    // 0 = sin textura.
+    uint8_t blendIndex = 0;                       // 0 = sf::BlendAlpha.
+    uint8_t primitive = sf::Triangles;
+    uint8_t pass = 0;                             // Pase de render (RenderStats), solo para contar.
+};
+
+/*
+  Clase RenderCommandBuffer
+  - Graba los comandos de dibujo de un frame para enviarlos despus, en lugar de dibujar al momento.
+  - Varios hilos pueden grabar cada uno en su propio bfer y despus unirlos con append() en el hilo
+    que posee el contexto de OpenGL, que los ordena y los enva con submit().
+  - Un frame grabado se puede guardar en disco (save) y volver a cargar (load) para medir el envo de
+    comandos sin el juego: las texturas se sustituyen por texturas vacas del mismo tamao.
+  En motores 3D, los "command buffers" separan decidir qu se dibuja (en cualquier hilo) de enviarlo a
+  la GPU (en el hilo del contexto), y la clave de orden agrupa comandos por capa, material y profundidad.
+*/
+class RenderCommandBuffer
+{
+public:
+    RenderCommandBuffer();
+
+    /*
+      Funcin record.
+      - Graba un rango de vrtices; los vrtices se copian, as que el llamador puede reutilizar su bfer.
+      - order indica la posicin dentro de la capa; con UINT32_MAX se usa el orden de grabacin.
+    */
+    void record(const sf::Vertex* vertices, size_t vertexCount, sf::PrimitiveType type,
+        const sf::RenderStates& states, uint16_t layer, uint32_t order = UINT32_MAX);
+
+    /*
+      Sobrecarga de la funcin record.
+      - Graba un drawable por referencia. cpuVertices es opcional y solo se usa al guardar el frame
+        (un sf::VertexBuffer no se puede leer desde la GPU).
+    */
+    void record(const sf::Drawable& drawable, const sf::RenderStates& states, uint16_t layer,
+        const sf::VertexArray* cpuVertices = nullptr, uint32_t order = UINT32_MAX);
+
+    /*
+      Funcin append.
+      - Agrega al final los comandos de otro bfer, reasignando sus ndices de vrtices y tablas.
+        Sus rdenes se desplazan para quedar detrs de los comandos ya grabados en cada capa.
+    */
+    void append(const RenderCommandBuffer& other);
+
+    /*
+      Funcin setPass.
+      - Pase de render (id de RenderStats::getPassId) de los comandos que se graben a continuacin.
+        Se conserva al vaciar el bfer y al unirlo a otro con append().
+    */
+    void setPass(uint8_t pass);
+
+    /*
+      Funcin submit.
+      - Ordena los comandos por clave (de forma estable: a igualdad de clave se conserva el orden de
+        grabacin) y los dibuja en target. Debe llamarse en el hilo del contexto de OpenGL.
+      - Si stats no es nullptr, cuenta cada llamada en su pase.
+      - Devuelve el nmero de llamadas de dibujo.
+    */
+    size_t submit(sf::RenderTarget& target, RenderStats* stats = nullptr);
+
+    // Vaca el bfer conservando la memoria reservada.
+    void clear();
+
+    size_t getCommandCount() const;
+    size_t getVertexCount() const;
+
+    /*
+      Funcin save.
+      - Guarda el frame en un archivo binario (.sframe). Los drawables sin copia en CPU no se pueden
+        guardar y se omiten (se informa cuntos).
+      - viewportSize se guarda para poder reproducir el frame con el mismo tamao.
+    */
+    bool save(const std::string& path, const sf::Vector2u& viewportSize) const;
+
+    /*
+      Funcin load.
+      - Carga un frame guardado. Crea texturas vacas con el tamao de las originales.
+      - Devuelve el tamao del viewport con el que se grab en viewportSize.
+    */
+    bool load(const std::string& path, sf::Vector2u& viewportSize);
+
+private:
+    uint32_t addTransform(const sf::Transform& transform);
+    uint16_t addTexture(const sf::Texture* texture);
+    uint8_t addBlendMode(const sf::BlendMode& blendMode);
+    uint64_t makeSortKey(uint16_t layer, uint32_t order);
+
+    std::vector<RenderCommand> m_commands;
+    std::vector<sf::Vertex> m_vertices;              // Vrtices copiados de todos los comandos.
+    std::vector<sf::Transform> m_transforms;         // [0] = identidad.
+    std::vector<const sf::Texture*> m_textures;      // [0] = nullptr.
+    std::vector<sf::BlendMode> m_blendModes;         // [0] = sf::BlendAlpha.
+    std::unordered_map<const sf::Texture*, uint16_t> m_textureIndices;
+    uint32_t m_nextOrder = 0;                        // Orden de grabacin.
+    uint8_t m_pass = 0;                              // Pase de los prximos comandos.
+
+    // Texturas de sustitucin de un frame cargado desde disco.
+    std::vector<EngineUtilities::TSharedPointer<sf::Texture>> m_ownedTextures;
+};
@@ -0,0 +1,92 @@
+#include "RenderStats.h"
+
+// Suma los contadores de otro frame o pase.
+void RenderCounters::add(const RenderCounters& other) {
+    drawCalls += other.drawCalls;
+    vertices += other.vertices;
+    textureBinds += other.textureBinds;
+    stateChanges += other.stateChanges;
+}
+
+// Constructor. Registra el pase 0, que recibe las llamadas sin pase.
+RenderStats::RenderStats() {
+    m_passes.push_back({ "Default", {} });
+}
+
+// Busca el pase por nombre; hay pocos pases, as que una bsqueda lineal basta.
+uint8_t RenderStats::getPassId(const std::string& name) {
+    for (size_t i = 0; i < m_passes.size(); ++i) {
+        if (m_passes[i].name == name) {
+            return static_cast<uint8_t>(i);
+        }
+    }
+    if (m_passes.size() >= MAX_PASSES) {
+        LOG_WARN("RenderStats", "getPassId", "demasiados pases, [{}] se cuenta en Default", name);
+        return 0;
+    }
+    m_passes.push_back({ name, {} });
+    return static_cast<uint8_t>(m_passes.size() - 1);
+}
+
+// Nuevo frame: contadores en cero.
+void RenderStats::beginFrame() {
+    m_total = {};
+    for (RenderPassStats& pass : m_passes) {
+        pass.counters = {};
+    }
+    m_hasPrevious = false;
+}
+
+/*
+   La primera llamada del frame siempre cuenta como cambio de estado (y de textura, si tiene),
+   porque no se sabe qu dej configurado ImGui o el frame anterior.
+*/
+void RenderStats::countDraw(uint8_t pass, size_t vertexCount, const sf::Texture* texture,
+    const sf::BlendMode& blendMode, sf::PrimitiveType primitive) {
+    RenderCounters counters;
+    counters.drawCalls = 1;
+    counters.vertices = vertexCount;
+
+    const bool textureChanged = !m_hasPrevious || texture != m_texture;
+    if (textureChanged && texture != nullptr) {
+        counters.textureBinds = 1;
+    }
+    if (textureChanged || blendMode != m_blendMode || primitive != m_primitive) {
+        counters.stateChanges = 1;
+    }
+
+    m_hasPrevious = true;
+    m_texture = texture;
+    m_blendMode = blendMode;
+    m_primitive = primitive;
+
+    m_total.add(counters);
+    m_passes[pass < m_passes.size() ? pass : 0].counters.add(counters);
+}
+
+// Obtiene los vrtices y la primitiva del drawable cuando se pueden conocer.
+void RenderStats::countDrawable(uint8_t pass, const sf::Drawable& drawable, const sf::VertexArray* cpuVertices,
+    const sf::RenderStates& states) {
+    if (cpuVertices == nullptr) {
+        cpuVertices = dynamic_cast<const sf::VertexArray*>(&drawable);
+    }
+    if (cpuVertices != nullptr) {
+        countDraw(pass, cpuVertices->getVertexCount(), states.texture, states.blendMode, cpuVertices->getPrimitiveType());
+    }
+    else if (const auto* buffer = dynamic_cast<const sf::VertexBuffer*>(&drawable)) {
+        countDraw(pass, buffer->getVertexCount(), states.texture, states.blendMode, buffer->getPrimitiveType());
+    }
+    else {
+        countDraw(pass, 0, states.texture, states.blendMode, sf::Triangles);
+    }
+}
+
+// Contadores del frame.
+const RenderCounters& RenderStats::getTotal() const {
+    return m_total;
+}
+
+// Pases y sus contadores.
+const std::vector<RenderPassStats>& RenderStats::getPasses() const {
+    return m_passes;
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include "Prerequisites.h"
+#include <cstdint>
+
+/*
+  Estructura RenderCounters
+  - Contadores de dibujo de un frame o de un pase.
+  - textureBinds: veces que se cambia a otra textura (sin contar quitar la textura).
+  - stateChanges: llamadas cuyo estado (textura, modo de mezcla o tipo de primitiva) es distinto
+    al de la llamada anterior; cada una obliga al driver a reconfigurar el pipeline.
+*/
+struct RenderCounters
+{
+    size_t drawCalls = 0;
+    size_t vertices = 0;
+    size_t textureBinds = 0;
+    size_t stateChanges = 0;
+
+    void add(const RenderCounters& other);
+};
+
+/*
+  Estructura RenderPassStats
+  - Contadores de un pase de render con nombre ("Track", "Actors", "Swarm", ...).
+*/
+struct RenderPassStats
+{
+    std::string name;
+    RenderCounters counters;
+};
+
+/*
+  Clase RenderStats
+  - Cuenta las llamadas de dibujo de un frame, en total y por pase de render.
+  - Los pases se registran por nombre con getPassId() y se identifican con un ndice de 8 bits
+    que viaja en cada comando grabado; el pase 0 ("Default") recibe lo que no tiene pase.
+  - countDraw() recuerda el estado de la llamada anterior para contar cambios de textura y de estado.
+  En motores 3D, estos contadores son la primera pista para saber si un frame est limitado por
+  el nmero de llamadas (CPU/driver) o por la cantidad de geometra (GPU).
+*/
+class RenderStats
+{
+public:
+    static constexpr size_t MAX_PASSES = 256;
+
+    RenderStats();
+
+    /*
+      Funcin getPassId.
+      - Devuelve el ndice del pase con ese nombre, registrndolo si no existe.
+      - Si ya hay MAX_PASSES pases, devuelve 0.
+    */
+    uint8_t getPassId(const std::string& name);
+
+    /*
+      Funcin beginFrame.
+      - Pone los contadores en cero (los pases registrados se conservan) y olvida el estado anterior.
+    */
+    void beginFrame();
+
+    /*
+      Funcin countDraw.
+      - Cuenta una llamada de dibujo del pase indicado.
+    */
+    void countDraw(uint8_t pass, size_t vertexCount, const sf::Texture* texture,
+        const sf::BlendMode& blendMode, sf::PrimitiveType primitive);
+
+    /*
+      Funcin countDrawable.
+      - Cuenta el dibujo de un sf::Drawable. Los vrtices se toman de cpuVertices o, si el drawable
+        es un sf::VertexArray o un sf::VertexBuffer, de l mismo; otros drawables cuentan 0 vrtices.
+    */
+    void countDrawable(uint8_t pass, const sf::Drawable& drawable, const sf::VertexArray* cpuVertices,
+        const sf::RenderStates& states);
+
+    // Contadores de todo el frame.
+    const RenderCounters& getTotal() const;
+
+    // Pases registrados con sus contadores (el ndice es el id del pase).
+    const std::vector<RenderPassStats>& getPasses() const;
+
+private:
+    RenderCounters m_total;
+    std::vector<RenderPassStats> m_passes;
+
+    // Estado de la llamada anterior.
+    bool m_hasPrevious = false;
+    const sf::Texture* m_texture = nullptr;
+    sf::BlendMode m_blendMode;
+    sf::PrimitiveType m_primitive = sf::Triangles;
+};
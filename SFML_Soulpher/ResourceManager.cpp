@@ -0,0 +1,539 @@
+#include "ResourceManager.h"
+#include "Profiler.h"
+#include <filesystem>
+#include <cstdlib>
+
+/*
+   Constructor.
+   Registra las races de bsqueda por defecto. Se prueban varias profundidades porque el
+   ejecutable puede lanzarse desde la carpeta del proyecto, desde la solucin o desde bin/.
+   La variable de entorno SOULPHER_ASSET_ROOT permite agregar races sin recompilar.
+*/
+ResourceManager::ResourceManager() {
+    if (const char* envRoots = std::getenv("SOULPHER_ASSET_ROOT")) {
+        std::stringstream stream(envRoots);
+        std::string root;
+        while (std::getline(stream, root, ';')) {
+            addSearchRoot(root);
+        }
+    }
+
+    addSearchRoot("bin/MarioKart sprite-png");
+    addSearchRoot("../bin/MarioKart sprite-png");
+    addSearchRoot("../../bin/MarioKart sprite-png");
+    addSearchRoot("MarioKart sprite-png");
+    addSearchRoot(".");
+
+    // Placeholder de 8x8 en damero magenta/negro: fcil de reconocer si una textura nunca termina de cargar.
+    m_placeholder.create(8, 8, sf::Color::Black);
+    for (unsigned int y = 0; y < 8; ++y) {
+        for (unsigned int x = 0; x < 8; ++x) {
+            if (((x / 2) + (y / 2)) % 2 == 0) {
+                m_placeholder.setPixel(x, y, sf::Color::Magenta);
+            }
+        }
+    }
+}
+
+/*
+   Agrega una raz de bsqueda, ignorando las vacas y las repetidas.
+*/
+void ResourceManager::addSearchRoot(const std::string& root) {
+    if (root.empty()) {
+        return;
+    }
+    for (const auto& existing : m_searchRoots) {
+        if (existing == root) {
+            return;
+        }
+    }
+    m_searchRoots.push_back(root);
+}
+
+// Elimina todas las races de bsqueda.
+void ResourceManager::clearSearchRoots() {
+    m_searchRoots.clear();
+}
+
+// Devuelve las races de bsqueda registradas.
+const std::vector<std::string>& ResourceManager::getSearchRoots() const {
+    return m_searchRoots;
+}
+
+/*
+   Resuelve una ruta contra las races de bsqueda.
+   El resultado es absoluto y normalizado para que el hash de la ruta sea el mismo
+   sin importar desde qu raz se pidi el archivo.
+*/
+std::string ResourceManager::resolvePath(const std::string& path) const {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+
+    const fs::path requested(path);
+    if (requested.is_absolute()) {
+        if (fs::is_regular_file(requested, ec)) {
+            return requested.lexically_normal().generic_string();
+        }
+        return std::string();
+    }
+
+    for (const auto& root : m_searchRoots) {
+        const fs::path candidate = fs::path(root) / requested;
+        if (fs::is_regular_file(candidate, ec)) {
+            return fs::absolute(candidate, ec).lexically_normal().generic_string();
+        }
+    }
+    return std::string();
+}
+
+/*
+   Monta un archivo empaquetado.
+*/
+bool ResourceManager::mountArchive(const std::string& path) {
+    const std::string resolved = resolvePath(path);
+    if (resolved.empty()) {
+        return false;
+    }
+
+    for (const auto& archive : m_archives) {
+        if (archive->getPath() == resolved) {
+            return true;
+        }
+    }
+
+    EngineUtilities::TSharedPointer<AssetArchive> archive = EngineUtilities::MakeShared<AssetArchive>();
+    if (!archive->open(resolved)) {
+        LOG_ERROR("ResourceManager", "mountArchive", "archivo invalido [{}]", resolved);
+        return false;
+    }
+    LOG_INFO("ResourceManager", "mountArchive", "{} ({} entries)", resolved, archive->getEntryCount());
+    m_archives.push_back(archive);
+    return true;
+}
+
+/*
+   Localiza un recurso. Los archivos montados ms recientemente tienen prioridad,
+   para que un .spak de parche pueda reemplazar recursos de uno anterior.
+*/
+AssetSource ResourceManager::locate(const std::string& path) const {
+    AssetSource source;
+
+    const std::string relative = std::filesystem::path(path).lexically_normal().generic_string();
+    for (auto it = m_archives.rbegin(); it != m_archives.rend(); ++it) {
+        const ArchiveEntry* entry = (*it)->find(relative);
+        if (entry == nullptr) {
+            continue;
+        }
+        source.path = (*it)->getPath() + ":" + relative;
+        source.archive = it->get();
+        source.entry = entry;
+        return source;
+    }
+
+    source.path = resolvePath(path);
+    return source;
+}
+
+/*
+   Lee los bytes de un blob. read() es const y solo toca la proyeccin, as que varios hilos
+   de carga pueden leer del mismo archivo a la vez.
+*/
+bool ResourceManager::fetch(AssetSource& source) {
+    if (source.entry == nullptr || source.mapped != nullptr || !source.storage.empty()) {
+        return true;
+    }
+    AssetArchive::Blob blob = source.archive->read(*source.entry);
+    if (!blob) {
+        return false;
+    }
+    source.size = blob.size;
+    if (blob.storage.empty()) {
+        source.mapped = blob.data;
+    }
+    else {
+        source.storage = std::move(blob.storage);
+    }
+    return true;
+}
+
+/*
+   Obtiene una textura. El tamao residente se estima como RGBA de 8 bits por canal,
+   que es el formato en el que SFML sube las texturas a la GPU.
+*/
+TextureHandle ResourceManager::getTexture(const std::string& path) {
+    TextureHandle handle = acquire(m_textures, path,
+        [](sf::Texture& texture, const AssetSource& source) {
+            if (CookedImage::isCookedPath(source.path)) {
+                sf::Image image;
+                return decodeImage(image, source) && texture.loadFromImage(image);
+            }
+            return source.isPacked() ? texture.loadFromMemory(source.data(), source.size)
+                : texture.loadFromFile(source.path);
+        },
+        [](const sf::Texture& texture, const AssetSource&) {
+            const sf::Vector2u size = texture.getSize();
+            return static_cast<size_t>(size.x) * size.y * 4;
+        });
+
+    if (m_hotReload && handle.isValid() && !m_textures[handle.id].packed) {
+        m_watcher.watchFile(m_textures[handle.id].path);
+    }
+    return handle;
+}
+
+/*
+   Obtiene una fuente. sf::Font mantiene el archivo abierto y carga los glifos bajo demanda,
+   por lo que se usa el tamao del archivo como estimacin. Desde un .spak, la fuente lee
+   directamente de la proyeccin (el empaquetador nunca comprime fuentes).
+*/
+FontHandle ResourceManager::getFont(const std::string& path) {
+    return acquire(m_fonts, path,
+        [](sf::Font& font, const AssetSource& source) {
+            if (source.isPacked()) {
+                return source.mapped != nullptr && font.loadFromMemory(source.mapped, source.size);
+            }
+            return font.loadFromFile(source.path);
+        },
+        [](const sf::Font&, const AssetSource& source) {
+            if (source.isPacked()) {
+                return source.size;
+            }
+            std::error_code ec;
+            const auto size = std::filesystem::file_size(source.path, ec);
+            return ec ? size_t(0) : static_cast<size_t>(size);
+        });
+}
+
+/*
+   Obtiene un buffer de sonido. Las muestras se guardan como enteros de 16 bits.
+*/
+SoundBufferHandle ResourceManager::getSoundBuffer(const std::string& path) {
+    return acquire(m_soundBuffers, path,
+        [](sf::SoundBuffer& buffer, const AssetSource& source) {
+            return source.isPacked() ? buffer.loadFromMemory(source.data(), source.size)
+                : buffer.loadFromFile(source.path);
+        },
+        [](const sf::SoundBuffer& buffer, const AssetSource&) {
+            return static_cast<size_t>(buffer.getSampleCount()) * sizeof(sf::Int16);
+        });
+}
+
+/*
+   Obtiene una textura de forma asncrona.
+   La ruta se resuelve en el hilo principal (solo comprueba que el archivo exista); la lectura,
+   la descompresin y la decodificacin se hacen en un hilo de trabajo que nunca toca OpenGL.
+*/
+TextureHandle ResourceManager::getTextureAsync(const std::string& path) {
+    const AssetSource source = locate(path);
+    if (source.path.empty()) {
+        ++m_stats.failures;
+        LOG_ERROR("ResourceManager", "getTextureAsync", "no se encontro el recurso [{}]", path);
+        return TextureHandle();
+    }
+
+    const uint64_t id = Hash::hashPath(source.path);
+
+    // Acierto: la textura ya est cargada o en camino.
+    auto it = m_textures.find(id);
+    if (it != m_textures.end()) {
+        ++m_stats.hits;
+        return TextureHandle{ id, it->second.resource, it->second.status };
+    }
+
+    ++m_stats.misses;
+
+    // La textura existe desde ahora con el placeholder; su contenido se reemplaza al subirla.
+    CacheEntry<sf::Texture> entry;
+    entry.resource = EngineUtilities::MakeShared<sf::Texture>();
+    entry.resource->loadFromImage(m_placeholder);
+    entry.status = EngineUtilities::MakeShared<LoadStatus>();
+    entry.path = source.path;
+    entry.packed = source.isPacked();
+    m_textures.emplace(id, entry);
+
+    if (m_hotReload && !entry.packed) {
+        m_watcher.watchFile(source.path);
+    }
+    submitDecode(id, source, false);
+
+    return TextureHandle{ id, entry.resource, entry.status };
+}
+
+/*
+   Decodifica una imagen. Una imagen cocinada se valida y se copia tal cual, sin descomprimir PNG.
+   El render todava no aplica el alfa premultiplicado ni el recorte, as que se avisa si llegan.
+*/
+bool ResourceManager::decodeImage(sf::Image& image, const AssetSource& source) {
+    if (CookedImage::isCookedPath(source.path)) {
+        CookedImage::Info info;
+        const bool ok = source.isPacked() ? CookedImage::load(source.data(), source.size, image, &info)
+            : CookedImage::loadFromFile(source.path, image, &info);
+        if (ok && (info.header.flags & (COOKED_PREMULTIPLIED | COOKED_TRIMMED)) != 0) {
+            LOG_WARN("ResourceManager", "decodeImage", "[{}] esta premultiplicada o recortada y el render no lo aplica (cocinar sin --premultiply ni --trim)",
+                source.path);
+        }
+        return ok;
+    }
+    return source.isPacked() ? image.loadFromMemory(source.data(), source.size)
+        : image.loadFromFile(source.path);
+}
+
+/*
+   Encola la decodificacin de una imagen.
+   El hilo de trabajo solo recibe datos propios (id, ruta o entrada del .spak), nunca TSharedPointer
+   de la cach, porque su recuento de referencias no es seguro entre hilos. El blob se lee y se
+   descomprime en el propio hilo, directamente de la proyeccin del .spak, que sigue montada
+   mientras exista el ResourceManager.
+*/
+void ResourceManager::submitDecode(uint64_t id, const AssetSource& source, bool reload) {
+    ++m_pendingLoads;
+    m_loaders.submit([this, id, source = source, reload]() mutable {
+        PROFILE_SCOPE("ResourceManager::decode");
+        DecodedImage decoded;
+        decoded.id = id;
+        decoded.reload = reload;
+        decoded.ok = fetch(source) && decodeImage(decoded.image, source);
+
+        std::lock_guard<std::mutex> lock(m_decodedMutex);
+        m_decoded.push_back(std::move(decoded));
+    });
+}
+
+/*
+   Activa o desactiva la recarga en caliente. Al activarla se vigilan tambin
+   las texturas que ya estaban en la cach.
+*/
+void ResourceManager::setHotReload(bool enabled) {
+    if (enabled == m_hotReload) {
+        return;
+    }
+    m_hotReload = enabled;
+    for (const auto& [id, entry] : m_textures) {
+        if (enabled) {
+            m_watcher.watchFile(entry.path);
+        }
+        else {
+            m_watcher.unwatchFile(entry.path);
+        }
+    }
+}
+
+// Indica si la recarga en caliente est activa.
+bool ResourceManager::isHotReloadEnabled() const {
+    return m_hotReload;
+}
+
+// Actualizacin por frame: cambios en disco y subidas pendientes.
+void ResourceManager::update(sf::Time budget) {
+    pollFileChanges();
+    processUploads(budget);
+}
+
+/*
+   Encola la recarga de las texturas cuyo archivo cambi.
+   Una textura que todava se est cargando (o recargando) se marca para recargarse
+   otra vez al terminar, para no perder el ltimo guardado.
+*/
+void ResourceManager::pollFileChanges() {
+    if (!m_hotReload) {
+        return;
+    }
+
+    for (const std::string& path : m_watcher.poll()) {
+        const uint64_t id = Hash::hashPath(path);
+        auto it = m_textures.find(id);
+        if (it == m_textures.end()) {
+            continue;
+        }
+
+        const bool loading = !it->second.status.isNull() && it->second.status->state == LoadState::Loading;
+        if (loading || m_reloading.count(id) != 0) {
+            m_reloadAgain.insert(id);
+            continue;
+        }
+
+        AssetSource source;
+        source.path = path;
+        m_reloading.insert(id);
+        submitDecode(id, source, true);
+    }
+}
+
+/*
+   Registra una funcin a ejecutar cuando la textura est lista.
+*/
+void ResourceManager::whenReady(const TextureHandle& handle, std::function<void(sf::Texture&)> callback) {
+    if (!handle.isValid() || !callback) {
+        return;
+    }
+    if (!handle.isLoading()) {
+        callback(*handle.resource);
+        return;
+    }
+    m_readyCallbacks[handle.id].push_back(std::move(callback));
+}
+
+/*
+   Sube a la GPU las imgenes decodificadas hasta agotar el presupuesto de tiempo del frame.
+   Un presupuesto de cero procesa toda la cola.
+*/
+size_t ResourceManager::processUploads(sf::Time budget) {
+    PROFILE_SCOPE("ResourceManager::processUploads");
+    sf::Clock clock;
+    size_t uploaded = 0;
+
+    while (true) {
+        DecodedImage decoded;
+        {
+            std::lock_guard<std::mutex> lock(m_decodedMutex);
+            if (m_decoded.empty()) {
+                break;
+            }
+            decoded = std::move(m_decoded.front());
+            m_decoded.pop_front();
+        }
+
+        --m_pendingLoads;
+
+        // La entrada pudo liberarse mientras la imagen se decodificaba.
+        auto it = m_textures.find(decoded.id);
+        if (it == m_textures.end()) {
+            m_readyCallbacks.erase(decoded.id);
+            continue;
+        }
+
+        CacheEntry<sf::Texture>& entry = it->second;
+        if (decoded.reload) {
+            m_reloading.erase(decoded.id);
+
+            // Si la imagen no se pudo leer (por ejemplo, el archivo an se estaba escribiendo),
+            // se conserva la textura anterior. Una recarga correcta tambin arregla una textura
+            // cuya primera carga fall: pasa a Ready.
+            if (decoded.ok && entry.resource->loadFromImage(decoded.image)) {
+                const sf::Vector2u size = entry.resource->getSize();
+                m_stats.residentBytes -= entry.bytes;
+                entry.bytes = static_cast<size_t>(size.x) * size.y * 4;
+                m_stats.residentBytes += entry.bytes;
+                if (!entry.status.isNull()) {
+                    entry.status->state = LoadState::Ready;
+                }
+                ++m_stats.reloads;
+                LOG_INFO("ResourceManager", "processUploads", "RELOADED {}", entry.path);
+            }
+            else {
+                LOG_ERROR("ResourceManager", "processUploads", "error al recargar [{}]", entry.path);
+            }
+        }
+        else if (decoded.ok && entry.resource->loadFromImage(decoded.image)) {
+            const sf::Vector2u size = entry.resource->getSize();
+            entry.bytes = static_cast<size_t>(size.x) * size.y * 4;
+            m_stats.residentBytes += entry.bytes;
+            entry.status->state = LoadState::Ready;
+            ++m_stats.uploads;
+        }
+        else if (!entry.status.isNull()) {
+            entry.status->state = LoadState::Failed;
+            ++m_stats.failures;
+            LOG_ERROR("ResourceManager", "processUploads", "error al cargar [{}]", entry.path);
+        }
+
+        // Avisar a quienes esperaban esta textura.
+        auto callbacks = m_readyCallbacks.find(decoded.id);
+        if (callbacks != m_readyCallbacks.end()) {
+            auto pending = std::move(callbacks->second);
+            m_readyCallbacks.erase(callbacks);
+            for (auto& callback : pending) {
+                callback(*entry.resource);
+            }
+        }
+
+        // El archivo cambi otra vez mientras se cargaba: volver a leerlo.
+        if (m_reloadAgain.erase(decoded.id) != 0) {
+            AssetSource source;
+            source.path = entry.path;
+            m_reloading.insert(decoded.id);
+            submitDecode(decoded.id, source, true);
+        }
+
+        ++uploaded;
+        if (budget != sf::Time::Zero && clock.getElapsedTime() >= budget) {
+            break;
+        }
+    }
+    return uploaded;
+}
+
+/*
+   Espera a que terminen todas las cargas asncronas y las sube sin lmite de tiempo.
+*/
+void ResourceManager::finishPendingLoads() {
+    while (m_pendingLoads > 0) {
+        m_loaders.waitIdle();
+        processUploads(sf::Time::Zero);
+    }
+}
+
+/*
+   Libera los recursos que ya no utiliza nadie fuera de la cach.
+*/
+size_t ResourceManager::releaseUnused() {
+    return releaseUnused(m_textures) + releaseUnused(m_fonts) + releaseUnused(m_soundBuffers);
+}
+
+/*
+   Vaca la cach. Los handles que sigan vivos conservan su recurso gracias al recuento de referencias.
+*/
+void ResourceManager::clear() {
+    m_textures.clear();
+    m_fonts.clear();
+    m_soundBuffers.clear();
+    m_stats.residentBytes = 0;
+}
+
+// Devuelve una copia de las estadsticas, con el nmero de recursos actualizado.
+ResourceManager::Stats ResourceManager::getStats() const {
+    Stats stats = m_stats;
+    stats.textureCount = m_textures.size();
+    for (const auto& [id, entry] : m_textures) {
+        stats.textureBytes += entry.bytes;
+    }
+    stats.fontCount = m_fonts.size();
+    stats.soundBufferCount = m_soundBuffers.size();
+    stats.pendingLoads = m_pendingLoads;
+    stats.watchedFiles = m_watcher.getWatchedCount();
+    return stats;
+}
+
+/*
+   Ventana de ImGui con las estadsticas de la cach.
+*/
+void ResourceManager::drawStats() {
+    const Stats stats = getStats();
+    const unsigned int requests = stats.hits + stats.misses;
+    const float hitRate = requests > 0 ? 100.0f * stats.hits / requests : 0.0f;
+
+    ImGui::Begin("RESOURCES");
+    ImGui::Text("Hits: %u   Misses: %u   Failures: %u", stats.hits, stats.misses, stats.failures);
+    ImGui::Text("Hit rate: %.1f %%", hitRate);
+    ImGui::Text("Resident: %.2f MB", stats.residentBytes / (1024.0 * 1024.0));
+    ImGui::Text("Async: %zu pending, %u uploaded", stats.pendingLoads, stats.uploads);
+
+    bool hotReload = m_hotReload;
+    if (ImGui::Checkbox("Hot reload", &hotReload)) {
+        setHotReload(hotReload);
+    }
+    ImGui::SameLine();
+    ImGui::Text("%zu watched, %u reloads", stats.watchedFiles, stats.reloads);
+    for (const auto& archive : m_archives) {
+        ImGui::Text("Archive: %s (%zu entries, %.2f MB mapped)", archive->getPath().c_str(),
+            archive->getEntryCount(), archive->getMappedSize() / (1024.0 * 1024.0));
+    }
+    ImGui::Separator();
+    drawEntries("Textures", m_textures);
+    drawEntries("Fonts", m_fonts);
+    drawEntries("Sound buffers", m_soundBuffers);
+    if (ImGui::Button("Release unused")) {
+        releaseUnused();
+    }
+    ImGui::End();
+}
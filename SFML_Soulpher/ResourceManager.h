@@ -0,0 +1,444 @@
+#pragma once
+#include "Prerequisites.h"
+#include "Hash.h"
+#include "ThreadPool.h"
+#include "FileWatcher.h"
+#include "AssetArchive.h"
+#include "CookedImage.h"
+#include <SFML/Audio.hpp>
+#include <unordered_map>
+#include <unordered_set>
+
+/*
+  Enumeracin LoadState
+  - Estado de carga de un recurso.
+  - Los recursos cargados de forma sncrona estn siempre en Ready; los asncronos pasan de
+    Loading a Ready (o Failed) cuando el hilo principal sube la imagen decodificada a la GPU.
+*/
+enum class LoadState
+{
+    Loading = 0,  // Decodificndose en un hilo de trabajo o esperando su subida a la GPU.
+    Ready = 1,    // Recurso listo para usarse.
+    Failed = 2    // La lectura o decodificacin fall; el recurso conserva el placeholder.
+};
+
+/*
+  Estructura LoadStatus.
+  - Estado compartido entre la cach y todos los handles de un recurso asncrono.
+  - Solo se lee y modifica desde el hilo principal.
+*/
+struct LoadStatus
+{
+    LoadState state = LoadState::Loading;
+};
+
+/*
+  Estructura ResourceHandle.
+  - Referencia a un recurso administrado por ResourceManager.
+  - id es el hash de la ruta resuelta del archivo: dos handles con el mismo id apuntan al mismo recurso.
+  - El recurso se comparte mediante TSharedPointer, por lo que el recuento de referencias indica
+    cuntos usuarios siguen utilizndolo.
+*/
+template<typename T>
+struct ResourceHandle
+{
+    uint64_t id = 0;                              // Hash de la ruta del recurso.
+    EngineUtilities::TSharedPointer<T> resource;  // Recurso compartido.
+    EngineUtilities::TSharedPointer<LoadStatus> status;  // Estado de carga (nulo si se carg de forma sncrona).
+
+    // Indica si el handle apunta a un recurso (cargado o con placeholder).
+    bool isValid() const { return !resource.isNull(); }
+
+    /*
+      Funciones isReady, isLoading y hasFailed.
+      - Permiten usar el handle como un "future": el recurso existe desde el principio
+        (con un placeholder), pero su contenido real llega ms tarde.
+    */
+    bool isReady() const { return isValid() && (status.isNull() || status->state == LoadState::Ready); }
+    bool isLoading() const { return isValid() && !status.isNull() && status->state == LoadState::Loading; }
+    bool hasFailed() const { return !status.isNull() && status->state == LoadState::Failed; }
+
+    // Acceso directo al recurso.
+    T* get() const { return resource.get(); }
+    T* operator->() const { return resource.get(); }
+    T& operator*() const { return *resource; }
+};
+
+/*
+  Estructura AssetSource.
+  - Origen de un recurso: un archivo suelto en disco o un blob dentro de un archivo empaquetado.
+  - locate() solo resuelve la ruta y la entrada del .spak; los bytes del blob se leen despus con
+    ResourceManager::fetch, y nicamente si el recurso no estaba ya en la cach.
+  - Los blobs sin comprimir apuntan a la memoria proyectada del .spak (mapped); los comprimidos
+    se descomprimen en storage.
+*/
+struct AssetSource
+{
+    std::string path;                 // Ruta resuelta, o "<archivo.spak>:<ruta relativa>" para blobs.
+    const AssetArchive* archive = nullptr;  // Archivo montado que contiene el blob.
+    const ArchiveEntry* entry = nullptr;    // Entrada del blob dentro de archive.
+    const uint8_t* mapped = nullptr;  // Bytes dentro de la proyeccin (blob sin comprimir).
+    std::vector<uint8_t> storage;     // Bytes descomprimidos (blob con LZ4).
+    size_t size = 0;                  // Tamao del blob.
+
+    // Indica si el recurso viene de un .spak.
+    bool isPacked() const { return entry != nullptr; }
+
+    // Bytes del blob, estn proyectados o descomprimidos.
+    const uint8_t* data() const { return mapped != nullptr ? mapped : storage.data(); }
+};
+
+using TextureHandle = ResourceHandle<sf::Texture>;
+using FontHandle = ResourceHandle<sf::Font>;
+using SoundBufferHandle = ResourceHandle<sf::SoundBuffer>;
+
+/*
+  Clase ResourceManager
+  - Cach central de texturas, fuentes y buffers de sonido.
+  - Cada archivo se carga una sola vez: las peticiones siguientes a la misma ruta devuelven el
+    mismo recurso (un "hit" de cach) en lugar de volver a leerlo y decodificarlo.
+  - Las rutas relativas se resuelven contra una lista configurable de races de bsqueda, de modo
+    que el proyecto no depende de rutas absolutas de una mquina concreta.
+  En motores 3D, un administrador de recursos como este evita duplicar en memoria de GPU texturas,
+  mallas o shaders compartidos por muchos objetos de la escena.
+*/
+class ResourceManager
+{
+public:
+    /*
+      Estadsticas de la cach.
+      - hits / misses: peticiones resueltas desde la cach y peticiones que requirieron cargar el archivo.
+      - failures: cargas que fallaron (archivo inexistente o formato invlido).
+      - residentBytes: memoria aproximada ocupada por los recursos cargados.
+    */
+    struct Stats
+    {
+        unsigned int hits = 0;
+        unsigned int misses = 0;
+        unsigned int failures = 0;
+        size_t residentBytes = 0;
+        size_t textureBytes = 0;     // Parte de residentBytes que ocupan las texturas.
+        size_t textureCount = 0;
+        size_t fontCount = 0;
+        size_t soundBufferCount = 0;
+        size_t pendingLoads = 0;     // Texturas asncronas que an no se suben a la GPU.
+        unsigned int uploads = 0;    // Subidas asncronas completadas.
+        unsigned int reloads = 0;    // Texturas recargadas en caliente.
+        size_t watchedFiles = 0;     // Archivos vigilados para la recarga en caliente.
+    };
+
+    /*
+      Constructor por defecto.
+      - Registra las races de bsqueda por defecto y las indicadas en la variable de entorno
+        SOULPHER_ASSET_ROOT (varias rutas separadas por ';').
+    */
+    ResourceManager();
+
+    /*
+      Destructor por defecto.
+      - Los recursos se liberan con sus TSharedPointer. Los hilos de carga (m_loaders) se detienen
+        antes que el resto de miembros porque se declaran al final.
+    */
+    ~ResourceManager() = default;
+
+    /*
+      Funcin addSearchRoot.
+      - Agrega un directorio a la lista de races donde se buscan los recursos.
+      - Las races se consultan en el orden en que fueron agregadas.
+    */
+    void addSearchRoot(const std::string& root);
+
+    // Elimina todas las races de bsqueda registradas.
+    void clearSearchRoots();
+
+    // Devuelve la lista de races de bsqueda.
+    const std::vector<std::string>& getSearchRoots() const;
+
+    /*
+      Funcin resolvePath.
+      - Devuelve la ruta normalizada del primer archivo existente que coincide con path
+        dentro de las races de bsqueda, o una cadena vaca si no se encontr.
+      - Las rutas absolutas se devuelven tal cual si el archivo existe.
+    */
+    std::string resolvePath(const std::string& path) const;
+
+    /*
+      Funcin mountArchive.
+      - Monta un archivo empaquetado (.spak). Los recursos se buscan primero en los archivos
+        montados (del ltimo al primero) y despus como archivos sueltos en las races de bsqueda.
+      - La ruta del .spak tambin se resuelve contra las races de bsqueda.
+      - Devuelve false si el archivo no existe o no es vlido.
+    */
+    bool mountArchive(const std::string& path);
+
+    /*
+      Funciones getTexture, getFont y getSoundBuffer.
+      - Devuelven el recurso de la cach si ya estaba cargado, o lo cargan desde disco.
+      - Si la carga falla, devuelven un handle invlido (isValid() == false).
+    */
+    TextureHandle getTexture(const std::string& path);
+    FontHandle getFont(const std::string& path);
+    SoundBufferHandle getSoundBuffer(const std::string& path);
+
+    /*
+      Funcin getTextureAsync.
+      - Devuelve inmediatamente un handle cuya textura contiene un placeholder.
+      - La lectura del archivo y la decodificacin de la imagen (sf::Image) se hacen en un hilo
+        de trabajo; la subida a la GPU (sf::Texture::loadFromImage) se hace despus en el hilo
+        principal, dentro de processUploads().
+      - La textura se actualiza en el mismo objeto, por lo que las formas que ya la referencian
+        muestran el contenido real sin tener que reasignarla.
+    */
+    TextureHandle getTextureAsync(const std::string& path);
+
+    /*
+      Funcin whenReady.
+      - Registra una funcin que se ejecuta en el hilo principal cuando la textura termina de cargarse
+        (o de inmediato si ya estaba lista). til, por ejemplo, para reajustar el textureRect de una forma.
+    */
+    void whenReady(const TextureHandle& handle, std::function<void(sf::Texture&)> callback);
+
+    /*
+      Funcin processUploads.
+      - Sube a la GPU las imgenes ya decodificadas, respetando un presupuesto de tiempo por frame.
+      - Siempre procesa al menos una imagen para garantizar el avance de la cola.
+        Un presupuesto de sf::Time::Zero procesa toda la cola.
+      - Debe llamarse desde el hilo que posee el contexto de OpenGL. Devuelve las texturas subidas.
+    */
+    size_t processUploads(sf::Time budget);
+
+    /*
+      Funcin setHotReload.
+      - Activa o desactiva la recarga en caliente de texturas.
+      - Con la recarga activa, cada textura cargada se vigila en disco; cuando su archivo cambia,
+        solo esa imagen se vuelve a decodificar en un hilo de trabajo y se sube sobre el mismo
+        sf::Texture, as que todas las formas que la usan ven el cambio sin reiniciar la aplicacin.
+    */
+    void setHotReload(bool enabled);
+
+    // Indica si la recarga en caliente est activa.
+    bool isHotReloadEnabled() const;
+
+    /*
+      Funcin update.
+      - Actualizacin por frame de la cach: revisa los archivos modificados y sube
+        las imgenes pendientes respetando el presupuesto de tiempo (ver processUploads).
+    */
+    void update(sf::Time budget);
+
+    /*
+      Funcin finishPendingLoads.
+      - Espera a que todas las cargas asncronas terminen y las sube a la GPU.
+      - til para herramientas y pantallas de carga que necesitan todo listo antes de continuar.
+    */
+    void finishPendingLoads();
+
+    /*
+      Funcin releaseUnused.
+      - Descarga los recursos que solo siguen referenciados por la propia cach.
+      - Devuelve el nmero de recursos liberados.
+    */
+    size_t releaseUnused();
+
+    // Vaca la cach por completo. Los handles existentes siguen siendo vlidos.
+    void clear();
+
+    // Devuelve las estadsticas actuales de la cach.
+    Stats getStats() const;
+
+    /*
+      Funcin drawStats.
+      - Dibuja una ventana de ImGui con los aciertos, fallos y memoria residente de la cach,
+        adems de la lista de recursos cargados y su nmero de referencias.
+    */
+    void drawStats();
+
+private:
+    /*
+      Estructura CacheEntry.
+      - Entrada de la cach: el recurso compartido, la ruta desde donde se carg
+        y los bytes que ocupa en memoria.
+    */
+    template<typename T>
+    struct CacheEntry
+    {
+        EngineUtilities::TSharedPointer<T> resource;
+        EngineUtilities::TSharedPointer<LoadStatus> status;
+        std::string path;
+        size_t bytes = 0;
+        bool packed = false;  // Cargado desde un .spak (no se vigila en disco).
+    };
+
+    /*
+      Funcin locate.
+      - Busca un recurso primero en los archivos montados y luego en las races de bsqueda.
+      - Devuelve un AssetSource con path vaco si no se encontr.
+      - No lee el blob: la bsqueda en la cach se hace antes de pagar la lectura y la descompresin.
+    */
+    AssetSource locate(const std::string& path) const;
+
+    /*
+      Funcin fetch.
+      - Lee (y descomprime, si hace falta) los bytes de un blob localizado con locate.
+        Los archivos sueltos no necesitan nada. Es segura desde los hilos de carga.
+    */
+    static bool fetch(AssetSource& source);
+
+    /*
+      Estructura DecodedImage.
+      - Resultado de un hilo de trabajo: la imagen decodificada lista para subirse a la GPU.
+    */
+    struct DecodedImage
+    {
+        uint64_t id = 0;
+        sf::Image image;
+        bool ok = false;
+        bool reload = false;  // true si reemplaza una textura que ya estaba lista (recarga en caliente).
+    };
+
+    /*
+      Funcin decodeImage.
+      - Decodifica una imagen desde su origen. Los archivos .cooked (ver AssetCooker) ya contienen
+        pxeles RGBA, por lo que solo se copian; el resto de formatos pasa por sf::Image.
+      - Es segura desde los hilos de trabajo: no toca OpenGL.
+    */
+    static bool decodeImage(sf::Image& image, const AssetSource& source);
+
+    // Encola la lectura y decodificacin de una imagen en los hilos de carga.
+    void submitDecode(uint64_t id, const AssetSource& source, bool reload);
+
+    // Revisa los archivos modificados y encola la recarga de las texturas afectadas.
+    void pollFileChanges();
+
+    template<typename T>
+    using Cache = std::unordered_map<uint64_t, CacheEntry<T>>;
+
+    /*
+      Funcin acquire.
+      - Lgica comn a todos los tipos de recurso: resuelve la ruta, busca en la cach y,
+        si no existe, crea el recurso con loader y mide su tamao con sizeOf.
+    */
+    template<typename T, typename Loader, typename SizeOf>
+    ResourceHandle<T> acquire(Cache<T>& cache, const std::string& path, Loader loader, SizeOf sizeOf);
+
+    // Libera las entradas no utilizadas de una cach concreta.
+    template<typename T>
+    size_t releaseUnused(Cache<T>& cache);
+
+    // Dibuja en ImGui las entradas de una cach concreta.
+    template<typename T>
+    void drawEntries(const char* label, const Cache<T>& cache) const;
+
+    std::vector<std::string> m_searchRoots;   // Races de bsqueda de recursos.
+
+    // Archivos empaquetados montados. Se declaran antes que las cachs para que sigan proyectados
+    // mientras se destruyen los recursos (sf::Font lee de la memoria del .spak durante toda su vida).
+    std::vector<EngineUtilities::TSharedPointer<AssetArchive>> m_archives;
+
+    Cache<sf::Texture> m_textures;            // Texturas cargadas.
+    Cache<sf::Font> m_fonts;                  // Fuentes cargadas.
+    Cache<sf::SoundBuffer> m_soundBuffers;    // Buffers de sonido cargados.
+
+    Stats m_stats;                            // Estadsticas acumuladas.
+
+    sf::Image m_placeholder;                  // Imagen que muestran las texturas asncronas mientras cargan.
+    size_t m_pendingLoads = 0;                // Texturas asncronas an no subidas.
+    std::unordered_map<uint64_t, std::vector<std::function<void(sf::Texture&)>>> m_readyCallbacks;
+
+    bool m_hotReload = false;                 // Recarga en caliente activa.
+    FileWatcher m_watcher;                    // Vigila los archivos de las texturas cargadas.
+    std::unordered_set<uint64_t> m_reloading;     // Texturas con una recarga en curso.
+    std::unordered_set<uint64_t> m_reloadAgain;   // Texturas que cambiaron otra vez durante su recarga.
+
+    std::mutex m_decodedMutex;                // Protege la cola de imgenes decodificadas.
+    std::deque<DecodedImage> m_decoded;       // Imgenes listas para subirse en el hilo principal.
+
+    // Hilos de carga. Se declara al final para que se destruya primero y no escriba en una cola ya destruida.
+    ThreadPool m_loaders{ 0, "Loader" };
+};
+
+template<typename T, typename Loader, typename SizeOf>
+inline ResourceHandle<T> ResourceManager::acquire(Cache<T>& cache, const std::string& path, Loader loader, SizeOf sizeOf)
+{
+    AssetSource source = locate(path);
+    if (source.path.empty())
+    {
+        ++m_stats.failures;
+        LOG_ERROR("ResourceManager", "acquire", "no se encontro el recurso [{}]", path);
+        return ResourceHandle<T>();
+    }
+
+    const uint64_t id = Hash::hashPath(source.path);
+
+    // Acierto: el recurso ya est en memoria.
+    auto it = cache.find(id);
+    if (it != cache.end())
+    {
+        ++m_stats.hits;
+        return ResourceHandle<T>{ id, it->second.resource, it->second.status };
+    }
+
+    // Fallo de cach: leer el blob y cargar el recurso.
+    ++m_stats.misses;
+    EngineUtilities::TSharedPointer<T> resource = EngineUtilities::MakeShared<T>();
+    if (!fetch(source) || !loader(*resource, source))
+    {
+        ++m_stats.failures;
+        LOG_ERROR("ResourceManager", "acquire", "error al cargar [{}]", source.path);
+        return ResourceHandle<T>();
+    }
+
+    CacheEntry<T> entry;
+    entry.resource = resource;
+    entry.path = source.path;
+    entry.packed = source.isPacked();
+    entry.bytes = sizeOf(*resource, source);
+    m_stats.residentBytes += entry.bytes;
+    cache.emplace(id, entry);
+
+    return ResourceHandle<T>{ id, resource, EngineUtilities::TSharedPointer<LoadStatus>() };
+}
+
+template<typename T>
+inline size_t ResourceManager::releaseUnused(Cache<T>& cache)
+{
+    size_t released = 0;
+    for (auto it = cache.begin(); it != cache.end();)
+    {
+        // Si el nico dueo es la cach, el recurso ya no se usa.
+        if (it->second.resource.refCount && *it->second.resource.refCount == 1)
+        {
+            m_stats.residentBytes -= it->second.bytes;
+            it = cache.erase(it);
+            ++released;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    return released;
+}
+
+template<typename T>
+inline void ResourceManager::drawEntries(const char* label, const Cache<T>& cache) const
+{
+    if (!ImGui::TreeNode(label, "%s (%zu)", label, cache.size()))
+    {
+        return;
+    }
+    for (const auto& [id, entry] : cache)
+    {
+        const int refs = entry.resource.refCount ? *entry.resource.refCount - 1 : 0;
+        const char* state = entry.status.isNull() ? "ready"
+            : entry.status->state == LoadState::Loading ? "loading"
+            : entry.status->state == LoadState::Failed ? "failed" : "ready";
+        ImGui::Text("%016llx  %6.1f KB  refs %d  %-7s %s",
+            static_cast<unsigned long long>(id),
+            entry.bytes / 1024.0,
+            refs,
+            state,
+            entry.path.c_str());
+    }
+    ImGui::TreePop();
+}
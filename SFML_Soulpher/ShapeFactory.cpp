@@ -1,48 +1,58 @@
 #include "ShapeFactory.h"
+#include <cmath>
 
 /*
    Implementacin del constructor parametrizado.
    Inicializa con un tipo especfico de forma.
 */
 ShapeFactory::ShapeFactory(ShapeType shapeType)
-    : m_shape(nullptr), m_shapeType(shapeType), Component(ComponentType::SHAPE) {}
+    : m_shapeType(shapeType), Component(ComponentType::SHAPE) {}
 
 /* 
-   Crea una nueva forma geomtrica segn el tipo indicado en shapeType
-   Asigna la forma creada al puntero `m_shape` y devuelve un puntero a la forma.
-   return -> Puntero a la forma creada  en `sf::Shape*`.
+   Traduce el tipo indicado en shapeType a su descriptor.
+   Los parmetros son los de las formas originales de SFML, as que la apariencia no cambia.
+   return -> Geometra de la forma, o nullptr para EMPTY.
 */
-sf::Shape* ShapeFactory::createShape(ShapeType shapeType) {
-    m_shapeType = shapeType;
-
+const ShapeGeometry* ShapeFactory::createShape(ShapeType shapeType) {
     switch (shapeType) {
-    case ShapeType::EMPTY:
-        return nullptr;
-
-    case ShapeType::CIRCLE: {
-        sf::CircleShape* circle = new sf::CircleShape(15.0f); // CircleShape(15.0f) -> Tamao de los personajes 
-        // circle->setFillColor(sf::Color::White); <- Para cuando el crculo era de color slido
-        m_shape = circle;
-        return circle;
-    }
+    case ShapeType::CIRCLE:
+        createShape(CircleDescriptor{ 15.0f });  // Radio 15 -> Tamao de los personajes 
+        break;
 
-    case ShapeType::RECTANGLE: {
-        sf::RectangleShape* rectangle = new sf::RectangleShape(sf::Vector2f(100.0f, 50.0f));
-        rectangle->setFillColor(sf::Color::White);
-        m_shape = rectangle;
-        return rectangle;
-    }
+    case ShapeType::RECTANGLE:
+        createShape(RectangleDescriptor{ sf::Vector2f(100.0f, 50.0f) });
+        break;
 
-    case ShapeType::TRIANGLE: {
-        sf::CircleShape* triangle = new sf::CircleShape(50.0f, 3);  // Tringulo con 3 puntos.
-        triangle->setFillColor(sf::Color::White);
-        m_shape = triangle;
-        return triangle;
-    }
+    case ShapeType::TRIANGLE:
+        createShape(NGonDescriptor{ 50.0f, 3 });  // Tringulo con 3 puntos.
+        break;
 
     default:
-        return nullptr;
+        createShape(std::monostate());
+        break;
     }
+
+    m_shapeType = shapeType;
+    return m_instance.geometry;
+}
+
+/*
+   Guarda el descriptor por valor y obtiene su geometra de la cach.
+   El tipo se deduce de la alternativa activa del variant.
+*/
+const ShapeGeometry* ShapeFactory::createShape(const ShapeDescriptor& descriptor) {
+    static constexpr ShapeType types[] = { ShapeType::EMPTY, ShapeType::CIRCLE, ShapeType::RECTANGLE, ShapeType::TRIANGLE };
+    static_assert(std::variant_size_v<ShapeDescriptor> == sizeof(types) / sizeof(types[0]),
+        "Cada alternativa de ShapeDescriptor necesita su ShapeType");
+
+    m_shapeType = types[descriptor.index()];
+    m_instance.descriptor = descriptor;
+    m_instance.geometry = ShapeGeometry::acquire(descriptor);
+    m_instance.color = sf::Color::White;
+    m_instance.lods = nullptr;
+    m_instance.lodLevel = 0;
+    setLodEnabled(true);
+    return m_instance.geometry;
 }
 
 /* 
@@ -53,18 +63,43 @@ void ShapeFactory::update(float deltaTime) {
     // Implementacin futura: Aadir lgica de actualizacin si es necesario.
 }
 
-   // Renderiza la forma en la ventana proporcionada.
+/*
+   Renderiza la forma en la ventana proporcionada.
+   Los vrtices se componen en un bfer temporal reutilizado (uno por hilo);
+   la transformacin va en los RenderStates.
+*/
 void ShapeFactory::render(Window& window) {
-    if (m_shape != nullptr) {
-        window.draw(*m_shape);  // Dibuja la forma en la ventana.
+    updateLod(window.getPixelsPerUnit());
+
+    static thread_local std::vector<sf::Vertex> vertices;
+    buildVertices(vertices);
+    if (vertices.empty()) {
+        return;
+    }
+
+    sf::RenderStates states(getTransform());
+    states.texture = m_instance.texture;
+    window.draw(vertices.data(), vertices.size(), sf::TriangleFan, states);  // Dibuja la forma en la ventana.
+}
+
+// Igual que render, sobre un bfer de comandos.
+void ShapeFactory::record(RenderCommandBuffer& commands, float pixelsPerUnit, uint16_t layer) {
+    updateLod(pixelsPerUnit);
+
+    static thread_local std::vector<sf::Vertex> vertices;
+    buildVertices(vertices);
+    if (vertices.empty()) {
+        return;
     }
+
+    sf::RenderStates states(getTransform());
+    states.texture = m_instance.texture;
+    commands.record(vertices.data(), vertices.size(), sf::TriangleFan, states, layer);
 }
 
 //Establece la posicin de la forma con coordenadas X & Y.
 void ShapeFactory::setPosition(float x, float y) {
-    if (m_shape != nullptr) {
-        m_shape->setPosition(x, y);
-    }
+    m_instance.position = sf::Vector2f(x, y);
 }
 
 /*
@@ -72,9 +107,7 @@ void ShapeFactory::setPosition(float x, float y) {
    position Un vector con las coordenadas X & Y.
 */
 void ShapeFactory::setPosition(const sf::Vector2f& position) {
-    if (m_shape != nullptr) {
-        m_shape->setPosition(position);
-    }
+    m_instance.position = position;
 }
 
 /*
@@ -82,9 +115,7 @@ void ShapeFactory::setPosition(const sf::Vector2f& position) {
    color El nuevo color a aplicar.
 */
 void ShapeFactory::setFillColor(const sf::Color& color) {
-    if (m_shape != nullptr) {
-        m_shape->setFillColor(color);
-    }
+    m_instance.color = color;
 }
 
 /*
@@ -92,9 +123,7 @@ void ShapeFactory::setFillColor(const sf::Color& color) {
    angle ngulo de rotacin.
 */
 void ShapeFactory::setRotation(float angle) {
-    if (m_shape != nullptr) {
-        m_shape->setRotation(angle);
-    }
+    m_instance.rotation = angle;
 }
 
 /*
@@ -102,15 +131,117 @@ void ShapeFactory::setRotation(float angle) {
    scl Vector con los valores de escala.
 */
 void ShapeFactory::setScale(const sf::Vector2f& scl) {
-    if (m_shape != nullptr) {
-        m_shape->setScale(scl);
+    m_instance.scale = scl;
+}
+
+/*
+   Asigna la textura. Igual que sf::Shape, la primera textura ajusta el textureRect
+   a su tamao si todava no se haba definido uno.
+*/
+void ShapeFactory::setTexture(const sf::Texture* texture, bool resetRect) {
+    if (texture != nullptr && (resetRect || (m_instance.texture == nullptr && m_instance.textureRect == sf::IntRect()))) {
+        const sf::Vector2u size = texture->getSize();
+        m_instance.textureRect = sf::IntRect(0, 0, static_cast<int>(size.x), static_cast<int>(size.y));
     }
+    m_instance.texture = texture;
+}
+
+// Establece la parte visible de la textura.
+void ShapeFactory::setTextureRect(const sf::IntRect& rect) {
+    m_instance.textureRect = rect;
 }
 
 /*
-   Devuelve un puntero a la forma creada.
-   Return -> Puntero a la forma : `sf::Shape*`.
+   Radio proyectado: se usa la mayor escala para no quedarse corto en crculos estirados.
 */
-sf::Shape* ShapeFactory::getShape() {
-    return m_shape;
-}
\ No newline at end of file
+void ShapeFactory::updateLod(float pixelsPerUnit) {
+    const CircleDescriptor* circle = std::get_if<CircleDescriptor>(&m_instance.descriptor);
+    if (m_instance.lods == nullptr || circle == nullptr) {
+        return;
+    }
+
+    const float scale = std::max(std::abs(m_instance.scale.x), std::abs(m_instance.scale.y));
+    const float pixelRadius = circle->radius * scale * pixelsPerUnit;
+    const unsigned int level = m_instance.lods->selectLevel(pixelRadius, m_instance.lodLevel);
+    m_instance.lodLevel = static_cast<uint8_t>(level);
+    m_instance.geometry = m_instance.lods->levels[level];
+}
+
+/*
+   Los niveles se precalculan al activar el LOD; el nivel inicial es el ms cercano
+   al nmero de puntos del descriptor.
+*/
+void ShapeFactory::setLodEnabled(bool enabled) {
+    const CircleDescriptor* circle = std::get_if<CircleDescriptor>(&m_instance.descriptor);
+    if (circle == nullptr) {
+        return;
+    }
+
+    if (enabled) {
+        m_instance.lods = ShapeGeometry::acquireLods(*circle);
+        m_instance.lodLevel = static_cast<uint8_t>(ShapeLodSet::levelForPointCount(circle->pointCount));
+        m_instance.geometry = m_instance.lods->levels[m_instance.lodLevel];
+    }
+    else {
+        m_instance.lods = nullptr;
+        m_instance.lodLevel = 0;
+        m_instance.geometry = ShapeGeometry::acquire(*circle);
+    }
+}
+
+/*
+   Compone los vrtices a partir de la geometra compartida: el color y el textureRect son de la instancia.
+*/
+void ShapeFactory::buildVertices(std::vector<sf::Vertex>& vertices) const {
+    const ShapeGeometry* geometry = m_instance.geometry;
+    if (geometry == nullptr) {
+        vertices.clear();
+        return;
+    }
+
+    const std::vector<sf::Vector2f>& positions = geometry->getPositions();
+    const std::vector<sf::Vector2f>& texCoords = geometry->getTexCoords();
+    const sf::FloatRect rect(m_instance.textureRect);
+
+    vertices.resize(positions.size());
+    for (size_t i = 0; i < positions.size(); ++i) {
+        vertices[i].position = positions[i];
+        vertices[i].color = m_instance.color;
+        vertices[i].texCoords = sf::Vector2f(rect.left + rect.width * texCoords[i].x,
+            rect.top + rect.height * texCoords[i].y);
+    }
+}
+
+// Lmites locales transformados al mundo.
+sf::FloatRect ShapeFactory::getGlobalBounds() const {
+    if (m_instance.geometry == nullptr) {
+        return sf::FloatRect();
+    }
+    return getTransform().transformRect(m_instance.geometry->getLocalBounds());
+}
+
+// Geometra compartida de la forma.
+const ShapeGeometry* ShapeFactory::getGeometry() const {
+    return m_instance.geometry;
+}
+
+// Datos propios de la forma.
+const ShapeInstance& ShapeFactory::getInstance() const {
+    return m_instance;
+}
+
+// Tipo de forma gestionada.
+ShapeType ShapeFactory::getShapeType() const {
+    return m_shapeType;
+}
+
+/*
+   Misma composicin que sf::Transformable con origen (0, 0): trasladar, rotar y escalar.
+*/
+sf::Transform ShapeFactory::getTransform() const {
+    sf::Transform transform;
+    transform.translate(m_instance.position);
+    transform.rotate(m_instance.rotation);
+    transform.scale(m_instance.scale);
+    return transform;
+}
@@ -2,6 +2,26 @@
 #include "Prerequisites.h"
 #include "Component.h"  
 #include "Window.h"  
+#include "ShapeGeometry.h"
+
+/*
+  Estructura ShapeInstance
+  - Datos propios de cada forma: descriptor, geometra compartida, textura, transformacin, color y textureRect.
+  - Es un tipo valor de unas decenas de bytes; los vrtices viven una sola vez en ShapeGeometry.
+*/
+struct ShapeInstance
+{
+    ShapeDescriptor descriptor;                // Parmetros de la forma, guardados por valor.
+    const ShapeGeometry* geometry = nullptr;   // Geometra compartida (propiedad de la cach).
+    const sf::Texture* texture = nullptr;      // Textura (propiedad del ResourceManager).
+    sf::Vector2f position;
+    sf::Vector2f scale = sf::Vector2f(1.0f, 1.0f);
+    float rotation = 0.0f;                     // Grados.
+    sf::Color color = sf::Color::White;
+    sf::IntRect textureRect;
+    const ShapeLodSet* lods = nullptr;         // Niveles de detalle (solo crculos con LOD activo).
+    uint8_t lodLevel = 0;                      // Nivel de detalle actual.
+};
 
 /*
   Clase ShapeFactory:
@@ -28,11 +48,20 @@ public:
     /*
       Funcin createShape.
       - Crea una forma basada en el tipo de `ShapeType` proporcionado.
+      - La geometra se obtiene de la cach de ShapeGeometry: la forma no tesela ni guarda vrtices propios,
+        solo apunta a la geometra compartida.
       Esta funcin se encarga de instanciar diferentes tipos de formas como crculos, tringulos o rectngulos
       segn se especifique. En un entorno 3D, una funcin similar podra ser utilizada para instanciar diferentes
       tipos de geometras (como esferas, cubos o modelos personalizados).
     */
-    sf::Shape* createShape(ShapeType shapeType);
+    const ShapeGeometry* createShape(ShapeType shapeType);
+
+    /*
+      Sobrecarga de la funcin createShape.
+      - Crea la forma a partir de un descriptor (CircleDescriptor, RectangleDescriptor o NGonDescriptor).
+      - Llamarla varias veces solo reemplaza el descriptor: no hay memoria que liberar.
+    */
+    const ShapeGeometry* createShape(const ShapeDescriptor& descriptor);
 
     /*
       Funcin update.
@@ -50,6 +79,14 @@ public:
     */
     void render(Window& window) override;
 
+    /*
+      Funcin record.
+      - Lo mismo que render, pero grabando el comando en un RenderCommandBuffer propio en lugar de
+        la ventana. Sirve para preparar el dibujo de muchas formas (o sin ventana) y enviarlo junto
+        con Window::submit.
+    */
+    void record(RenderCommandBuffer& commands, float pixelsPerUnit, uint16_t layer = LAYER_WORLD);
+
     /*
       Funcin setPosition.
       - Establece la posicin de la forma utilizando coordenadas (x, y) flotantes.
@@ -83,12 +120,6 @@ public:
         float range){
     }
 
-    /*
-      Funcin getShape.
-      - Devuelve un puntero a la forma (sf::Shape).
-      Esta funcin permite acceder a la forma para modificar propiedades como posicin, color y transformaciones.
-    */
-
     // Establece la escala de la forma.
     // scl Vector con los valores de escala en X e Y.
     void setScale(const sf::Vector2f& scl);
@@ -97,9 +128,54 @@ public:
     // angle = ngulo de rotacin en grados.
     void setRotation(float angle);
 
-    sf::Shape* getShape();
+    /*
+      Funcin setTexture.
+      - Asigna la textura de la forma, con la misma regla que sf::Shape::setTexture: si resetRect es true,
+        o si es la primera textura y no hay textureRect, el textureRect pasa a cubrir toda la textura.
+    */
+    void setTexture(const sf::Texture* texture, bool resetRect = false);
+
+    // Establece la parte de la textura que se muestra en la forma.
+    void setTextureRect(const sf::IntRect& rect);
+
+    /*
+      Funcin updateLod.
+      - Elige el nivel de detalle de un crculo segn su radio proyectado en pantalla
+        (radio local x escala x pxeles por unidad de la vista). render() la llama en cada frame.
+      - No tiene efecto en rectngulos, polgonos (el tringulo conserva sus 3 lados) o si el LOD est desactivado.
+    */
+    void updateLod(float pixelsPerUnit);
+
+    /*
+      Funcin setLodEnabled.
+      - Activa o desactiva el nivel de detalle automtico. Al desactivarlo, el crculo
+        vuelve al nmero de puntos de su descriptor.
+    */
+    void setLodEnabled(bool enabled);
+
+    /*
+      Funcin buildVertices.
+      - Compone los vrtices de la forma (geometra compartida con el color y el textureRect de la instancia)
+        en espacio local. La transformacin se aplica al dibujar, con getTransform().
+    */
+    void buildVertices(std::vector<sf::Vertex>& vertices) const;
+
+    // Devuelve el rectngulo de la forma en coordenadas del mundo.
+    sf::FloatRect getGlobalBounds() const;
+
+    // Devuelve la geometra compartida (nullptr si no se ha creado la forma).
+    const ShapeGeometry* getGeometry() const;
+
+    // Devuelve los datos propios de la forma.
+    const ShapeInstance& getInstance() const;
+
+    // Devuelve el tipo de forma gestionada.
+    ShapeType getShapeType() const;
+
+    // Transformacin de la instancia (traslacin, rotacin y escala, con el origen en la esquina local).
+    sf::Transform getTransform() const;
 
 private:
-    sf::Shape* m_shape = nullptr;              // Puntero a la forma gestionada por esta shapeFactory.
+    ShapeInstance m_instance;                  // Datos propios de la forma.
     ShapeType m_shapeType = ShapeType::EMPTY;  // Tipo de forma gestionada.
 };
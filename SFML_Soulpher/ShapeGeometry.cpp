@@ -0,0 +1,183 @@
+#include "ShapeGeometry.h"
+#include "Hash.h"
+#include <cmath>
+
+std::mutex ShapeGeometry::s_mutex;
+std::unordered_map<ShapeDescriptor, EngineUtilities::TSharedPointer<ShapeGeometry>, ShapeGeometry::DescriptorHash> ShapeGeometry::s_cache;
+std::unordered_map<float, EngineUtilities::TSharedPointer<ShapeLodSet>> ShapeGeometry::s_lodCache;
+
+/*
+   Seleccin con histresis. Los bucles permiten saltar varios niveles de golpe
+   (por ejemplo, al cambiar el zoom de la cmara bruscamente).
+*/
+unsigned int ShapeLodSet::selectLevel(float pixelRadius, unsigned int currentLevel) const {
+    unsigned int level = std::min(currentLevel, LEVEL_COUNT - 1);
+    while (level + 1 < LEVEL_COUNT && pixelRadius > maxPixelRadius[level] * (1.0f + LOD_HYSTERESIS)) {
+        ++level;
+    }
+    while (level > 0 && pixelRadius < maxPixelRadius[level - 1] * (1.0f - LOD_HYSTERESIS)) {
+        --level;
+    }
+    return level;
+}
+
+// Primer nivel con al menos pointCount puntos (el ltimo si ninguno alcanza).
+unsigned int ShapeLodSet::levelForPointCount(unsigned int pointCount) {
+    for (unsigned int i = 0; i < LEVEL_COUNT; ++i) {
+        if (POINT_COUNTS[i] >= pointCount) {
+            return i;
+        }
+    }
+    return LEVEL_COUNT - 1;
+}
+
+/*
+   Hash del descriptor: ndice de la alternativa activa y los campos de esa alternativa.
+*/
+size_t ShapeGeometry::DescriptorHash::operator()(const ShapeDescriptor& descriptor) const {
+    const size_t index = descriptor.index();
+    uint64_t hash = Hash::fnv1a64(&index, sizeof(index));
+    std::visit([&hash](const auto& shape) {
+        using Shape = std::decay_t<decltype(shape)>;
+        if constexpr (std::is_same_v<Shape, CircleDescriptor>) {
+            hash = Hash::fnv1a64(&shape.radius, sizeof(shape.radius), hash);
+            hash = Hash::fnv1a64(&shape.pointCount, sizeof(shape.pointCount), hash);
+        }
+        else if constexpr (std::is_same_v<Shape, RectangleDescriptor>) {
+            hash = Hash::fnv1a64(&shape.size.x, sizeof(float), hash);
+            hash = Hash::fnv1a64(&shape.size.y, sizeof(float), hash);
+        }
+        else if constexpr (std::is_same_v<Shape, NGonDescriptor>) {
+            hash = Hash::fnv1a64(&shape.radius, sizeof(shape.radius), hash);
+            hash = Hash::fnv1a64(&shape.sides, sizeof(shape.sides), hash);
+        }
+        }, descriptor);
+    return static_cast<size_t>(hash);
+}
+
+/*
+   Busca la geometra en la cach y la tesela si no existe.
+   El constructor es privado, as que la geometra se crea con new y se entrega al TSharedPointer.
+*/
+const ShapeGeometry* ShapeGeometry::acquire(const ShapeDescriptor& descriptor) {
+    if (std::holds_alternative<std::monostate>(descriptor)) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(s_mutex);
+    auto it = s_cache.find(descriptor);
+    if (it == s_cache.end()) {
+        it = s_cache.emplace(descriptor, EngineUtilities::TSharedPointer<ShapeGeometry>(new ShapeGeometry(descriptor))).first;
+    }
+    return it->second.get();
+}
+
+/*
+   Tesela todos los niveles de un radio. Las geometras se piden con acquire() fuera del candado
+   (acquire tambin lo toma); si dos hilos construyen el mismo conjunto a la vez, se conserva el primero.
+*/
+const ShapeLodSet* ShapeGeometry::acquireLods(const CircleDescriptor& circle) {
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        auto it = s_lodCache.find(circle.radius);
+        if (it != s_lodCache.end()) {
+            return it->second.get();
+        }
+    }
+
+    const float pi = 3.141592654f;
+    EngineUtilities::TSharedPointer<ShapeLodSet> lods = EngineUtilities::MakeShared<ShapeLodSet>();
+    for (unsigned int i = 0; i < ShapeLodSet::LEVEL_COUNT; ++i) {
+        const unsigned int points = ShapeLodSet::POINT_COUNTS[i];
+        lods->levels[i] = acquire(CircleDescriptor{ circle.radius, points });
+        lods->maxPixelRadius[i] = ShapeLodSet::LOD_PIXEL_TOLERANCE / (1.0f - std::cos(pi / points));
+    }
+
+    std::lock_guard<std::mutex> lock(s_mutex);
+    return s_lodCache.emplace(circle.radius, lods).first->second.get();
+}
+
+// Nmero de geometras en la cach.
+size_t ShapeGeometry::getCachedCount() {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    return s_cache.size();
+}
+
+// Memoria de los vrtices compartidos.
+size_t ShapeGeometry::getMemoryUsage() const {
+    return sizeof(ShapeGeometry) + (m_positions.capacity() + m_texCoords.capacity()) * sizeof(sf::Vector2f);
+}
+
+/*
+   Construye el abanico de la misma forma que sf::Shape::update: el vrtice 0 es el centro
+   de los lmites, despus van los puntos del contorno y al final se repite el primero.
+*/
+ShapeGeometry::ShapeGeometry(const ShapeDescriptor& descriptor)
+    : m_descriptor(descriptor) {
+    ShapeOutline outline;
+    buildOutline(descriptor, outline);
+    if (outline.count < 3) {
+        return;
+    }
+
+    sf::Vector2f minimum = outline.points[0];
+    sf::Vector2f maximum = outline.points[0];
+    for (unsigned int i = 0; i < outline.count; ++i) {
+        minimum.x = std::min(minimum.x, outline.points[i].x);
+        minimum.y = std::min(minimum.y, outline.points[i].y);
+        maximum.x = std::max(maximum.x, outline.points[i].x);
+        maximum.y = std::max(maximum.y, outline.points[i].y);
+    }
+    m_bounds = sf::FloatRect(minimum, maximum - minimum);
+
+    m_positions.reserve(outline.count + 2);
+    m_positions.push_back(sf::Vector2f(m_bounds.left + m_bounds.width / 2.0f, m_bounds.top + m_bounds.height / 2.0f));
+    m_positions.insert(m_positions.end(), outline.points.begin(), outline.points.begin() + outline.count);
+    m_positions.push_back(outline.points[0]);
+
+    m_texCoords.reserve(m_positions.size());
+    for (const sf::Vector2f& position : m_positions) {
+        const float u = m_bounds.width > 0.0f ? (position.x - m_bounds.left) / m_bounds.width : 0.0f;
+        const float v = m_bounds.height > 0.0f ? (position.y - m_bounds.top) / m_bounds.height : 0.0f;
+        m_texCoords.push_back(sf::Vector2f(u, v));
+    }
+}
+
+// Despacha al generador del tipo activo.
+void ShapeGeometry::buildOutline(const ShapeDescriptor& descriptor, ShapeOutline& outline) {
+    std::visit([&outline](const auto& shape) { buildOutline(shape, outline); }, descriptor);
+}
+
+// Forma vaca: sin puntos.
+void ShapeGeometry::buildOutline(const std::monostate&, ShapeOutline& outline) {
+    outline.count = 0;
+}
+
+// Crculo: mismas frmulas que sf::CircleShape (empieza arriba y su caja es [0, 2r]).
+void ShapeGeometry::buildOutline(const CircleDescriptor& circle, ShapeOutline& outline) {
+    buildRegularPolygon(circle.radius, circle.pointCount, outline);
+}
+
+// Rectngulo con su esquina superior izquierda en el origen, como sf::RectangleShape.
+void ShapeGeometry::buildOutline(const RectangleDescriptor& rectangle, ShapeOutline& outline) {
+    outline.points[0] = sf::Vector2f(0.0f, 0.0f);
+    outline.points[1] = sf::Vector2f(rectangle.size.x, 0.0f);
+    outline.points[2] = sf::Vector2f(rectangle.size.x, rectangle.size.y);
+    outline.points[3] = sf::Vector2f(0.0f, rectangle.size.y);
+    outline.count = 4;
+}
+
+// Polgono regular: un crculo con pocos puntos (sf::CircleShape(50, 3) para el tringulo).
+void ShapeGeometry::buildOutline(const NGonDescriptor& polygon, ShapeOutline& outline) {
+    buildRegularPolygon(polygon.radius, polygon.sides, outline);
+}
+
+// Puntos repartidos uniformemente desde -90 grados.
+void ShapeGeometry::buildRegularPolygon(float radius, unsigned int pointCount, ShapeOutline& outline) {
+    const float pi = 3.141592654f;
+    outline.count = std::min(pointCount, MAX_OUTLINE_POINTS);
+    for (unsigned int i = 0; i < outline.count; ++i) {
+        const float angle = i * 2.0f * pi / outline.count - pi / 2.0f;
+        outline.points[i] = sf::Vector2f(std::cos(angle) * radius + radius, std::sin(angle) * radius + radius);
+    }
+}
@@ -0,0 +1,175 @@
+#pragma once
+#include "Prerequisites.h"
+#include <array>
+#include <mutex>
+#include <unordered_map>
+#include <variant>
+
+/*
+  Descriptores de forma
+  - Cada tipo de forma es un struct pequeo con solo sus parmetros; ShapeDescriptor es un
+    std::variant de todos ellos, guardado por valor (sin new ni punteros a una clase base).
+  - Dos descriptores iguales producen exactamente la misma geometra, por lo que sirven como
+    clave de la cach de ShapeGeometry.
+*/
+struct CircleDescriptor
+{
+    float radius = 0.0f;
+    unsigned int pointCount = 30;   // Igual que sf::CircleShape.
+
+    bool operator==(const CircleDescriptor& other) const {
+        return radius == other.radius && pointCount == other.pointCount;
+    }
+};
+
+struct RectangleDescriptor
+{
+    sf::Vector2f size;
+
+    bool operator==(const RectangleDescriptor& other) const {
+        return size == other.size;
+    }
+};
+
+// Polgono regular inscrito en un crculo (el tringulo es un NGon de 3 lados).
+struct NGonDescriptor
+{
+    float radius = 0.0f;
+    unsigned int sides = 3;
+
+    bool operator==(const NGonDescriptor& other) const {
+        return radius == other.radius && sides == other.sides;
+    }
+};
+
+// std::monostate representa una forma vaca (ShapeType::EMPTY).
+using ShapeDescriptor = std::variant<std::monostate, CircleDescriptor, RectangleDescriptor, NGonDescriptor>;
+
+// Mximo de puntos de un contorno; los descriptores con ms puntos se limitan a este valor.
+constexpr unsigned int MAX_OUTLINE_POINTS = 128;
+
+/*
+  Estructura ShapeOutline
+  - Puntos del contorno en un arreglo de tamao fijo, para generarlos sin reservar memoria.
+*/
+struct ShapeOutline
+{
+    std::array<sf::Vector2f, MAX_OUTLINE_POINTS> points;
+    unsigned int count = 0;
+};
+
+class ShapeGeometry;
+
+/*
+  Estructura ShapeLodSet
+  - Niveles de detalle precalculados de un crculo: la misma forma teselada con 6 a 64 puntos.
+  - maxPixelRadius[i] es el radio en pantalla hasta el que el nivel i se desva del crculo real
+    menos de LOD_PIXEL_TOLERANCE pxeles (flecha de cada segmento: r * (1 - cos(pi / n))).
+  - selectLevel aplica histresis: un crculo justo en el lmite entre dos niveles no alterna
+    de nivel en cada frame.
+  En motores 3D, los LOD de las mallas se eligen igual, por el tamao proyectado en pantalla.
+*/
+struct ShapeLodSet
+{
+    static constexpr unsigned int LEVEL_COUNT = 8;
+    static constexpr std::array<unsigned int, LEVEL_COUNT> POINT_COUNTS = { 6, 8, 12, 16, 24, 32, 48, 64 };
+    static constexpr float LOD_PIXEL_TOLERANCE = 0.25f;   // Error mximo permitido en pxeles.
+    static constexpr float LOD_HYSTERESIS = 0.15f;        // Margen relativo para cambiar de nivel.
+
+    std::array<const ShapeGeometry*, LEVEL_COUNT> levels{};
+    std::array<float, LEVEL_COUNT> maxPixelRadius{};
+
+    /*
+      Funcin selectLevel.
+      - Devuelve el nivel para un radio proyectado (en pxeles), partiendo del nivel actual.
+      - Sube de nivel solo si el radio supera el lmite del nivel actual en ms de LOD_HYSTERESIS,
+        y baja solo si cabe con ese mismo margen en el nivel inferior.
+    */
+    unsigned int selectLevel(float pixelRadius, unsigned int currentLevel) const;
+
+    // Nivel cuyo nmero de puntos es el primero que alcanza pointCount.
+    static unsigned int levelForPointCount(unsigned int pointCount);
+};
+
+/*
+  Clase ShapeGeometry
+  - Geometra teselada e inmutable de una forma en espacio local: un abanico de tringulos
+    (centro, puntos del contorno y el primer punto repetido para cerrarlo), igual al que
+    construye sf::Shape.
+  - Cada vrtice guarda adems su coordenada de textura normalizada (0..1 dentro de los lmites
+    locales), para que cada instancia solo tenga que escalarla a su textureRect.
+  - Las geometras se comparten: acquire() tesela una vez por descriptor y devuelve siempre la misma.
+    Mil karts con el mismo crculo comparten un solo contorno en memoria.
+  En motores 3D es el patrn flyweight de las mallas: la malla se carga una vez y cada objeto
+  de la escena solo guarda su transformacin y su material.
+*/
+class ShapeGeometry
+{
+public:
+    /*
+      Funcin acquire.
+      - Devuelve la geometra del descriptor, teselndola solo la primera vez.
+      - El puntero es vlido durante toda la ejecucin (la cach nunca libera geometras).
+      - Devuelve nullptr para una forma vaca (std::monostate).
+    */
+    static const ShapeGeometry* acquire(const ShapeDescriptor& descriptor);
+
+    /*
+      Funcin acquireLods.
+      - Devuelve los niveles de detalle de un crculo (solo depende de su radio), teselando
+        todos los niveles la primera vez. El puntero es vlido durante toda la ejecucin.
+    */
+    static const ShapeLodSet* acquireLods(const CircleDescriptor& circle);
+
+    // Nmero de geometras distintas en la cach.
+    static size_t getCachedCount();
+
+    // Posiciones locales de los vrtices del abanico.
+    const std::vector<sf::Vector2f>& getPositions() const { return m_positions; }
+
+    // Coordenadas de textura normalizadas (0..1) de cada vrtice.
+    const std::vector<sf::Vector2f>& getTexCoords() const { return m_texCoords; }
+
+    // Lmites locales de la forma.
+    const sf::FloatRect& getLocalBounds() const { return m_bounds; }
+
+    const ShapeDescriptor& getDescriptor() const { return m_descriptor; }
+
+    /*
+      Funcin buildOutline.
+      - Genera el contorno de un descriptor. La sobrecarga que recibe el variant usa std::visit,
+        que en tiempo de ejecucin salta a la sobrecarga concreta segn el ndice del variant:
+        un solo salto por contorno en lugar de una llamada virtual por punto como en sf::Shape::getPoint.
+    */
+    static void buildOutline(const ShapeDescriptor& descriptor, ShapeOutline& outline);
+    static void buildOutline(const std::monostate&, ShapeOutline& outline);
+    static void buildOutline(const CircleDescriptor& circle, ShapeOutline& outline);
+    static void buildOutline(const RectangleDescriptor& rectangle, ShapeOutline& outline);
+    static void buildOutline(const NGonDescriptor& polygon, ShapeOutline& outline);
+
+    // Nmero de vrtices del abanico.
+    size_t getVertexCount() const { return m_positions.size(); }
+
+    // Bytes que ocupa la geometra (vrtices y coordenadas de textura).
+    size_t getMemoryUsage() const;
+
+private:
+    explicit ShapeGeometry(const ShapeDescriptor& descriptor);
+
+    // Puntos de un polgono regular con las frmulas de sf::CircleShape.
+    static void buildRegularPolygon(float radius, unsigned int pointCount, ShapeOutline& outline);
+
+    struct DescriptorHash
+    {
+        size_t operator()(const ShapeDescriptor& descriptor) const;
+    };
+
+    ShapeDescriptor m_descriptor;
+    std::vector<sf::Vector2f> m_positions;
+    std::vector<sf::Vector2f> m_texCoords;
+    sf::FloatRect m_bounds;
+
+    static std::mutex s_mutex;   // Protege la cach (acquire puede llamarse desde cualquier hilo).
+    static std::unordered_map<ShapeDescriptor, EngineUtilities::TSharedPointer<ShapeGeometry>, DescriptorHash> s_cache;
+    static std::unordered_map<float, EngineUtilities::TSharedPointer<ShapeLodSet>> s_lodCache;   // Radio -> niveles.
+};
@@ -0,0 +1,126 @@
+#include "StaticGeometry.h"
+
+// Agrega un actor y lo marca como esttico.
+void StaticGeometry::add(const EngineUtilities::TSharedPointer<Actor>& actor) {
+    if (actor.isNull()) {
+        return;
+    }
+    actor->setStatic(true);
+    m_actors.push_back(actor);
+    m_dirty = true;
+}
+
+// Devuelve los actores a la pasada dinmica y libera los lotes.
+void StaticGeometry::clear() {
+    for (auto& actor : m_actors) {
+        actor->setStatic(false);
+    }
+    m_actors.clear();
+    m_batches.clear();
+    m_vertexCount = 0;
+    m_dirty = false;
+}
+
+// Marca los lotes como desactualizados.
+void StaticGeometry::invalidate() {
+    m_dirty = true;
+}
+
+/*
+   Dibuja los lotes con la textura de cada uno; la transformacin ya est aplicada a los vrtices.
+*/
+void StaticGeometry::draw(Window& window) {
+    if (m_dirty) {
+        bake();
+    }
+
+    const uint16_t previousLayer = window.getRenderLayer();
+    window.setRenderLayer(LAYER_STATIC);
+    for (const Batch& batch : m_batches) {
+        sf::RenderStates states;
+        states.texture = batch.texture;
+        if (m_useVertexBuffer) {
+            window.draw(batch.buffer, states, &batch.vertices);  // La copia en CPU permite capturar el frame.
+        }
+        else {
+            window.draw(batch.vertices, states);
+        }
+    }
+    window.setRenderLayer(previousLayer);
+}
+
+// Nmero de lotes.
+size_t StaticGeometry::getBatchCount() const {
+    return m_batches.size();
+}
+
+// Nmero de vrtices horneados.
+size_t StaticGeometry::getVertexCount() const {
+    return m_vertexCount;
+}
+
+// Indica si se usan vertex buffers.
+bool StaticGeometry::isUsingVertexBuffer() const {
+    return m_useVertexBuffer;
+}
+
+/*
+   Hornea los actores. Cada forma se compone con su color y textureRect, su abanico se convierte
+   en tringulos sueltos (para poder unir varias formas en un lote) y se transforma al mundo
+   con el Transform del actor.
+*/
+void StaticGeometry::bake() {
+    m_dirty = false;
+    m_batches.clear();
+    m_vertexCount = 0;
+    m_useVertexBuffer = sf::VertexBuffer::isAvailable();
+
+    std::vector<sf::Vertex> fan;
+    for (auto& actor : m_actors) {
+        auto shape = actor->getComponent<ShapeFactory>();
+        auto transform = actor->getComponent<Transform>();
+        if (!shape || !transform || shape->getGeometry() == nullptr) {
+            continue;
+        }
+
+        shape->setPosition(transform->getPosition());
+        shape->setRotation(transform->getRotation());
+        shape->setScale(transform->getScale());
+        shape->buildVertices(fan);
+        if (fan.size() < 3) {
+            continue;
+        }
+
+        const sf::Texture* texture = shape->getInstance().texture;
+        if (m_batches.empty() || m_batches.back().texture != texture) {
+            m_batches.emplace_back();
+            m_batches.back().texture = texture;
+            m_batches.back().vertices.setPrimitiveType(sf::Triangles);
+        }
+
+        const sf::Transform world = shape->getTransform();
+        sf::VertexArray& vertices = m_batches.back().vertices;
+        for (size_t i = 1; i + 1 < fan.size(); ++i) {
+            for (size_t index : { size_t(0), i, i + 1 }) {
+                sf::Vertex vertex = fan[index];
+                vertex.position = world.transformPoint(vertex.position);
+                vertices.append(vertex);
+            }
+        }
+    }
+
+    for (Batch& batch : m_batches) {
+        const size_t count = batch.vertices.getVertexCount();
+        m_vertexCount += count;
+
+        // Si la subida a la GPU falla, toda la pasada usa los arreglos del CPU.
+        if (m_useVertexBuffer) {
+            batch.buffer.setPrimitiveType(sf::Triangles);
+            batch.buffer.setUsage(sf::VertexBuffer::Static);
+            if (!batch.buffer.create(count) || !batch.buffer.update(&batch.vertices[0])) {
+                LOG_WARN("StaticGeometry", "bake", "no se pudo crear el vertex buffer, se usa un VertexArray");
+                m_useVertexBuffer = false;
+            }
+        }
+    }
+}
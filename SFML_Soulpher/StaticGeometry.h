@@ -0,0 +1,71 @@
+#pragma once
+#include "Prerequisites.h"
+#include "Actor.h"
+
+/*
+  Clase StaticGeometry
+  - Pasada de geometra esttica: los actores que no se mueven (como la pista) se hornean una sola vez
+    en espacio del mundo dentro de sf::VertexBuffer con uso sf::VertexBuffer::Static, que quedan en la GPU.
+  - Los actores consecutivos con la misma textura comparten un lote (una sola llamada de dibujo).
+  - Los actores agregados se marcan como estticos, por lo que Actor::update los omite y la aplicacin
+    no debe dibujarlos en la pasada dinmica.
+  - Si el hardware no soporta vertex buffers se usa un sf::VertexArray en memoria del CPU.
+  - Si cambia algo que afecta a los vrtices (textura, textureRect, color o Transform), hay que llamar a invalidate().
+  En motores 3D, la geometra esttica del nivel se combina ("static batching") al cargar la escena,
+  y solo los objetos dinmicos pagan la transformacin y el envo de vrtices en cada frame.
+*/
+class StaticGeometry
+{
+public:
+    StaticGeometry() = default;
+    ~StaticGeometry() = default;
+
+    /*
+      Funcin add.
+      - Agrega un actor a la pasada esttica y lo marca como esttico.
+      - El actor se hornea con su Transform actual la prxima vez que se dibuje la pasada.
+    */
+    void add(const EngineUtilities::TSharedPointer<Actor>& actor);
+
+    // Quita todos los actores (que vuelven a ser dinmicos) y libera los lotes.
+    void clear();
+
+    // Fuerza a volver a hornear los lotes antes del prximo dibujo.
+    void invalidate();
+
+    /*
+      Funcin draw.
+      - Dibuja todos los lotes. Si la geometra cambi, primero la vuelve a hornear.
+    */
+    void draw(Window& window);
+
+    // Nmero de lotes (llamadas de dibujo) de la pasada.
+    size_t getBatchCount() const;
+
+    // Nmero total de vrtices horneados.
+    size_t getVertexCount() const;
+
+    // Indica si los lotes viven en la GPU (sf::VertexBuffer) o en un sf::VertexArray.
+    bool isUsingVertexBuffer() const;
+
+private:
+    // Recalcula los lotes a partir de los actores.
+    void bake();
+
+    /*
+      Estructura Batch.
+      - Tringulos en espacio del mundo de uno o ms actores que comparten textura.
+    */
+    struct Batch
+    {
+        const sf::Texture* texture = nullptr;
+        sf::VertexBuffer buffer;     // Copia en la GPU (si est disponible).
+        sf::VertexArray vertices;    // Alternativa en memoria del CPU.
+    };
+
+    std::vector<EngineUtilities::TSharedPointer<Actor>> m_actors;
+    std::vector<Batch> m_batches;
+    size_t m_vertexCount = 0;
+    bool m_useVertexBuffer = false;
+    bool m_dirty = false;
+};
@@ -0,0 +1,101 @@
+#include "ThreadPool.h"
+#include "Profiler.h"
+
+/*
+   Constructor.
+   Crea los hilos de trabajo. Cada hilo espera en la variable de condicin hasta que haya tareas.
+*/
+ThreadPool::ThreadPool(unsigned int threadCount, const std::string& name)
+    : m_name(name) {
+    if (threadCount == 0) {
+        const unsigned int cores = std::thread::hardware_concurrency();
+        threadCount = cores > 1 ? cores - 1 : 1;
+    }
+
+    m_workers.reserve(threadCount);
+    for (unsigned int i = 0; i < threadCount; ++i) {
+        m_workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+/*
+   Destructor.
+   Las tareas que no empezaron se descartan; las que estn en curso terminan normalmente.
+*/
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+        m_tasks.clear();
+    }
+    m_taskReady.notify_all();
+
+    for (auto& worker : m_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+// Encola una tarea y despierta a un hilo de trabajo.
+void ThreadPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stopping) {
+            return;
+        }
+        m_tasks.push_back(std::move(task));
+    }
+    m_taskReady.notify_one();
+}
+
+// Espera a que no queden tareas pendientes ni en ejecucin.
+void ThreadPool::waitIdle() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this]() { return m_tasks.empty() && m_active == 0; });
+}
+
+// Nmero de hilos de trabajo.
+unsigned int ThreadPool::getThreadCount() const {
+    return static_cast<unsigned int>(m_workers.size());
+}
+
+// Tareas en cola ms tareas en ejecucin.
+size_t ThreadPool::getPendingCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_tasks.size() + m_active;
+}
+
+/*
+   Bucle de cada hilo: toma la siguiente tarea de la cola, la ejecuta fuera del candado
+   y avisa cuando el pool queda sin trabajo.
+*/
+void ThreadPool::workerLoop(unsigned int index) {
+    PROFILE_THREAD(m_name + " " + std::to_string(index));
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_taskReady.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+            if (m_stopping) {
+                return;
+            }
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+            ++m_active;
+        }
+
+        {
+            PROFILE_SCOPE("ThreadPool::task");
+            task();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_active;
+            if (m_tasks.empty() && m_active == 0) {
+                m_idle.notify_all();
+            }
+        }
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include "Prerequisites.h"
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+
+/*
+  Clase ThreadPool
+  - Conjunto fijo de hilos de trabajo que ejecutan tareas (std::function) en segundo plano.
+  - Las tareas se encolan con submit() y se ejecutan en el orden en que llegaron.
+  - Las tareas NO deben tocar recursos de OpenGL (sf::Texture, sf::RenderWindow), ya que el
+    contexto grfico pertenece al hilo principal.
+  En motores 3D, un pool de hilos se usa para leer archivos, decodificar imgenes o calcular
+  datos de la escena sin detener el bucle de renderizado.
+*/
+class ThreadPool
+{
+public:
+    /*
+      Constructor parametrizado.
+      - threadCount: nmero de hilos. Si es 0 se usa el nmero de ncleos menos uno
+        (dejando un ncleo libre para el hilo principal), con un mnimo de uno.
+      - name: prefijo del nombre de los hilos en el profiler ("Worker 0", "Loader 1", ...).
+    */
+    explicit ThreadPool(unsigned int threadCount = 0, const std::string& name = "Worker");
+
+    /*
+      Destructor.
+      - Descarta las tareas pendientes, espera a que terminen las que estn en ejecucin
+        y une (join) todos los hilos.
+    */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Encola una tarea para ejecutarse en algn hilo de trabajo.
+    void submit(std::function<void()> task);
+
+    // Bloquea hasta que la cola est vaca y ningn hilo est ejecutando tareas.
+    void waitIdle();
+
+    // Nmero de hilos de trabajo.
+    unsigned int getThreadCount() const;
+
+    // Nmero de tareas en cola o en ejecucin.
+    size_t getPendingCount() const;
+
+private:
+    // Bucle principal de cada hilo de trabajo (index se usa para nombrarlo en el profiler).
+    void workerLoop(unsigned int index);
+
+    std::vector<std::thread> m_workers;          // Hilos de trabajo.
+    std::string m_name;                          // Prefijo del nombre de los hilos.
+    std::deque<std::function<void()>> m_tasks;   // Cola de tareas pendientes.
+    mutable std::mutex m_mutex;                  // Protege la cola y los contadores.
+    std::condition_variable m_taskReady;         // Aviso de nueva tarea o de cierre.
+    std::condition_variable m_idle;              // Aviso de que el pool qued sin trabajo.
+    size_t m_active = 0;                         // Tareas en ejecucin.
+    bool m_stopping = false;                     // Indica que el pool se est destruyendo.
+};
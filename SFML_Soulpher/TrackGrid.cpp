@@ -0,0 +1,180 @@
+#include "TrackGrid.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // Radio en pxeles del parche que se lee debajo de cada muestra de asfalto.
+    constexpr int SAMPLE_PATCH = 1;
+
+    int colorDistanceSquared(const sf::Color& a, const sf::Color& b) {
+        const int r = static_cast<int>(a.r) - b.r;
+        const int g = static_cast<int>(a.g) - b.g;
+        const int bl = static_cast<int>(a.b) - b.b;
+        return r * r + g * g + bl * bl;
+    }
+}
+
+/*
+   1. Rene la paleta del asfalto: los colores de un parche de 3x3 pxeles debajo de cada muestra.
+   2. Marca cada pxel de la imagen como asfalto si est a menos de colorTolerance de la paleta.
+   3. Cada celda cubre un rectngulo de pxeles; es transitable si la fraccin de asfalto llega
+      a drivableFraction. Las celdas de las muestras se marcan siempre.
+*/
+bool TrackGrid::build(const sf::Image& image, const sf::FloatRect& worldBounds,
+    const std::vector<sf::Vector2f>& roadSamples, const Options& options) {
+    const sf::Vector2u imageSize = image.getSize();
+    if (imageSize.x == 0 || imageSize.y == 0 || roadSamples.empty()
+        || worldBounds.width <= 0.0f || worldBounds.height <= 0.0f || options.cellSize <= 0.0f) {
+        LOG_ERROR("TrackGrid", "build", "imagen vacia, sin muestras de asfalto o rectangulo no valido");
+        return false;
+    }
+
+    const float pixelsPerUnitX = imageSize.x / worldBounds.width;
+    const float pixelsPerUnitY = imageSize.y / worldBounds.height;
+    auto toPixel = [&](const sf::Vector2f& position) {
+        const int x = static_cast<int>((position.x - worldBounds.left) * pixelsPerUnitX);
+        const int y = static_cast<int>((position.y - worldBounds.top) * pixelsPerUnitY);
+        return sf::Vector2i(std::clamp(x, 0, static_cast<int>(imageSize.x) - 1),
+            std::clamp(y, 0, static_cast<int>(imageSize.y) - 1));
+    };
+
+    std::vector<sf::Color> palette;
+    for (const sf::Vector2f& sample : roadSamples) {
+        const sf::Vector2i center = toPixel(sample);
+        for (int dy = -SAMPLE_PATCH; dy <= SAMPLE_PATCH; ++dy) {
+            for (int dx = -SAMPLE_PATCH; dx <= SAMPLE_PATCH; ++dx) {
+                const int x = std::clamp(center.x + dx, 0, static_cast<int>(imageSize.x) - 1);
+                const int y = std::clamp(center.y + dy, 0, static_cast<int>(imageSize.y) - 1);
+                const sf::Color color = image.getPixel(x, y);
+                if (std::find(palette.begin(), palette.end(), color) == palette.end()) {
+                    palette.push_back(color);
+                }
+            }
+        }
+    }
+
+    const int toleranceSquared = static_cast<int>(options.colorTolerance * options.colorTolerance);
+    std::vector<uint8_t> road(static_cast<size_t>(imageSize.x) * imageSize.y);
+    const uint8_t* pixels = image.getPixelsPtr();
+    for (size_t i = 0; i < road.size(); ++i) {
+        const sf::Color color(pixels[i * 4], pixels[i * 4 + 1], pixels[i * 4 + 2]);
+        for (const sf::Color& asphalt : palette) {
+            if (colorDistanceSquared(color, asphalt) <= toleranceSquared) {
+                road[i] = 1;
+                break;
+            }
+        }
+    }
+
+    const int columns = std::max(1, static_cast<int>(std::ceil(worldBounds.width / options.cellSize)));
+    const int rows = std::max(1, static_cast<int>(std::ceil(worldBounds.height / options.cellSize)));
+    std::vector<uint8_t> cells(static_cast<size_t>(columns) * rows);
+    for (int row = 0; row < rows; ++row) {
+        const int y0 = std::min(static_cast<int>(row * options.cellSize * pixelsPerUnitY), static_cast<int>(imageSize.y) - 1);
+        const int y1 = std::clamp(static_cast<int>((row + 1) * options.cellSize * pixelsPerUnitY), y0 + 1, static_cast<int>(imageSize.y));
+        for (int column = 0; column < columns; ++column) {
+            const int x0 = std::min(static_cast<int>(column * options.cellSize * pixelsPerUnitX), static_cast<int>(imageSize.x) - 1);
+            const int x1 = std::clamp(static_cast<int>((column + 1) * options.cellSize * pixelsPerUnitX), x0 + 1, static_cast<int>(imageSize.x));
+
+            int asphalt = 0;
+            for (int y = y0; y < y1; ++y) {
+                for (int x = x0; x < x1; ++x) {
+                    asphalt += road[static_cast<size_t>(y) * imageSize.x + x];
+                }
+            }
+            const int total = (x1 - x0) * (y1 - y0);
+            cells[static_cast<size_t>(row) * columns + column] = asphalt >= options.drivableFraction * total ? 1 : 0;
+        }
+    }
+
+    if (!assign(columns, rows, options.cellSize, sf::Vector2f(worldBounds.left, worldBounds.top), std::move(cells))) {
+        return false;
+    }
+    for (const sf::Vector2f& sample : roadSamples) {
+        m_cells[indexAt(sample)] = 1;
+    }
+    return true;
+}
+
+bool TrackGrid::assign(int columns, int rows, float cellSize, const sf::Vector2f& origin, std::vector<uint8_t> drivable) {
+    if (columns <= 0 || rows <= 0 || cellSize <= 0.0f || drivable.size() != static_cast<size_t>(columns) * rows) {
+        LOG_ERROR("TrackGrid", "assign", "dimensiones no validas ({}x{}, {} celdas)", columns, rows, drivable.size());
+        return false;
+    }
+    m_columns = columns;
+    m_rows = rows;
+    m_cellSize = cellSize;
+    m_origin = origin;
+    m_cells = std::move(drivable);
+    return true;
+}
+
+bool TrackGrid::isValid() const {
+    return !m_cells.empty();
+}
+
+int TrackGrid::getColumns() const {
+    return m_columns;
+}
+
+int TrackGrid::getRows() const {
+    return m_rows;
+}
+
+size_t TrackGrid::getCellCount() const {
+    return m_cells.size();
+}
+
+float TrackGrid::getCellSize() const {
+    return m_cellSize;
+}
+
+const sf::Vector2f& TrackGrid::getOrigin() const {
+    return m_origin;
+}
+
+float TrackGrid::getDrivableRatio() const {
+    if (m_cells.empty()) {
+        return 0.0f;
+    }
+    const size_t drivable = static_cast<size_t>(std::count(m_cells.begin(), m_cells.end(), uint8_t(1)));
+    return static_cast<float>(drivable) / m_cells.size();
+}
+
+bool TrackGrid::contains(int column, int row) const {
+    return column >= 0 && row >= 0 && column < m_columns && row < m_rows;
+}
+
+size_t TrackGrid::toIndex(int column, int row) const {
+    return static_cast<size_t>(row) * m_columns + column;
+}
+
+sf::Vector2i TrackGrid::toCell(const sf::Vector2f& position) const {
+    const int column = static_cast<int>(std::floor((position.x - m_origin.x) / m_cellSize));
+    const int row = static_cast<int>(std::floor((position.y - m_origin.y) / m_cellSize));
+    return sf::Vector2i(std::clamp(column, 0, m_columns - 1), std::clamp(row, 0, m_rows - 1));
+}
+
+size_t TrackGrid::indexAt(const sf::Vector2f& position) const {
+    const sf::Vector2i cell = toCell(position);
+    return toIndex(cell.x, cell.y);
+}
+
+sf::Vector2f TrackGrid::getCellCenter(size_t index) const {
+    const int column = static_cast<int>(index % m_columns);
+    const int row = static_cast<int>(index / m_columns);
+    return m_origin + sf::Vector2f((column + 0.5f) * m_cellSize, (row + 0.5f) * m_cellSize);
+}
+
+bool TrackGrid::isDrivable(size_t index) const {
+    return m_cells[index] != 0;
+}
+
+bool TrackGrid::isDrivable(const sf::Vector2f& position) const {
+    return isValid() && m_cells[indexAt(position)] != 0;
+}
+
+const std::vector<uint8_t>& TrackGrid::getCells() const {
+    return m_cells;
+}
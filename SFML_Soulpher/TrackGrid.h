@@ -0,0 +1,86 @@
+#pragma once
+#include "Prerequisites.h"
+#include <cstdint>
+
+/*
+  Clase TrackGrid
+  - Rejilla de celdas cuadradas sobre el rectngulo del circuito, con una marca por celda:
+    se puede conducir por ella (asfalto) o no (pasto, muros, agua).
+  - Se construye a partir de la imagen de la pista (Circuit.png) estirada sobre worldBounds, igual
+    que la dibuja el actor Track. El color del asfalto no est fijo: se toma de la imagen debajo de
+    puntos que se sabe que estn sobre la pista (los waypoints), y un pxel es de asfalto si su color
+    se parece a alguno de esos.
+  - La usan FlowField (un campo de direcciones por checkpoint) y la bsqueda de caminos.
+  En motores 3D, esta es la "navmesh" ms simple: una discretizacin del terreno transitable
+  calculada una vez fuera del juego a partir de los datos del nivel.
+*/
+class TrackGrid
+{
+public:
+    /*
+      Estructura Options.
+      - Parmetros de la clasificacin de la imagen.
+    */
+    struct Options
+    {
+        float cellSize = 8.0f;          // Lado de una celda en unidades del mundo.
+        float colorTolerance = 40.0f;   // Distancia RGB mxima a un color de asfalto.
+        float drivableFraction = 0.5f;  // Fraccin de pxeles de asfalto para que la celda sea transitable.
+    };
+
+    /*
+      Funcin build.
+      - Clasifica image, estirada sobre worldBounds, en celdas de options.cellSize.
+      - roadSamples son posiciones del mundo que estn sobre la pista; sus celdas siempre quedan
+        transitables. Devuelve false si la imagen est vaca o no hay muestras.
+    */
+    bool build(const sf::Image& image, const sf::FloatRect& worldBounds,
+        const std::vector<sf::Vector2f>& roadSamples, const Options& options);
+
+    /*
+      Funcin assign.
+      - Reemplaza la rejilla por una ya calculada (por ejemplo, leda de un archivo).
+        drivable debe tener columns * rows elementos (0 = no transitable).
+    */
+    bool assign(int columns, int rows, float cellSize, const sf::Vector2f& origin, std::vector<uint8_t> drivable);
+
+    // Indica si la rejilla tiene celdas.
+    bool isValid() const;
+
+    int getColumns() const;
+    int getRows() const;
+    size_t getCellCount() const;
+    float getCellSize() const;
+    const sf::Vector2f& getOrigin() const;
+
+    // Fraccin de celdas transitables.
+    float getDrivableRatio() const;
+
+    // Indica si la celda (column, row) est dentro de la rejilla.
+    bool contains(int column, int row) const;
+
+    // ndice de la celda (column, row), que debe estar dentro de la rejilla.
+    size_t toIndex(int column, int row) const;
+
+    // Columna y fila de la celda que contiene position, ajustadas a los bordes de la rejilla.
+    sf::Vector2i toCell(const sf::Vector2f& position) const;
+
+    // ndice de la celda que contiene position (ajustada a los bordes).
+    size_t indexAt(const sf::Vector2f& position) const;
+
+    // Centro de la celda en unidades del mundo.
+    sf::Vector2f getCellCenter(size_t index) const;
+
+    bool isDrivable(size_t index) const;
+    bool isDrivable(const sf::Vector2f& position) const;
+
+    // Marca por celda (1 = transitable), fila por fila.
+    const std::vector<uint8_t>& getCells() const;
+
+private:
+    int m_columns = 0;
+    int m_rows = 0;
+    float m_cellSize = 8.0f;
+    sf::Vector2f m_origin;
+    std::vector<uint8_t> m_cells;
+};
@@ -2,6 +2,7 @@
 #include "Prerequisites.h"
 #include "Component.h"
 #include "Window.h"
+#include <cmath>
 
 /*
    Transform.h
@@ -13,11 +14,13 @@ class Transform : public Component
 public:
     // Constructor por defecto que inicializa la posicin, rotacin y escala a valores por defecto.
     Transform()
-        : position(0.0f, 0.0f), rotation(0.0f), scale(1.0f, 1.0f), Component(ComponentType::TRANSFORM) {}
+        : position(0.0f, 0.0f), rotation(0.0f), scale(1.0f, 1.0f), Component(ComponentType::TRANSFORM),
+          previousPosition(position), previousRotation(rotation), previousScale(scale) {}
 
     // Constructor con parmetros que permite inicializar las propiedades de transformacin.
     Transform(const sf::Vector2f& position, float rotation = 0.0f, const sf::Vector2f& scale = sf::Vector2f(1.0f, 1.0f))
-        : position(position), rotation(rotation), scale(scale), Component(ComponentType::TRANSFORM) {}
+        : position(position), rotation(rotation), scale(scale), Component(ComponentType::TRANSFORM),
+          previousPosition(position), previousRotation(rotation), previousScale(scale) {}
 
     // Destructor por defecto. No requiere liberacin de recursos especiales.
     virtual ~Transform() = default;
@@ -58,6 +61,48 @@ public:
         return scale;
     }
 
+    /*
+       Guarda el estado actual como estado anterior.
+       Con un paso de simulacin fijo se llama al inicio de cada tick, antes de mover la entidad,
+       para poder interpolar entre los dos ltimos ticks al renderizar.
+    */
+    void savePreviousState() {
+        previousPosition = position;
+        previousRotation = rotation;
+        previousScale = scale;
+    }
+
+    /*
+       Devuelve la posicin interpolada entre el tick anterior y el actual.
+        - alpha = fraccin del siguiente tick ya transcurrida (0 = tick anterior, 1 = tick actual).
+    */
+    sf::Vector2f getInterpolatedPosition(float alpha) const {
+        return previousPosition + (position - previousPosition) * alpha;
+    }
+
+    // Devuelve la rotacin interpolada por el camino ms corto (de 350 a 10 grados pasa por 0).
+    float getInterpolatedRotation(float alpha) const {
+        return lerpAngle(previousRotation, rotation, alpha);
+    }
+
+    // Devuelve la escala interpolada.
+    sf::Vector2f getInterpolatedScale(float alpha) const {
+        return previousScale + (scale - previousScale) * alpha;
+    }
+
+    // Estado del tick anterior.
+    const sf::Vector2f& getPreviousPosition() const { return previousPosition; }
+    float getPreviousRotation() const { return previousRotation; }
+    const sf::Vector2f& getPreviousScale() const { return previousScale; }
+
+    // Interpola dos ngulos en grados por el camino ms corto.
+    static float lerpAngle(float from, float to, float alpha) {
+        float delta = std::fmod(to - from, 360.0f);
+        if (delta > 180.0f) delta -= 360.0f;
+        if (delta < -180.0f) delta += 360.0f;
+        return from + delta * alpha;
+    }
+
     /*
        Para mover la entidad hacia un objetivo con una velocidad especfica.
         - targetPosition = La posicin objetivo hacia la que se mover.
@@ -88,4 +133,9 @@ private:
     sf::Vector2f position;  // Posicin del actor.
     float rotation;         // Rotacin del actor en grados.
     sf::Vector2f scale;     // Escala del actor en los ejes X e Y.
+
+    // Estado del tick anterior, para interpolar al renderizar.
+    sf::Vector2f previousPosition;
+    float previousRotation;
+    sf::Vector2f previousScale;
 };
\ No newline at end of file
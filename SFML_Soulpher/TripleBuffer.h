@@ -0,0 +1,64 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+/*
+  Clase TripleBuffer
+  - Comunica un productor y un consumidor (dos hilos) sin candados y sin que ninguno espere al otro.
+  - Hay tres copias de T: el productor escribe en una, el consumidor lee otra y la tercera ("central")
+    guarda el ltimo estado publicado. Publicar y consumir son un solo intercambio atmico de ndices.
+  - El consumidor siempre obtiene el estado completo ms reciente; si el productor publica varias veces
+    entre dos lecturas, los estados intermedios se descartan (lo deseable para dibujar).
+  - Solo es vlido con exactamente un hilo productor y un hilo consumidor.
+  En motores 3D es la forma clsica de pasar el estado de la simulacin al hilo de render:
+  la simulacin nunca espera a que termine el frame y el render nunca ve un estado a medio escribir.
+*/
+template<typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer() = default;
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    /*
+      Funcin getWriteBuffer.
+      - (Productor) Copia en la que se prepara el siguiente estado. Puede contener un estado antiguo,
+        por lo que hay que escribirla completa antes de publicar.
+    */
+    T& getWriteBuffer() { return m_buffers[m_write]; }
+
+    /*
+      Funcin publish.
+      - (Productor) Publica la copia de escritura y toma la central para el siguiente estado.
+    */
+    void publish() {
+        m_write = m_middle.exchange(static_cast<uint8_t>(m_write | DIRTY), std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    /*
+      Funcin fetch.
+      - (Consumidor) Si hay un estado nuevo, lo intercambia por la copia de lectura y devuelve true.
+        Si no, la copia de lectura conserva el ltimo estado y devuelve false.
+    */
+    bool fetch() {
+        if ((m_middle.load(std::memory_order_acquire) & DIRTY) == 0) {
+            return false;
+        }
+        m_read = m_middle.exchange(m_read, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+
+    // (Consumidor) ltimo estado obtenido con fetch().
+    const T& getReadBuffer() const { return m_buffers[m_read]; }
+
+private:
+    static constexpr uint8_t INDEX_MASK = 0x3;   // ndice de la copia (0, 1 o 2).
+    static constexpr uint8_t DIRTY = 0x4;        // La copia central tiene un estado que el consumidor no ha ledo.
+
+    T m_buffers[3];
+    uint8_t m_write = 0;                   // Solo lo usa el productor.
+    uint8_t m_read = 1;                    // Solo lo usa el consumidor.
+    std::atomic<uint8_t> m_middle{ 2 };    // Compartido: ndice central + DIRTY.
+};
@@ -0,0 +1,314 @@
+#include "WaypointFollower.h"
+#include "Profiler.h"
+#include "FlowField.h"
+#include <algorithm>
+#include <cmath>
+
+// Los kernels SIMD solo se compilan en x64, donde SSE2 siempre est disponible.
+#if defined(_M_X64) || defined(__x86_64__)
+#define SOULPHER_SIMD_X64 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define SOULPHER_TARGET_AVX2
+#else
+#define SOULPHER_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace
+{
+    // Arreglos que recorren los kernels.
+    struct StepData
+    {
+        float* x;
+        float* y;
+        float* previousX;
+        float* previousY;
+        const float* speed;
+        int32_t* waypoint;
+        const float* waypointX;
+        const float* waypointY;
+        int32_t waypointCount;
+        float radiusSquared;
+        float deltaTime;
+    };
+
+    /*
+       Kernel escalar (y cola de los kernels SIMD). El orden de las operaciones es el mismo que en
+       los kernels SIMD: paso = (velocidad * dt) / distancia, y el paso se anula al llegar.
+    */
+    void stepScalar(const StepData& data, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const float x = data.x[i];
+            const float y = data.y[i];
+            data.previousX[i] = x;
+            data.previousY[i] = y;
+
+            int32_t waypoint = data.waypoint[i];
+            const float dx = data.waypointX[waypoint] - x;
+            const float dy = data.waypointY[waypoint] - y;
+            const float distanceSquared = dx * dx + dy * dy;
+            const bool reached = distanceSquared < data.radiusSquared;
+
+            const float step = reached ? 0.0f : (data.speed[i] * data.deltaTime) / std::sqrt(distanceSquared);
+            data.x[i] = x + dx * step;
+            data.y[i] = y + dy * step;
+
+            waypoint += reached ? 1 : 0;
+            waypoint -= waypoint >= data.waypointCount ? data.waypointCount : 0;
+            data.waypoint[i] = waypoint;
+        }
+    }
+
+#ifdef SOULPHER_SIMD_X64
+    /*
+       SSE2: 4 karts por iteracin. SSE2 no tiene "gather", as que las coordenadas del waypoint de
+       cada kart se leen una por una; la ruta es pequea y siempre est en la cach L1.
+       La comparacin devuelve -1 (todos los bits en 1) en los karts que llegaron: restarla al ndice
+       suma 1, y la misma mscara anula el paso con andnot.
+    */
+    size_t stepSse2(const StepData& data, size_t count) {
+        const __m128 radiusSquared = _mm_set1_ps(data.radiusSquared);
+        const __m128 deltaTime = _mm_set1_ps(data.deltaTime);
+        const __m128i waypointCount = _mm_set1_epi32(data.waypointCount);
+        const __m128i lastWaypoint = _mm_set1_epi32(data.waypointCount - 1);
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            const __m128 x = _mm_loadu_ps(data.x + i);
+            const __m128 y = _mm_loadu_ps(data.y + i);
+            _mm_storeu_ps(data.previousX + i, x);
+            _mm_storeu_ps(data.previousY + i, y);
+
+            __m128i waypoint = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data.waypoint + i));
+            const int32_t* w = data.waypoint + i;
+            const __m128 targetX = _mm_setr_ps(data.waypointX[w[0]], data.waypointX[w[1]], data.waypointX[w[2]], data.waypointX[w[3]]);
+            const __m128 targetY = _mm_setr_ps(data.waypointY[w[0]], data.waypointY[w[1]], data.waypointY[w[2]], data.waypointY[w[3]]);
+
+            const __m128 dx = _mm_sub_ps(targetX, x);
+            const __m128 dy = _mm_sub_ps(targetY, y);
+            const __m128 distanceSquared = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+            const __m128 reached = _mm_cmplt_ps(distanceSquared, radiusSquared);
+
+            __m128 step = _mm_div_ps(_mm_mul_ps(_mm_loadu_ps(data.speed + i), deltaTime), _mm_sqrt_ps(distanceSquared));
+            step = _mm_andnot_ps(reached, step);
+            _mm_storeu_ps(data.x + i, _mm_add_ps(x, _mm_mul_ps(dx, step)));
+            _mm_storeu_ps(data.y + i, _mm_add_ps(y, _mm_mul_ps(dy, step)));
+
+            waypoint = _mm_sub_epi32(waypoint, _mm_castps_si128(reached));
+            const __m128i wrap = _mm_cmpgt_epi32(waypoint, lastWaypoint);
+            waypoint = _mm_sub_epi32(waypoint, _mm_and_si128(wrap, waypointCount));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(data.waypoint + i), waypoint);
+        }
+        return i;
+    }
+
+    // AVX2: 8 karts por iteracin; las coordenadas del waypoint se leen con gather.
+    SOULPHER_TARGET_AVX2 size_t stepAvx2(const StepData& data, size_t count) {
+        const __m256 radiusSquared = _mm256_set1_ps(data.radiusSquared);
+        const __m256 deltaTime = _mm256_set1_ps(data.deltaTime);
+        const __m256i waypointCount = _mm256_set1_epi32(data.waypointCount);
+        const __m256i lastWaypoint = _mm256_set1_epi32(data.waypointCount - 1);
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const __m256 x = _mm256_loadu_ps(data.x + i);
+            const __m256 y = _mm256_loadu_ps(data.y + i);
+            _mm256_storeu_ps(data.previousX + i, x);
+            _mm256_storeu_ps(data.previousY + i, y);
+
+            __m256i waypoint = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data.waypoint + i));
+            const __m256 targetX = _mm256_i32gather_ps(data.waypointX, waypoint, 4);
+            const __m256 targetY = _mm256_i32gather_ps(data.waypointY, waypoint, 4);
+
+            const __m256 dx = _mm256_sub_ps(targetX, x);
+            const __m256 dy = _mm256_sub_ps(targetY, y);
+            const __m256 distanceSquared = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+            const __m256 reached = _mm256_cmp_ps(distanceSquared, radiusSquared, _CMP_LT_OQ);
+
+            __m256 step = _mm256_div_ps(_mm256_mul_ps(_mm256_loadu_ps(data.speed + i), deltaTime), _mm256_sqrt_ps(distanceSquared));
+            step = _mm256_andnot_ps(reached, step);
+            _mm256_storeu_ps(data.x + i, _mm256_add_ps(x, _mm256_mul_ps(dx, step)));
+            _mm256_storeu_ps(data.y + i, _mm256_add_ps(y, _mm256_mul_ps(dy, step)));
+
+            waypoint = _mm256_sub_epi32(waypoint, _mm256_castps_si256(reached));
+            const __m256i wrap = _mm256_cmpgt_epi32(waypoint, lastWaypoint);
+            waypoint = _mm256_sub_epi32(waypoint, _mm256_and_si256(wrap, waypointCount));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(data.waypoint + i), waypoint);
+        }
+        return i;
+    }
+
+    // AVX2 requiere soporte de la CPU y que el sistema operativo guarde los registros YMM (XSAVE).
+    bool cpuHasAvx2() {
+#ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) {
+            return false;
+        }
+        __cpuid(info, 1);
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        const bool avx = (info[2] & (1 << 28)) != 0;
+        if (!osxsave || !avx || (_xgetbv(0) & 6) != 6) {
+            return false;
+        }
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+#endif
+}
+
+WaypointFollower::WaypointFollower()
+    : m_kernel(getBestKernel()) {
+}
+
+WaypointFollower::Kernel WaypointFollower::getBestKernel() {
+#ifdef SOULPHER_SIMD_X64
+    static const Kernel best = cpuHasAvx2() ? Kernel::AVX2 : Kernel::SSE2;
+    return best;
+#else
+    return Kernel::Scalar;
+#endif
+}
+
+const char* WaypointFollower::getKernelName(Kernel kernel) {
+    switch (kernel) {
+    case Kernel::SSE2: return "sse2";
+    case Kernel::AVX2: return "avx2";
+    default: return "scalar";
+    }
+}
+
+void WaypointFollower::setWaypoints(const std::vector<sf::Vector2f>& waypoints, float radius) {
+    m_waypointX.clear();
+    m_waypointY.clear();
+    for (const sf::Vector2f& waypoint : waypoints) {
+        m_waypointX.push_back(waypoint.x);
+        m_waypointY.push_back(waypoint.y);
+    }
+    m_radius = std::max(radius, 1e-3f);
+}
+
+void WaypointFollower::reserve(size_t count) {
+    m_x.reserve(count);
+    m_y.reserve(count);
+    m_previousX.reserve(count);
+    m_previousY.reserve(count);
+    m_speed.reserve(count);
+    m_waypoint.reserve(count);
+}
+
+// El ndice de waypoint se ajusta a la ruta para que los kernels nunca lean fuera de ella.
+size_t WaypointFollower::add(const sf::Vector2f& position, float speed, uint32_t waypoint) {
+    m_x.push_back(position.x);
+    m_y.push_back(position.y);
+    m_previousX.push_back(position.x);
+    m_previousY.push_back(position.y);
+    m_speed.push_back(speed);
+    m_waypoint.push_back(m_waypointX.empty() ? 0 : static_cast<int32_t>(waypoint % m_waypointX.size()));
+    return m_x.size() - 1;
+}
+
+void WaypointFollower::clear() {
+    m_x.clear();
+    m_y.clear();
+    m_previousX.clear();
+    m_previousY.clear();
+    m_speed.clear();
+    m_waypoint.clear();
+}
+
+bool WaypointFollower::setKernel(Kernel kernel) {
+    if (static_cast<int>(kernel) > static_cast<int>(getBestKernel())) {
+        m_kernel = getBestKernel();
+        return false;
+    }
+    m_kernel = kernel;
+    return true;
+}
+
+WaypointFollower::Kernel WaypointFollower::getKernel() const {
+    return m_kernel;
+}
+
+/*
+   Los kernels SIMD procesan bloques completos de 4 u 8 karts; los que sobran al final
+   los termina el kernel escalar.
+*/
+void WaypointFollower::update(float deltaTime) {
+    PROFILE_SCOPE("WaypointFollower::update");
+    if (m_waypointX.empty() || m_x.empty()) {
+        return;
+    }
+
+    const StepData data{ m_x.data(), m_y.data(), m_previousX.data(), m_previousY.data(), m_speed.data(),
+        m_waypoint.data(), m_waypointX.data(), m_waypointY.data(), static_cast<int32_t>(m_waypointX.size()),
+        m_radius * m_radius, deltaTime };
+
+    size_t done = 0;
+#ifdef SOULPHER_SIMD_X64
+    if (m_kernel == Kernel::AVX2) {
+        done = stepAvx2(data, m_x.size());
+    }
+    else if (m_kernel == Kernel::SSE2) {
+        done = stepSse2(data, m_x.size());
+    }
+#endif
+    stepScalar(data, done, m_x.size());
+}
+
+/*
+   El kart se mueve speed * dt en la direccin del campo (ya normalizada) y, como en update, no se
+   mueve el tick en que alcanza el checkpoint. Los ndices fuera del campo vuelven al checkpoint 0.
+*/
+void WaypointFollower::updateFlowField(const FlowField& field, float deltaTime) {
+    PROFILE_SCOPE("WaypointFollower::updateFlowField");
+    if (!field.isValid() || m_x.empty()) {
+        return;
+    }
+
+    const std::vector<sf::Vector2f>& checkpoints = field.getCheckpoints();
+    const int32_t checkpointCount = static_cast<int32_t>(checkpoints.size());
+    const float radiusSquared = field.getGoalRadius() * field.getGoalRadius();
+    for (size_t i = 0; i < m_x.size(); ++i) {
+        const sf::Vector2f position(m_x[i], m_y[i]);
+        m_previousX[i] = position.x;
+        m_previousY[i] = position.y;
+
+        int32_t checkpoint = m_waypoint[i] < checkpointCount ? m_waypoint[i] : 0;
+        const sf::Vector2f offset = checkpoints[checkpoint] - position;
+        const bool reached = offset.x * offset.x + offset.y * offset.y < radiusSquared;
+
+        const sf::Vector2f direction = field.getDirection(static_cast<size_t>(checkpoint), position);
+        const float step = reached ? 0.0f : m_speed[i] * deltaTime;
+        m_x[i] = position.x + direction.x * step;
+        m_y[i] = position.y + direction.y * step;
+
+        checkpoint += reached ? 1 : 0;
+        checkpoint -= checkpoint >= checkpointCount ? checkpointCount : 0;
+        m_waypoint[i] = checkpoint;
+    }
+}
+
+size_t WaypointFollower::getCount() const {
+    return m_x.size();
+}
+
+sf::Vector2f WaypointFollower::getPosition(size_t index) const {
+    return sf::Vector2f(m_x[index], m_y[index]);
+}
+
+uint32_t WaypointFollower::getWaypoint(size_t index) const {
+    return static_cast<uint32_t>(m_waypoint[index]);
+}
+
+sf::Vector2f WaypointFollower::getInterpolatedPosition(size_t index, float alpha) const {
+    return sf::Vector2f(m_previousX[index] + (m_x[index] - m_previousX[index]) * alpha,
+        m_previousY[index] + (m_y[index] - m_previousY[index]) * alpha);
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include "Prerequisites.h"
+#include <cstdint>
+
+class FlowField;
+
+/*
+  Clase WaypointFollower
+  - Simula muchos karts que recorren en bucle la misma ruta de waypoints, todos a la vez.
+  - Los datos se guardan como estructura de arreglos (SoA): un arreglo de X, otro de Y, otro de
+    velocidades y otro de ndices de waypoint. As un kernel SIMD carga 4 (SSE2) u 8 (AVX2) karts
+    con una sola instruccin por campo.
+  - La regla es la del kart principal (BaseApp::updateMovement): avanzar hacia el waypoint a su
+    velocidad y, al estar a menos de radius, pasar al siguiente sin moverse ese tick. El avance de
+    waypoint se hace sin saltos: con mscaras de comparacin en lugar de if.
+  - El kernel se elige al crear el objeto segn la CPU (AVX2, SSE2 o escalar) y se puede forzar con
+    setKernel; todos siguen el mismo orden de operaciones, as que dan los mismos resultados.
+  En motores 3D, este es el patrn de los sistemas de partculas y de multitudes: datos contiguos por
+  campo y un mismo clculo para miles de elementos, sin objetos ni punteros por elemento.
+*/
+class WaypointFollower
+{
+public:
+    enum class Kernel
+    {
+        Scalar = 0,
+        SSE2 = 1,
+        AVX2 = 2,
+    };
+
+    WaypointFollower();
+
+    // El mejor kernel que soporta la CPU actual.
+    static Kernel getBestKernel();
+
+    // Nombre del kernel ("scalar", "sse2", "avx2").
+    static const char* getKernelName(Kernel kernel);
+
+    /*
+      Funcin setWaypoints.
+      - Ruta en bucle que siguen todos los karts. radius es la distancia a la que un waypoint se
+        da por alcanzado (debe ser mayor que cero).
+    */
+    void setWaypoints(const std::vector<sf::Vector2f>& waypoints, float radius = 10.0f);
+
+    // Reserva memoria para count karts.
+    void reserve(size_t count);
+
+    // Agrega un kart que se dirige al waypoint indicado. Devuelve su ndice.
+    size_t add(const sf::Vector2f& position, float speed, uint32_t waypoint);
+
+    // Elimina todos los karts (la ruta se conserva).
+    void clear();
+
+    /*
+      Funcin setKernel.
+      - Fuerza un kernel. Si la CPU no lo soporta se usa el mejor disponible y devuelve false.
+    */
+    bool setKernel(Kernel kernel);
+    Kernel getKernel() const;
+
+    /*
+      Funcin update.
+      - Avanza todos los karts un tick: guarda la posicin anterior (para interpolar), mueve cada
+        kart hacia su waypoint y avanza el waypoint de los que llegaron.
+    */
+    void update(float deltaTime);
+
+    /*
+      Funcin updateFlowField.
+      - Igual que update, pero la direccin de cada kart es la del campo de su checkpoint en su
+        celda, y el ndice de waypoint es el del checkpoint de field. El checkpoint se da por
+        alcanzado a menos de field.getGoalRadius().
+      - Una lectura de la tabla por kart: no hay kernel SIMD porque la lectura depende de la celda.
+    */
+    void updateFlowField(const FlowField& field, float deltaTime);
+
+    size_t getCount() const;
+    sf::Vector2f getPosition(size_t index) const;
+    uint32_t getWaypoint(size_t index) const;
+
+    // Posicin interpolada entre el tick anterior y el actual (misma regla que Transform).
+    sf::Vector2f getInterpolatedPosition(size_t index, float alpha) const;
+
+private:
+    std::vector<float> m_x;
+    std::vector<float> m_y;
+    std::vector<float> m_previousX;
+    std::vector<float> m_previousY;
+    std::vector<float> m_speed;
+    std::vector<int32_t> m_waypoint;
+
+    std::vector<float> m_waypointX;
+    std::vector<float> m_waypointY;
+    float m_radius = 10.0f;
+
+    Kernel m_kernel;
+};
@@ -1,4 +1,5 @@
 #include "Window.h"
+#include "Profiler.h"
 
 /*
    Constructor parametrizado.
@@ -11,10 +12,10 @@ Window::Window(int width, int height, const std::string& title) {
 
     // Verificar si la ventana se cre correctamente.
     if (!m_window) {
-        ERROR("Window", "Window", "CHECK CONSTRUCTOR");
+        LOG_FATAL("Window", "Window", "CHECK CONSTRUCTOR");
     }
     else {
-        MESSAGE("Window", "Window", "OK");
+        LOG_INFO("Window", "Window", "OK");
     }
 
     // Inicializar ImGui con la ventana de SFML.
@@ -38,10 +39,13 @@ Window::~Window() {
 */
 
 void Window::handleEvents() {
+    PROFILE_SCOPE("Window::handleEvents");
+    m_frameEvents.clear();
     sf::Event event;
     while (m_window->pollEvent(event)) {
         // Procesar los eventos para ImGui.
         ImGui::SFML::ProcessEvent(event);
+        m_frameEvents.push_back(event);
 
         switch (event.type) {
         case sf::Event::Closed:
@@ -63,17 +67,23 @@ void Window::handleEvents() {
     }
 }
 
+// Eventos del ltimo handleEvents.
+const std::vector<sf::Event>& Window::getFrameEvents() const {
+    return m_frameEvents;
+}
+
 /*
    Limpia la ventana para preparar un nuevo frame.
    Borra todo lo que se muestra actualmente en la ventana.
    De otra manera, informa de error.
 */
 void Window::clear() {
+    m_frameStats.beginFrame();
     if (m_window != nullptr) {
         m_window->clear();
     }
     else {
-        ERROR("Window", "clear", "CHECK FOR WINDOW POINTER DATA");
+        LOG_FATAL("Window", "clear", "CHECK FOR WINDOW POINTER DATA");
     }
 }
 
@@ -82,11 +92,27 @@ void Window::clear() {
    Actualiza la ventana con el contenido ms reciente.
 */
 void Window::display() {
+    ++m_frameIndex;
+    const bool wasOverBudget = isOverBudget();
+    m_lastStats = m_frameStats;  // Sin reservas mientras no se registren pases nuevos.
+    if (isOverBudget()) {
+        ++m_overBudgetFrames;
+        if (!wasOverBudget) {
+            LOG_WARN("Window", "display", "el frame {} usa {} llamadas de dibujo (presupuesto {})",
+                m_frameIndex, m_lastStats.getTotal().drawCalls, m_drawCallBudget);
+            for (const RenderPassStats& pass : m_lastStats.getPasses()) {
+                if (pass.counters.drawCalls > 0) {
+                    LOG_WARN("Window", "display", "  pase {}: {} llamadas", pass.name, pass.counters.drawCalls);
+                }
+            }
+        }
+    }
+
     if (m_window != nullptr) {
         m_window->display();
     }
     else {
-        ERROR("Window", "display", "CHECK FOR WINDOW POINTER DATA");
+        LOG_FATAL("Window", "display", "CHECK FOR WINDOW POINTER DATA");
     }
 }
 
@@ -99,7 +125,7 @@ bool Window::isOpen() const {
         return m_window->isOpen();
     }
     else {
-        ERROR("Window", "isOpen", "CHECK FOR WINDOW POINTER DATA");
+        LOG_FATAL("Window", "isOpen", "CHECK FOR WINDOW POINTER DATA");
         return false;
     }
 }
@@ -109,15 +135,135 @@ bool Window::isOpen() const {
   Recibe cualquier objeto que herede de `sf::Drawable` y lo muestra en la ventana.
   drawable El objeto a dibujar (como un crculo o rectngulo).
 */
-void Window::draw(const sf::Drawable& drawable) {
+void Window::draw(const sf::Drawable& drawable, const sf::RenderStates& states, const sf::VertexArray* cpuVertices) {
     if (m_window != nullptr) {
-        m_window->draw(drawable);
+        if (m_deferred) {
+            m_commands.record(drawable, states, m_layer,
+                cpuVertices != nullptr ? cpuVertices : dynamic_cast<const sf::VertexArray*>(&drawable));
+        }
+        else {
+            m_window->draw(drawable, states);
+            m_frameStats.countDrawable(m_pass, drawable, cpuVertices, states);
+        }
     }
     else {
-        ERROR("Window", "draw", "CHECK FOR WINDOW POINTER DATA");
+        LOG_FATAL("Window", "draw", "CHECK FOR WINDOW POINTER DATA");
     }
 }
 
+/*
+  Dibuja un arreglo de vrtices.
+  vertices Los vrtices a dibujar; states La transformacin, textura y mezcla a aplicar.
+*/
+void Window::draw(const sf::Vertex* vertices, size_t vertexCount, sf::PrimitiveType type, const sf::RenderStates& states) {
+    if (m_window != nullptr) {
+        if (m_deferred) {
+            m_commands.record(vertices, vertexCount, type, states, m_layer);
+        }
+        else {
+            m_window->draw(vertices, vertexCount, type, states);
+            m_frameStats.countDraw(m_pass, vertexCount, states.texture, states.blendMode, type);
+        }
+    }
+    else {
+        LOG_FATAL("Window", "draw", "CHECK FOR WINDOW POINTER DATA");
+    }
+}
+
+// Pase de los prximos dibujos.
+void Window::beginPass(const std::string& name) {
+    m_pass = m_frameStats.getPassId(name);
+    m_commands.setPass(m_pass);
+}
+
+// Pase por defecto.
+void Window::endPass() {
+    m_pass = 0;
+    m_commands.setPass(0);
+}
+
+// Registra el pase en los contadores del frame.
+uint8_t Window::getPassId(const std::string& name) {
+    return m_frameStats.getPassId(name);
+}
+
+// Capa de los prximos comandos.
+void Window::setRenderLayer(uint16_t layer) {
+    m_layer = layer;
+}
+
+// Capa actual.
+uint16_t Window::getRenderLayer() const {
+    return m_layer;
+}
+
+// Cambia entre dibujo diferido e inmediato. Al desactivarlo se enva lo pendiente.
+void Window::setDeferred(bool deferred) {
+    if (!deferred) {
+        flush();
+    }
+    m_deferred = deferred;
+}
+
+// Une un bfer grabado en otro hilo al frame actual.
+void Window::submit(const RenderCommandBuffer& commands) {
+    m_commands.append(commands);
+}
+
+/*
+   Enva el frame: si hay una captura pendiente, los comandos se guardan antes de dibujarlos.
+*/
+void Window::flush() {
+    if (m_window == nullptr) {
+        LOG_FATAL("Window", "flush", "CHECK FOR WINDOW POINTER DATA");
+        return;
+    }
+    if (!m_capturePath.empty()) {
+        m_commands.save(m_capturePath, m_window->getSize());
+        m_capturePath.clear();
+    }
+    PROFILE_SCOPE("Window::flush");
+    m_commands.submit(*m_window, &m_frameStats);
+    m_commands.clear();
+}
+
+// Pide guardar el prximo frame.
+void Window::captureFrame(const std::string& path) {
+    m_capturePath = path;
+}
+
+// Contadores del ltimo frame.
+const RenderStats& Window::getRenderStats() const {
+    return m_lastStats;
+}
+
+// Llamadas de dibujo del ltimo frame.
+size_t Window::getLastDrawCalls() const {
+    return m_lastStats.getTotal().drawCalls;
+}
+
+// Vrtices del ltimo frame.
+size_t Window::getLastVertexCount() const {
+    return m_lastStats.getTotal().vertices;
+}
+
+// Presupuesto de llamadas de dibujo (0 = sin lmite).
+void Window::setDrawCallBudget(size_t budget) {
+    m_drawCallBudget = budget;
+}
+
+size_t Window::getDrawCallBudget() const {
+    return m_drawCallBudget;
+}
+
+bool Window::isOverBudget() const {
+    return m_drawCallBudget > 0 && m_lastStats.getTotal().drawCalls > m_drawCallBudget;
+}
+
+size_t Window::getOverBudgetFrameCount() const {
+    return m_overBudgetFrames;
+}
+
 /*
    Obtiene un puntero a la ventana interna de SFML.
    Esto permite realizar operaciones directas sobre la ventana de SFML.
@@ -128,11 +274,24 @@ sf::RenderWindow* Window::getWindow() {
         return m_window;
     }
     else {
-        ERROR("Window", "getWindow", "CHECK FOR WINDOW POINTER DATA");
+        LOG_FATAL("Window", "getWindow", "CHECK FOR WINDOW POINTER DATA");
         return nullptr;
     }
 }
 
+/*
+   Relacin entre el ancho del viewport en pxeles y el ancho de la vista en unidades del mundo.
+   Con la vista por defecto vale 1; al alejar la cmara (zoom > 1) baja.
+ */
+float Window::getPixelsPerUnit() const {
+    if (m_window == nullptr) {
+        return 1.0f;
+    }
+    const sf::View& view = m_window->getView();
+    const float viewportPixels = m_window->getSize().x * view.getViewport().width;
+    return view.getSize().x != 0.0f ? viewportPixels / std::abs(view.getSize().x) : 1.0f;
+}
+
 /*
   Actualiza la ventana cada frame.
    Calcula el `deltaTime` y actualiza ImGui con ese valor.
@@ -146,7 +305,10 @@ void Window::update() {
 }
 
 //Renderiza el contenido de ImGui en la ventana.
+//Los comandos grabados del frame se envan antes, para que ImGui quede encima.
 void Window::render() {
+    flush();
+    PROFILE_SCOPE("ImGui::Render");
     ImGui::SFML::Render(*m_window);
 }
 
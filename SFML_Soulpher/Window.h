@@ -1,5 +1,6 @@
 #pragma once 
 #include "Prerequisites.h"  
+#include "RenderCommandBuffer.h"
 
 /*
   Clase Window
@@ -27,6 +28,13 @@ public:
     ~Window();
 
     void handleEvents();
+
+    /*
+      Funcin getFrameEvents.
+      - Eventos recibidos en la ltima llamada a handleEvents, para que la aplicacin
+        los entregue a la simulacin (y los grabe) en lugar de consultar el estado en vivo.
+    */
+    const std::vector<sf::Event>& getFrameEvents() const;
  
     void clear();
    
@@ -42,9 +50,111 @@ public:
     /*
       Funcin draw.
       - Dibuja cualquier objeto derivado de sf::Drawable en la ventana.
+      - states permite indicar la textura, transformacin o mezcla (por ejemplo, para un sf::VertexBuffer).
+      - En modo diferido (por defecto) no dibuja al momento: graba un comando en el bfer del frame,
+        que se enva en render(). El drawable debe seguir vivo hasta entonces.
+      - cpuVertices es una copia en CPU de la geometra del drawable, solo necesaria para poder
+        guardar el frame (captureFrame) cuando el drawable vive en la GPU.
       - Explicado en cdigos anteriores.
     */
-    void draw(const sf::Drawable& drawable);
+    void draw(const sf::Drawable& drawable, const sf::RenderStates& states = sf::RenderStates::Default,
+        const sf::VertexArray* cpuVertices = nullptr);
+
+    /*
+      Sobrecarga de la funcin draw.
+      - Dibuja un arreglo de vrtices con sus RenderStates (transformacin, textura y modo de mezcla).
+      - La usan las formas que comparten geometra y solo aportan su transformacin al dibujarse.
+      - En modo diferido los vrtices se copian, por lo que el llamador puede reutilizar su arreglo.
+    */
+    void draw(const sf::Vertex* vertices, size_t vertexCount, sf::PrimitiveType type,
+        const sf::RenderStates& states = sf::RenderStates::Default);
+
+    /*
+      Funcin setRenderLayer.
+      - Capa (RenderLayer) de los comandos que se graben a continuacin. La capa es la parte
+        principal de la clave de orden del bfer de comandos.
+    */
+    void setRenderLayer(uint16_t layer);
+
+    // Capa actual de grabacin.
+    uint16_t getRenderLayer() const;
+
+    /*
+      Funcin setDeferred.
+      - true (por defecto): draw graba comandos que se envan juntos en flush()/render().
+      - false: draw dibuja al momento, como antes.
+    */
+    void setDeferred(bool deferred);
+
+    /*
+      Funcin submit.
+      - Agrega al frame un bfer grabado por otro hilo. Debe llamarse desde el hilo de la ventana.
+    */
+    void submit(const RenderCommandBuffer& commands);
+
+    /*
+      Funcin flush.
+      - Ordena y dibuja los comandos grabados y vaca el bfer. render() la llama antes de dibujar ImGui.
+    */
+    void flush();
+
+    /*
+      Funcin captureFrame.
+      - Guarda en path los comandos del prximo flush, para reproducirlos fuera del juego
+        (SFML_Soulpher --replay-frame path).
+    */
+    void captureFrame(const std::string& path);
+
+    /*
+      Funcin beginPass.
+      - Los dibujos siguientes se cuentan en el pase de render con ese nombre (por ejemplo "Track"
+        o "Actors") hasta la prxima llamada a beginPass o endPass. No cambia el orden de dibujo.
+    */
+    void beginPass(const std::string& name);
+
+    // Vuelve al pase por defecto ("Default").
+    void endPass();
+
+    /*
+      Funcin getPassId.
+      - Id de un pase, para asignarlo con RenderCommandBuffer::setPass a un bfer grabado en otro hilo.
+    */
+    uint8_t getPassId(const std::string& name);
+
+    /*
+      Funcin getRenderStats.
+      - Contadores del ltimo frame completo (hasta el ltimo display): llamadas de dibujo,
+        vrtices, cambios de textura y cambios de estado, en total y por pase.
+    */
+    const RenderStats& getRenderStats() const;
+
+    // Llamadas de dibujo del ltimo frame.
+    size_t getLastDrawCalls() const;
+
+    // Vrtices dibujados en el ltimo frame.
+    size_t getLastVertexCount() const;
+
+    /*
+      Funcin setDrawCallBudget.
+      - Mximo de llamadas de dibujo por frame (0 = sin lmite). Los frames que lo superan se
+        marcan (isOverBudget) y se cuentan; al pasar de dentro a fuera del presupuesto se avisa
+        por consola con el reparto por pase.
+    */
+    void setDrawCallBudget(size_t budget);
+    size_t getDrawCallBudget() const;
+
+    // Indica si el ltimo frame super el presupuesto de llamadas de dibujo.
+    bool isOverBudget() const;
+
+    // Frames que superaron el presupuesto desde el inicio.
+    size_t getOverBudgetFrameCount() const;
+
+    /*
+      Funcin getPixelsPerUnit.
+      - Devuelve cuntos pxeles de pantalla ocupa una unidad del mundo con la vista (sf::View) actual.
+      - Sirve para estimar el tamao proyectado de una forma, por ejemplo para elegir su nivel de detalle.
+    */
+    float getPixelsPerUnit() const;
 
     /*
       Funcin getWindow.
@@ -96,6 +206,19 @@ private:
     sf::RenderWindow* m_window;
     sf::View m_view;  // Vista de la ventana para manipular la cmara o perspectiva.
 
+    // Bfer de comandos del frame (modo diferido).
+    RenderCommandBuffer m_commands;
+    bool m_deferred = true;
+    uint16_t m_layer = LAYER_WORLD;
+    std::string m_capturePath;       // Si no est vaco, el prximo flush se guarda aqu.
+    uint8_t m_pass = 0;              // Pase de los prximos dibujos.
+    RenderStats m_frameStats;        // Contadores del frame en curso (se reinician en clear).
+    RenderStats m_lastStats;         // Contadores del ltimo frame completo.
+    size_t m_drawCallBudget = 0;
+    size_t m_overBudgetFrames = 0;
+    size_t m_frameIndex = 0;
+    std::vector<sf::Event> m_frameEvents;  // Eventos del ltimo handleEvents.
+
     // Tiempo entre frames y medir tiempo entre frames.
 public:
     sf::Time deltaTime;  
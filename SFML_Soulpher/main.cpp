@@ -1,4 +1,9 @@
 #include "BaseApp.h"  
+#include "CommandLine.h"
+#include "AssetArchive.h"
+#include "AssetCooker.h"
+#include "Benchmarks.h"
+#include <climits>
 
 /*
   - Funcin main.
@@ -12,9 +17,94 @@
     Proyecto SFML_SOULPHER
 */
 
-int main()
+int main(int argc, char* argv[])
 {
+    CommandLine commandLine(argc, argv);
+
+    // Herramientas de lnea de comandos: se ejecutan en lugar del juego.
+    //   --pack <directorio> --out <archivo.spak> [--lz4]   Empaqueta los recursos de un directorio.
+    //   --cook <directorio> --out <directorio> [--premultiply] [--trim] [--no-sprites] [--threads <n>] [--force]
+    //   --bench-archive <archivo.spak> [--dir <directorio>] [--runs <n>]
+    //   --bench-shapes [--count <n>] [--frames <n>]
+    //   --replay-frame <archivo.sframe> [--runs <n>]
+    //   --stress <n> --headless [--frames <n>] [--flowfield <archivo.sflow>]   Barrido de la escena de estrs sin ventana.
+    //   --bench-core [--json <salida.json>] [--baseline <anterior.json>] [--threshold <%>]
+    //   --bake-flowfield <Circuit.png> --out <archivo.sflow> [--cell <n>] [--tolerance <n>] [--off-road <n>] [--threads <n>]
+    if (commandLine.has("--pack")) {
+        const std::string directory = commandLine.getString("--pack", "bin/MarioKart sprite-png");
+        const std::string output = commandLine.getString("--out", "assets.spak");
+        return AssetArchive::build(directory, output, commandLine.has("--lz4")) ? 0 : 1;
+    }
+    if (commandLine.has("--cook")) {
+        AssetCooker::Options options;
+        options.premultiply = commandLine.has("--premultiply");
+        options.trim = commandLine.has("--trim");
+        options.findSprites = !commandLine.has("--no-sprites");
+        options.threadCount = static_cast<unsigned int>(std::max(0, commandLine.getInt("--threads", 0)));
+        options.force = commandLine.has("--force");
+        const std::string directory = commandLine.getString("--cook", "bin/MarioKart sprite-png");
+        const std::string output = commandLine.getString("--out", "cooked");
+        return AssetCooker::cook(directory, output, options) ? 0 : 1;
+    }
+    if (commandLine.has("--bake-flowfield")) {
+        FlowField::BakeOptions options;
+        options.grid.cellSize = commandLine.getFloat("--cell", options.grid.cellSize);
+        options.grid.colorTolerance = commandLine.getFloat("--tolerance", options.grid.colorTolerance);
+        options.offRoadCost = commandLine.getFloat("--off-road", options.offRoadCost);
+        options.threadCount = static_cast<unsigned int>(std::max(0, commandLine.getInt("--threads", 0)));
+        const std::string image = commandLine.getString("--bake-flowfield", "bin/MarioKart sprite-png/Circuit.png");
+        const std::string output = commandLine.getString("--out", "circuit.sflow");
+        return FlowField::bakeFile(image, output, BaseApp::getTrackBounds(), BaseApp::getTrackWaypoints(), options) ? 0 : 1;
+    }
+    if (commandLine.has("--bench-archive")) {
+        return Benchmarks::archiveLoad(commandLine);
+    }
+    if (commandLine.has("--bench-shapes")) {
+        return Benchmarks::shapes(commandLine);
+    }
+    if (commandLine.has("--replay-frame")) {
+        return Benchmarks::replayFrame(commandLine);
+    }
+    if (commandLine.has("--stress") && commandLine.has("--headless")) {
+        return Benchmarks::stress(commandLine);
+    }
+    if (commandLine.has("--bench-core")) {
+        return Benchmarks::core(commandLine);
+    }
+
     BaseApp app;       // Crear una instancia de BaseApp.
+    app.setTickRate(commandLine.getFloat("--tick-rate", 60.0f));   // --tick-rate <n>: ticks de simulacin por segundo.
+    app.setThreaded(commandLine.has("--threaded"));                // --threaded: simulacin en su propio hilo.
+    // --headless [--ticks <n>]: solo simulacin, sin ventana, OpenGL ni ImGui; reporta ticks por segundo.
+    // Al reproducir sin --ticks se simula la grabacin completa.
+    if (commandLine.has("--headless")) {
+        const int ticks = commandLine.getInt("--ticks", commandLine.has("--replay") ? INT_MAX : 10000);
+        if (ticks <= 0) {
+            std::cerr << "--ticks debe ser mayor que 0\n";
+            return 1;
+        }
+        app.setHeadless(ticks);
+    }
+    // --record <archivo.sinput> | --replay <archivo.sinput> [--fast-forward]: entrada por tick grabada.
+    app.setInputRecording(commandLine.getString("--record"));
+    app.setInputReplay(commandLine.getString("--replay"), commandLine.has("--fast-forward"));
+    // --trace <archivo.json>: traza del profiler (Chrome/Perfetto) desde el inicio; F9 la detiene o reanuda.
+    // Disponible tambin en Release: el profiler est compilado siempre y solo mide mientras graba.
+    app.setTrace(commandLine.getString("--trace"));
+    // --stress <n>: agrega n karts que siguen la ruta, con un panel de mediciones.
+    app.setStress(static_cast<size_t>(std::max(0, commandLine.getInt("--stress", 0))));
+    // --flowfield <archivo.sflow>: los karts de --stress se conducen con un flow field horneado.
+    app.setFlowField(commandLine.getString("--flowfield"));
+    // --hud: superposicin de rendimiento visible desde el inicio (F3 la alterna).
+    app.setHudVisible(commandLine.has("--hud"));
+    // --log-file <archivo>: copia el log de la consola a un archivo.
+    if (commandLine.has("--log-file")) {
+        Logger::getInstance().setFile(commandLine.getString("--log-file", "soulpher.log"));
+    }
+    // --draw-budget <n>: marca y reporta los frames con ms de n llamadas de dibujo.
+    app.setDrawCallBudget(static_cast<size_t>(std::max(0, commandLine.getInt("--draw-budget", 0))));
+    // --capture-frame <archivo.sframe> [--capture-at <n>]: guarda los comandos de dibujo del frame n.
+    app.setFrameCapture(commandLine.getString("--capture-frame"), commandLine.getInt("--capture-at", 120));
 
     return app.run();  // Iniciar el ciclo de ejecucin principal y devolver el estado de finalizacin.
 }